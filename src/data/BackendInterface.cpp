@@ -28,10 +28,12 @@
 #include <ripple/basics/strHex.h>
 #include <ripple/protocol/Fees.h>
 #include <ripple/protocol/Indexes.h>
+#include <ripple/protocol/LedgerHeader.h>
 #include <ripple/protocol/SField.h>
 #include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/protocol/Serializer.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -60,6 +62,24 @@ BackendInterface::finishWrites(std::uint32_t const ledgerSequence)
     }
     return commitRes;
 }
+
+bool
+BackendInterface::extendRangeDown(std::uint32_t const newMin)
+{
+    auto const rng = fetchLedgerRange();
+    if (!rng) {
+        LOG(gLog.error()) << "Can't extend the ledger range down to " << newMin << " without a ledger range";
+        return false;
+    }
+
+    ASSERT(newMin <= rng->minSequence, "New min {} must not be above the current min {}", newMin, rng->minSequence);
+    if (!doExtendRangeDown(rng->minSequence, newMin))
+        return false;
+
+    updateRangeMin(newMin);
+    return true;
+}
+
 void
 BackendInterface::writeLedgerObject(std::string&& key, std::uint32_t const seq, std::string&& blob)
 {
@@ -271,6 +291,15 @@ BackendInterface::updateRange(uint32_t newMax)
     }
 }
 
+void
+BackendInterface::updateRangeMin(uint32_t newMin)
+{
+    std::scoped_lock const lck(rngMtx_);
+
+    if (range)
+        range->minSequence = std::min(range->minSequence, newMin);
+}
+
 void
 BackendInterface::setRange(uint32_t min, uint32_t max, bool force)
 {
@@ -328,6 +357,18 @@ BackendInterface::fetchLedgerPage(
     return page;
 }
 
+std::vector<std::optional<ripple::LedgerHeader>>
+BackendInterface::fetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield)
+    const
+{
+    std::vector<std::optional<ripple::LedgerHeader>> headers;
+    headers.reserve(sequences.size());
+    for (auto const sequence : sequences)
+        headers.push_back(fetchLedgerBySequence(sequence, yield));
+
+    return headers;
+}
+
 std::optional<ripple::Fees>
 BackendInterface::fetchFees(std::uint32_t const seq, boost::asio::yield_context yield) const
 {
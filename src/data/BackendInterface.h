@@ -21,6 +21,8 @@
 
 #include "data/DBHelpers.h"
 #include "data/LedgerCache.h"
+#include "data/LedgerHeaderCache.h"
+#include "data/TrustLineAggregatesCache.h"
 #include "data/Types.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
@@ -122,6 +124,8 @@ protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range;
     LedgerCache cache_;
+    mutable LedgerHeaderCache headerCache_;  // filled from const fetches
+    mutable TrustLineAggregatesCache trustLineAggregates_;
 
 public:
     BackendInterface() = default;
@@ -146,6 +150,25 @@ public:
         return cache_;
     }
 
+    /**
+     * @return Cache of recent ledger headers, filled by the backend as headers are read and by ETL as ledgers are
+     * published
+     */
+    LedgerHeaderCache&
+    ledgerHeaderCache() const
+    {
+        return headerCache_;
+    }
+
+    /**
+     * @return Memoized trust line summaries, filled by RPC handlers and kept valid by ETL from the ledger diffs
+     */
+    TrustLineAggregatesCache&
+    trustLineAggregates() const
+    {
+        return trustLineAggregates_;
+    }
+
     /**
      * @brief Fetches a specific ledger by sequence number.
      *
@@ -166,6 +189,19 @@ public:
     virtual std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches the headers of several ledgers at once.
+     *
+     * The default implementation fetches them one by one; backends should override it to read all of them in one
+     * batch.
+     *
+     * @param sequences The sequences of the ledgers to fetch
+     * @param yield The coroutine context
+     * @return The headers in the order of @p sequences, nullopt for the ones not found
+     */
+    virtual std::vector<std::optional<ripple::LedgerHeader>>
+    fetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const;
+
     /**
      * @brief Fetches the latest ledger sequence.
      *
@@ -191,6 +227,14 @@ public:
     void
     updateRange(uint32_t newMax);
 
+    /**
+     * @brief Lowers the minimum of the range of sequences that are stored in the DB; does nothing if not lower.
+     *
+     * @param newMin The new minimum sequence available
+     */
+    void
+    updateRangeMin(uint32_t newMin);
+
     /**
      * @brief Sets the range of sequences that are stored in the DB.
      *
@@ -250,6 +294,35 @@ public:
         boost::asio::yield_context yield
     ) const = 0;
 
+    /**
+     * @brief Fetches transactions for a specific account, limited to a range of ledgers.
+     *
+     * Backends that can apply the range in the database override this; by default the page is fetched with @ref
+     * fetchAccountTransactions and the caller is left to skip transactions outside of the range.
+     *
+     * @param account The account to fetch transactions for
+     * @param limit The maximum number of transactions per result page
+     * @param forward Whether to fetch the page forwards or backwards from the given cursor
+     * @param cursor The cursor to resume fetching from
+     * @param minSequence The lowest ledger sequence to return transactions of
+     * @param maxSequence The highest ledger sequence to return transactions of
+     * @param yield The coroutine context
+     * @return Results and a cursor to resume from
+     */
+    virtual TransactionsAndCursor
+    fetchAccountTransactionsInRange(
+        ripple::AccountID const& account,
+        std::uint32_t limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursor,
+        [[maybe_unused]] std::uint32_t minSequence,
+        [[maybe_unused]] std::uint32_t maxSequence,
+        boost::asio::yield_context yield
+    ) const
+    {
+        return fetchAccountTransactions(account, limit, forward, cursor, yield);
+    }
+
     /**
      * @brief Fetches all transactions from a specific ledger.
      *
@@ -541,6 +614,46 @@ public:
     virtual void
     writeAccountTransactions(std::vector<AccountTransactionsData> data) = 0;
 
+    /**
+     * @brief Whether the backend stores transaction blobs along with the account transactions index.
+     *
+     * If so, the ETL fills in the blobs of the AccountTransactionsData it passes to @ref writeAccountTransactions.
+     *
+     * @return true if the blobs are needed; false otherwise
+     */
+    virtual bool
+    storesAccountTransactionsInline() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Write all transactions of a ledger as one bundle, so that the ledger can be read back in one request.
+     *
+     * Called by the ETL in addition to @ref writeTransaction if @ref storesLedgerTransactionsBundle returns true.
+     *
+     * @param seq The ledger sequence to write for
+     * @param transactions All transactions of the ledger in transaction index order
+     */
+    virtual void
+    writeLedgerTransactionsBundle(
+        std::uint32_t /* seq */,
+        std::vector<TransactionAndMetadata> const& /* transactions */
+    )
+    {
+    }
+
+    /**
+     * @brief Whether the backend stores the transactions of each ledger as a bundle.
+     *
+     * @return true if the ETL should call @ref writeLedgerTransactionsBundle; false otherwise
+     */
+    virtual bool
+    storesLedgerTransactionsBundle() const
+    {
+        return false;
+    }
+
     /**
      * @brief Write NFTs transactions.
      *
@@ -578,6 +691,23 @@ public:
     bool
     finishWrites(std::uint32_t ledgerSequence);
 
+    /**
+     * @brief Waits for all writes submitted so far without committing a new ledger.
+     */
+    virtual void
+    waitForWrites() = 0;
+
+    /**
+     * @brief Extends the range of stored ledgers down to an older ledger.
+     *
+     * Must only be called once all ledgers from newMin up to the current minimum are written.
+     *
+     * @param newMin The new oldest ledger sequence
+     * @return true if the range was extended; false otherwise
+     */
+    bool
+    extendRangeDown(std::uint32_t newMin);
+
     /**
      * @return true if database is overwhelmed; false otherwise
      */
@@ -596,6 +726,9 @@ private:
 
     virtual bool
     doFinishWrites() = 0;
+
+    virtual bool
+    doExtendRangeDown(std::uint32_t oldMin, std::uint32_t newMin) = 0;
 };
 
 }  // namespace data
@@ -20,20 +20,33 @@
 #pragma once
 
 #include "data/BackendInterface.h"
+#include "data/TransactionsBundle.h"
 #include "data/cassandra/Concepts.h"
 #include "data/cassandra/Handle.h"
 #include "data/cassandra/Schema.h"
 #include "data/cassandra/SettingsProvider.h"
+#include "data/cassandra/impl/AccountTxInline.h"
+#include "data/cassandra/impl/BatchBuilder.h"
 #include "data/cassandra/impl/ExecutionStrategy.h"
 #include "util/Assert.h"
 #include "util/LedgerUtils.h"
 #include "util/Profiler.h"
 #include "util/log/Logger.h"
+#include "util/prometheus/Label.h"
+#include "util/prometheus/Prometheus.h"
 
 #include <boost/asio/spawn.hpp>
 #include <ripple/protocol/LedgerHeader.h>
 #include <ripple/protocol/nft.h>
 
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace data::cassandra {
 
 /**
@@ -57,6 +70,61 @@ class BasicCassandraBackend : public BackendInterface {
 
     std::atomic_uint32_t ledgerSequence_ = 0u;
 
+    bool const inlineAccountTransactions_;
+    std::uint32_t inlineAccountTransactionsStart_ = 0u;  // first ledger of account_tx_inline, once this writer knows it
+
+    /**
+     * @brief The ledgers account_tx_inline is complete for, as read when the latest ledger was the given one.
+     */
+    struct InlineAccountTransactionsRange {
+        std::optional<LedgerRange> ledgers;
+        std::uint32_t readAt = 0u;
+    };
+
+    mutable std::mutex inlineAccountTransactionsRangeMutex_;
+    mutable InlineAccountTransactionsRange inlineAccountTransactionsRange_;
+
+    bool const bundleLedgerTransactions_;
+
+    // ledger diffs are written in batches once there are enough of them for this many
+    static constexpr std::size_t MAX_PENDING_BATCHES = 64;
+
+    std::mutex pendingWritesMutex_;
+    detail::BatchBuilder<Statement> pendingWrites_;
+
+    /**
+     * @brief Counters to compare reading whole ledgers from the bundle with reading them one transaction at a time.
+     */
+    struct LedgerTransactionsReadCounters {
+        std::reference_wrapper<util::prometheus::CounterInt> reads;
+        std::reference_wrapper<util::prometheus::CounterInt> durationUs;
+
+        explicit LedgerTransactionsReadCounters(std::string const& source)
+            : reads{PrometheusService::counterInt(
+                  "backend_ledger_transactions_reads_total_number",
+                  util::prometheus::Labels({{"source", source}}),
+                  "The total number of times all transactions of a ledger were read"
+              )}
+            , durationUs{PrometheusService::counterInt(
+                  "backend_ledger_transactions_read_duration_us",
+                  util::prometheus::Labels({{"source", source}}),
+                  "The total time spent reading all transactions of a ledger in microseconds"
+              )}
+        {
+        }
+
+        void
+        registerRead(std::chrono::steady_clock::time_point const startTime)
+        {
+            auto const duration = std::chrono::steady_clock::now() - startTime;
+            ++reads.get();
+            durationUs.get() += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        }
+    };
+
+    mutable LedgerTransactionsReadCounters bundleReads_{"bundle"};
+    mutable LedgerTransactionsReadCounters perTransactionReads_{"per_tx"};
+
 public:
     /**
      * @brief Create a new cassandra/scylla backend instance.
@@ -69,6 +137,12 @@ public:
         , schema_{settingsProvider_}
         , handle_{settingsProvider_.getSettings()}
         , executor_{settingsProvider_.getSettings(), handle_}
+        , inlineAccountTransactions_{settingsProvider_.getSettings().inlineAccountTransactions}
+        , bundleLedgerTransactions_{settingsProvider_.getSettings().bundleLedgerTransactions}
+        , pendingWrites_{
+              settingsProvider_.getSettings().writeBatchSize,
+              settingsProvider_.getSettings().writeBatchSizeBytes
+          }
     {
         if (auto const res = handle_.connect(); not res)
             throw std::runtime_error("Could not connect to Cassandra: " + res.error());
@@ -168,12 +242,61 @@ public:
         return {txns, {}};
     }
 
+    TransactionsAndCursor
+    fetchAccountTransactionsInRange(
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        std::optional<TransactionsCursor> const& cursor,
+        std::uint32_t const minSequence,
+        std::uint32_t const maxSequence,
+        boost::asio::yield_context yield
+    ) const override
+    {
+        // account_tx_inline is only complete for the ledgers in its range, all other ledgers are read from account_tx.
+        // Pages that cross the edges of that range continue from account_tx.
+        auto const inlineRange = fetchInlineAccountTransactionsRange(yield);
+        if (not inlineRange or not cursor or cursor->ledgerSequence > inlineRange->maxSequence)
+            return fetchAccountTransactions(account, limit, forward, cursor, yield);
+
+        if (forward) {
+            if (cursor->ledgerSequence < inlineRange->minSequence)
+                return fetchAccountTransactions(account, limit, forward, cursor, yield);
+
+            auto const inlineEndCursor = TransactionsCursor{
+                std::min(maxSequence, inlineRange->maxSequence), std::numeric_limits<std::uint32_t>::max()
+            };
+            auto result = fetchInlineAccountTransactions(account, limit, forward, *cursor, inlineEndCursor, yield);
+            if (result.cursor or maxSequence <= inlineRange->maxSequence)
+                return result;
+
+            return appendAccountTransactions(std::move(result), account, limit, forward, inlineEndCursor, yield);
+        }
+
+        auto const inlineStartCursor = TransactionsCursor{inlineRange->minSequence, 0u};
+        if (cursor->asTuple() <= inlineStartCursor.asTuple())
+            return fetchAccountTransactions(account, limit, forward, cursor, yield);
+
+        auto const lowerBound = TransactionsCursor{std::max(minSequence, inlineRange->minSequence), 0u};
+        auto result = fetchInlineAccountTransactions(account, limit, forward, *cursor, lowerBound, yield);
+        if (result.cursor or minSequence >= inlineRange->minSequence)
+            return result;
+
+        return appendAccountTransactions(std::move(result), account, limit, forward, inlineStartCursor, yield);
+    }
+
     bool
     doFinishWrites() override
     {
+        flushPendingWrites();
+
         // wait for other threads to finish their writes
         executor_.sync();
 
+        // only the writer at the tip extends account_tx_inline; older ledgers would leave gaps in its range
+        if (inlineAccountTransactions_ and (not range or ledgerSequence_ > range->maxSequence))
+            updateInlineAccountTransactionsRange();
+
         if (!range) {
             executor_.writeSync(schema_->updateLedgerRange, ledgerSequence_, false, ledgerSequence_);
         }
@@ -187,6 +310,26 @@ public:
         return true;
     }
 
+    void
+    waitForWrites() override
+    {
+        flushPendingWrites();
+        executor_.sync();
+    }
+
+    bool
+    doExtendRangeDown(std::uint32_t const oldMin, std::uint32_t const newMin) override
+    {
+        auto const res = executor_.writeSync(schema_->updateLedgerRange, newMin, false, oldMin);
+        if (auto const applied = res->template get<bool>(); not applied or not *applied) {
+            LOG(log_.warn()) << "Could not extend ledger range from " << oldMin << " down to " << newMin;
+            return false;
+        }
+
+        LOG(log_.info()) << "Extended ledger range from " << oldMin << " down to " << newMin;
+        return true;
+    }
+
     void
     writeLedger(ripple::LedgerHeader const& ledgerInfo, std::string&& blob) override
     {
@@ -220,11 +363,16 @@ public:
     std::optional<ripple::LedgerHeader>
     fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::yield_context yield) const override
     {
+        if (auto cached = headerCache_.getBySequence(sequence); cached)
+            return cached;
+
         auto const res = executor_.read(yield, schema_->selectLedgerBySeq, sequence);
         if (res) {
             if (auto const& result = res.value(); result) {
                 if (auto const maybeValue = result.template get<std::vector<unsigned char>>(); maybeValue) {
-                    return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                    auto const header = util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                    headerCache_.put(header);
+                    return header;
                 }
 
                 LOG(log_.error()) << "Could not fetch ledger by sequence - no rows";
@@ -242,6 +390,9 @@ public:
     std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
+        if (auto cached = headerCache_.getByHash(hash); cached)
+            return cached;
+
         if (auto const res = executor_.read(yield, schema_->selectLedgerByHash, hash); res) {
             if (auto const& result = res.value(); result) {
                 if (auto const maybeValue = result.template get<uint32_t>(); maybeValue)
@@ -259,6 +410,38 @@ public:
         return std::nullopt;
     }
 
+    std::vector<std::optional<ripple::LedgerHeader>>
+    fetchLedgerHeaders(std::vector<std::uint32_t> const& sequences, boost::asio::yield_context yield) const override
+    {
+        std::vector<std::optional<ripple::LedgerHeader>> headers(sequences.size());
+        std::vector<std::size_t> missing;
+        std::vector<Statement> statements;
+
+        for (auto i = 0u; i < sequences.size(); ++i) {
+            headers[i] = headerCache_.getBySequence(sequences[i]);
+            if (not headers[i]) {
+                missing.push_back(i);
+                statements.push_back(schema_->selectLedgerBySeq.bind(sequences[i]));
+            }
+        }
+
+        if (statements.empty())
+            return headers;
+
+        auto const entries = executor_.readEach(yield, statements);
+        for (auto i = 0u; i < missing.size(); ++i) {
+            if (auto const maybeValue = entries[i].template get<std::vector<unsigned char>>(); maybeValue) {
+                auto const header = util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                headerCache_.put(header);
+                headers[missing[i]] = header;
+            }
+        }
+
+        LOG(log_.debug()) << "Fetched " << statements.size() << " of " << sequences.size()
+                          << " ledger headers from Cassandra";
+        return headers;
+    }
+
     std::optional<LedgerRange>
     hardFetchLedgerRange(boost::asio::yield_context yield) const override
     {
@@ -300,8 +483,18 @@ public:
     std::vector<TransactionAndMetadata>
     fetchAllTransactionsInLedger(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const override
     {
+        auto const startTime = std::chrono::steady_clock::now();
+        if (bundleLedgerTransactions_) {
+            if (auto transactions = fetchLedgerTransactionsBundle(ledgerSequence, yield); transactions) {
+                bundleReads_.registerRead(startTime);
+                return std::move(*transactions);
+            }
+        }
+
         auto hashes = fetchAllTransactionHashesInLedger(ledgerSequence, yield);
-        return fetchTransactions(hashes, yield);
+        auto transactions = fetchTransactions(hashes, yield);
+        perTransactionReads_.registerRead(startTime);
+        return transactions;
     }
 
     std::vector<ripple::uint256>
@@ -723,8 +916,9 @@ public:
     {
         LOG(log_.trace()) << " Writing ledger object " << key.size() << ":" << seq << " [" << blob.size() << " bytes]";
 
+        // all diffs of a ledger share a partition; each object is a partition of its own and is written by itself
         if (range)
-            executor_.write(schema_->insertDiff, seq, key);
+            writeBatched("diff" + std::to_string(seq), key.size(), schema_->insertDiff.bind(seq, key));
 
         executor_.write(schema_->insertObject, std::move(key), seq, std::move(blob));
     }
@@ -761,9 +955,46 @@ public:
             );
         }
 
+        if (inlineAccountTransactions_)
+            writeInlineAccountTransactions(data, statements);
+
+        executor_.write(std::move(statements));
+    }
+
+    bool
+    storesAccountTransactionsInline() const override
+    {
+        return inlineAccountTransactions_;
+    }
+
+    void
+    writeLedgerTransactionsBundle(std::uint32_t const seq, std::vector<TransactionAndMetadata> const& transactions)
+        override
+    {
+        if (not bundleLedgerTransactions_)
+            return;
+
+        // a ledger without transactions still gets its (empty) row so that it is not read one by one
+        auto const date = transactions.empty() ? 0u : transactions.front().date;
+        auto chunks = makeTransactionsBundle(transactions);
+
+        std::vector<Statement> statements;
+        statements.reserve(chunks.size());
+        for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+            statements.push_back(schema_->insertLedgerTransactionsBundle.bind(
+                seq, static_cast<std::uint32_t>(chunk), transactions.size(), date, std::move(chunks[chunk])
+            ));
+        }
+
         executor_.write(std::move(statements));
     }
 
+    bool
+    storesLedgerTransactionsBundle() const override
+    {
+        return bundleLedgerTransactions_;
+    }
+
     void
     writeNFTTransactions(std::vector<NFTTransactionsData> const& data) override
     {
@@ -847,6 +1078,196 @@ public:
     }
 
 private:
+    std::optional<LedgerRange>
+    fetchInlineAccountTransactionsRange(boost::asio::yield_context yield) const
+    {
+        if (not inlineAccountTransactions_)
+            return std::nullopt;
+
+        // the range only changes when a ledger is written, so it is read again once the latest ledger changes
+        auto const ledgerRange = fetchLedgerRange();
+        auto const readAt = ledgerRange ? ledgerRange->maxSequence : 0u;
+        {
+            std::scoped_lock const lock{inlineAccountTransactionsRangeMutex_};
+            if (readAt != 0u and inlineAccountTransactionsRange_.readAt == readAt)
+                return inlineAccountTransactionsRange_.ledgers;
+        }
+
+        auto const res = executor_.read(yield, *schema_->selectAccountTxInlineRange);
+        if (not res) {
+            // account_tx alone is complete, so it is read instead
+            LOG(log_.error()) << "Could not fetch range of inline account transactions: " << res.error();
+            return std::nullopt;
+        }
+
+        auto const ledgers = detail::toInlineAccountTransactionsRange(extract<bool, uint32_t>(res.value()));
+        std::scoped_lock const lock{inlineAccountTransactionsRangeMutex_};
+        inlineAccountTransactionsRange_ = {.ledgers = ledgers, .readAt = readAt};
+        return ledgers;
+    }
+
+    TransactionsAndCursor
+    fetchInlineAccountTransactions(
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        TransactionsCursor const& cursor,
+        TransactionsCursor const& bound,
+        boost::asio::yield_context yield
+    ) const
+    {
+        auto const& statement = forward ? *schema_->selectAccountTxInlineForward : *schema_->selectAccountTxInline;
+        auto const res = executor_.read(yield, statement, account, cursor.asTuple(), bound.asTuple(), Limit{limit});
+        if (not res) {
+            LOG(log_.error()) << "Could not fetch inline account transactions: " << res.error();
+            throw std::runtime_error("Could not fetch inline account transactions: " + res.error().message());
+        }
+
+        // the row types follow the columns of detail::ACCOUNT_TX_INLINE_COLUMNS
+        return detail::toInlineAccountTransactions(
+            extract<std::tuple<uint32_t, uint32_t>, Blob, Blob, uint32_t>(res.value()), limit, forward
+        );
+    }
+
+    TransactionsAndCursor
+    appendAccountTransactions(
+        TransactionsAndCursor result,
+        ripple::AccountID const& account,
+        std::uint32_t const limit,
+        bool forward,
+        TransactionsCursor const& cursor,
+        boost::asio::yield_context yield
+    ) const
+    {
+        auto const remaining = static_cast<std::uint32_t>(limit - result.txns.size());
+        auto rest = fetchAccountTransactions(account, remaining, forward, cursor, yield);
+        std::move(rest.txns.begin(), rest.txns.end(), std::back_inserter(result.txns));
+        result.cursor = rest.cursor;
+        return result;
+    }
+
+    std::optional<std::vector<TransactionAndMetadata>>
+    fetchLedgerTransactionsBundle(std::uint32_t const ledgerSequence, boost::asio::yield_context yield) const
+    {
+        auto const res = executor_.read(yield, schema_->selectLedgerTransactionsBundle, ledgerSequence);
+        if (not res) {
+            LOG(log_.error()) << "Could not fetch ledger transactions bundle: " << res.error();
+            return std::nullopt;
+        }
+
+        // no rows means the ledger was written before bundles were enabled
+        auto const& results = res.value();
+        if (not results.hasRows())
+            return std::nullopt;
+
+        std::vector<Blob> chunks;
+        std::uint32_t count = 0;
+        std::uint32_t date = 0;
+        for (auto [txCount, chunkDate, chunk] : extract<std::uint32_t, std::uint32_t, Blob>(results)) {
+            count = txCount;
+            date = chunkDate;
+            chunks.push_back(std::move(chunk));
+        }
+
+        auto transactions = readTransactionsBundle(chunks, ledgerSequence, date);
+        if (not transactions or transactions->size() != count) {
+            LOG(log_.warn()) << "Incomplete ledger transactions bundle; ledger = " << ledgerSequence;
+            return std::nullopt;
+        }
+
+        return transactions;
+    }
+
+    void
+    writeInlineAccountTransactions(std::vector<AccountTransactionsData> const& data, std::vector<Statement>& statements)
+    {
+        if (data.empty())
+            return;
+
+        for (auto const& record : data) {
+            ASSERT(not record.transaction.empty(), "Inline account transactions require the transaction blob");
+            for (auto const& account : record.accounts) {
+                statements.push_back(schema_->insertAccountTxInline->bind(
+                    account,
+                    std::make_tuple(record.ledgerSequence, record.transactionIndex),
+                    record.transaction,
+                    record.metadata,
+                    record.date
+                ));
+            }
+        }
+    }
+
+    void
+    updateInlineAccountTransactionsRange()
+    {
+        // account_tx_inline is complete from its start up to the latest ledger written to it. When this writer does not
+        // carry on from that ledger, e.g. because inline writes were off for a while, it starts over from this ledger
+        if (inlineAccountTransactionsStart_ == 0u) {
+            std::optional<LedgerRange> ledgers;
+            if (auto const res = handle_.execute(*schema_->selectAccountTxInlineRange); res) {
+                ledgers = detail::toInlineAccountTransactionsRange(extract<bool, uint32_t>(res.value()));
+            } else {
+                LOG(log_.error()) << "Could not fetch range of inline account transactions: " << res.error();
+            }
+
+            if (ledgers and ledgerSequence_ >= ledgers->minSequence and ledgerSequence_ <= ledgers->maxSequence + 1) {
+                inlineAccountTransactionsStart_ = ledgers->minSequence;
+            } else {
+                // readers fall back to account_tx until the new start is in place
+                LOG(log_.info()) << "Inline account transactions start over at ledger " << ledgerSequence_;
+                executor_.writeSync(*schema_->insertAccountTxInlineRange, true, 0u);
+                executor_.writeSync(*schema_->insertAccountTxInlineRange, false, ledgerSequence_);
+                inlineAccountTransactionsStart_ = ledgerSequence_;
+            }
+        }
+
+        executor_.writeSync(*schema_->insertAccountTxInlineRange, true, ledgerSequence_);
+
+        std::scoped_lock const lock{inlineAccountTransactionsRangeMutex_};
+        inlineAccountTransactionsRange_ = {
+            .ledgers = LedgerRange{.minSequence = inlineAccountTransactionsStart_, .maxSequence = ledgerSequence_},
+            .readAt = ledgerSequence_
+        };
+    }
+
+    void
+    writeBatched(std::string partition, std::size_t size, Statement&& statement)
+    {
+        std::vector<std::vector<Statement>> batches;
+        {
+            std::scoped_lock const lock{pendingWritesMutex_};
+            pendingWrites_.add(std::move(partition), size, std::move(statement));
+            if (not pendingWrites_.fills(MAX_PENDING_BATCHES))
+                return;
+
+            batches = pendingWrites_.take();
+        }
+
+        writeBatches(batches);
+    }
+
+    void
+    flushPendingWrites()
+    {
+        std::vector<std::vector<Statement>> batches;
+        {
+            std::scoped_lock const lock{pendingWritesMutex_};
+            batches = pendingWrites_.take();
+        }
+
+        LOG(log_.debug()) << "Writing " << batches.size() << " batches of ledger diffs";
+        writeBatches(batches);
+    }
+
+    void
+    writeBatches(std::vector<std::vector<Statement>> const& batches)
+    {
+        // each batch writes a single partition, so the batch log would only add an extra round of writes
+        for (auto const& batch : batches)
+            executor_.write(Batch{batch, CASS_BATCH_TYPE_UNLOGGED});
+    }
+
     bool
     executeSyncUpdate(Statement statement)
     {
@@ -30,6 +30,9 @@
 #include <ripple/protocol/STAccount.h>
 #include <ripple/protocol/TxMeta.h>
 
+#include <cstdint>
+#include <string>
+
 /**
  * @brief Struct used to keep track of what to write to account_transactions/account_tx tables.
  */
@@ -39,6 +42,12 @@ struct AccountTransactionsData {
     std::uint32_t transactionIndex{};
     ripple::uint256 txHash;
 
+    // only filled in when the backend stores the blobs with the account index, see
+    // BackendInterface::storesAccountTransactionsInline
+    std::string transaction;
+    std::string metadata;
+    std::uint32_t date{};
+
     AccountTransactionsData(ripple::TxMeta& meta, ripple::uint256 const& txHash)
         : accounts(meta.getAffectedAccounts())
         , ledgerSequence(meta.getLgrSeq())
@@ -24,8 +24,11 @@
 
 #include <ripple/basics/base_uint.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
@@ -106,6 +109,93 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     return {{e->first, e->second.blob}};
 }
 
+std::optional<std::vector<LedgerCache::Neighbors>>
+LedgerCache::getNeighbors(std::vector<ripple::uint256> const& keys, uint32_t seq) const
+{
+    ASSERT(std::is_sorted(keys.begin(), keys.end()), "Keys must be sorted");
+
+    if (!full_)
+        return {};
+    std::shared_lock const lck{mtx_};
+    successorReqCounter_.get() += keys.size();
+    if (seq != latestSeq_)
+        return {};
+
+    std::vector<Neighbors> result;
+    result.reserve(keys.size());
+
+    auto it = map_.begin();
+    for (auto const& key : keys) {
+        // keys are sorted, so the first object not before this key is never before the one of the previous key. it is
+        // usually close by when keys are dense; otherwise searching the tree is cheaper than walking to it
+        std::size_t scanned = 0;
+        while (it != map_.end() && it->first < key && scanned < MAX_NEIGHBOR_SCAN) {
+            ++it;
+            ++scanned;
+        }
+        if (it != map_.end() && it->first < key)
+            it = map_.lower_bound(key);
+
+        auto& neighbors = result.emplace_back();
+        if (it != map_.begin())
+            neighbors.predecessor = std::prev(it)->first;
+
+        auto const successor = (it != map_.end() && it->first == key) ? std::next(it) : it;
+        if (successor != map_.end()) {
+            neighbors.successor = successor->first;
+            ++successorHitCounter_.get();
+        }
+    }
+
+    return result;
+}
+
+std::optional<LedgerPage>
+LedgerCache::getPage(
+    std::optional<ripple::uint256> const& cursor,
+    std::optional<ripple::uint256> const& end,
+    uint32_t seq,
+    uint32_t limit,
+    std::function<bool(Blob const&)> const& filter
+) const
+{
+    if (!full_)
+        return {};
+
+    LedgerPage page;
+    auto from = cursor;
+    std::size_t scanned = 0;
+
+    while (true) {
+        std::shared_lock const lck{mtx_};
+        if (seq != latestSeq_)
+            return {};
+
+        auto it = from ? map_.upper_bound(*from) : map_.begin();
+        auto const last = end ? map_.lower_bound(*end) : map_.end();
+
+        // an end at or before the cursor leaves nothing (more) to page through
+        if (it == map_.end() or (last != map_.end() and last->first <= it->first))
+            return page;
+
+        auto const sliceEnd = std::min(scanned + PAGE_SCAN_SLICE, MAX_PAGE_SCAN);
+        for (; it != last and page.objects.size() < limit and scanned < sliceEnd; ++it, ++scanned) {
+            if (filter(it->second.blob))
+                page.objects.push_back({it->first, it->second.blob});
+        }
+
+        if (it == last)
+            return page;
+
+        if (page.objects.size() >= limit or scanned >= MAX_PAGE_SCAN) {
+            page.cursor = std::prev(it)->first;
+            return page;
+        }
+
+        from = std::prev(it)->first;
+    }
+}
+
 std::optional<Blob>
 LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
 {
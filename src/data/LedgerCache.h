@@ -25,8 +25,11 @@
 #include <ripple/basics/base_uint.h>
 #include <ripple/basics/hardened_hash.h>
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <utility>
 #include <vector>
@@ -74,7 +77,21 @@ class LedgerCache {
     // temporary set to prevent background thread from writing already deleted data. not used when cache is full
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
+    // when looking up many keys, the next key is searched for from the previous one for at most this many objects
+    static constexpr std::size_t MAX_NEIGHBOR_SCAN = 16;
+
 public:
+    static constexpr std::size_t MAX_PAGE_SCAN = 1'000'000;
+    static constexpr std::size_t PAGE_SCAN_SLICE = 4096;
+
+    /**
+     * @brief The closest keys before and after a key.
+     */
+    struct Neighbors {
+        std::optional<ripple::uint256> predecessor;
+        std::optional<ripple::uint256> successor;
+    };
+
     /**
      * @brief Update the cache with new ledger objects.
      *
@@ -119,6 +136,47 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Gets the cached predecessors and successors of many keys at once.
+     *
+     * All keys are looked up under one lock in a single pass over the cache in key order. The keys themselves do not
+     * have to be in the cache.
+     *
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or seq is not the latest
+     * sequence.
+     *
+     * @param keys The keys to fetch for, sorted in ascending order
+     * @param seq The sequence to fetch for
+     * @return If the cache can serve them, the neighbors of each key in the same order as the keys; otherwise nullopt
+     */
+    std::optional<std::vector<Neighbors>>
+    getNeighbors(std::vector<ripple::uint256> const& keys, uint32_t seq) const;
+
+    /**
+     * @brief Reads a page of objects directly from the cache, in key order.
+     *
+     * Note: This function always returns std::nullopt when @ref isFull() returns false or seq is not the latest
+     * sequence. To keep writers from waiting too long, the lock is released after every PAGE_SCAN_SLICE objects looked
+     * at and the page is continued from the last key; nullopt is returned if the cache moved to another sequence in
+     * the meantime. At most MAX_PAGE_SCAN objects are looked at for one page; the returned cursor is then the last key
+     * looked at.
+     *
+     * @param cursor Only objects with keys after the cursor are returned; starts from the first key if nullopt
+     * @param end Only objects with keys before this one are returned; reads until the last key if nullopt
+     * @param seq The sequence to fetch for
+     * @param limit The maximum number of objects to return
+     * @param filter Only objects for which the filter returns true are returned and count towards the limit
+     * @return The page if the cache can serve it; otherwise nullopt is returned
+     */
+    std::optional<LedgerPage>
+    getPage(
+        std::optional<ripple::uint256> const& cursor,
+        std::optional<ripple::uint256> const& end,
+        uint32_t seq,
+        uint32_t limit,
+        std::function<bool(Blob const&)> const& filter
+    ) const;
+
     /**
      * @brief Disables the cache.
      */
@@ -0,0 +1,91 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.h"
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace data {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t const maxSize) : maxSize_(maxSize)
+{
+}
+
+void
+LedgerHeaderCache::put(ripple::LedgerHeader const& header)
+{
+    if (maxSize_ == 0)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (auto const [it, inserted] = bySequence_.try_emplace(header.seq, header); not inserted)
+        return;
+
+    sequenceByHash_[header.hash] = header.seq;
+
+    while (bySequence_.size() > maxSize_) {
+        auto const oldest = bySequence_.begin();
+        sequenceByHash_.erase(oldest->second.hash);
+        bySequence_.erase(oldest);
+    }
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::getBySequence(std::uint32_t const sequence) const
+{
+    ++reqCounter_.get();
+
+    std::shared_lock const lck{mtx_};
+    if (auto const it = bySequence_.find(sequence); it != bySequence_.end()) {
+        ++hitCounter_.get();
+        return it->second;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::getByHash(ripple::uint256 const& hash) const
+{
+    ++reqCounter_.get();
+
+    std::shared_lock const lck{mtx_};
+    if (auto const seqIt = sequenceByHash_.find(hash); seqIt != sequenceByHash_.end()) {
+        ++hitCounter_.get();
+        return bySequence_.at(seqIt->second);
+    }
+
+    return std::nullopt;
+}
+
+std::size_t
+LedgerHeaderCache::size() const
+{
+    std::shared_lock const lck{mtx_};
+    return bySequence_.size();
+}
+
+}  // namespace data
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Prometheus.h"
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace data {
+
+/**
+ * @brief Bounded cache of ledger headers, looked up either by sequence or by hash.
+ *
+ * Headers never change once a ledger is validated, so entries never need to be invalidated. When the cache is full
+ * the oldest ledger is dropped first as recent ledgers are by far the most requested.
+ */
+class LedgerHeaderCache {
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "ledger_header"}}),
+        "LedgerCache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "ledger_header"}})
+    )};
+
+    std::size_t const maxSize_;
+
+    mutable std::shared_mutex mtx_;
+    std::map<std::uint32_t, ripple::LedgerHeader> bySequence_;
+    std::unordered_map<ripple::uint256, std::uint32_t, ripple::hardened_hash<>> sequenceByHash_;
+
+public:
+    static constexpr std::size_t DEFAULT_SIZE = 4096;
+
+    /**
+     * @brief Construct a new Ledger Header Cache object
+     *
+     * @param maxSize The maximum number of headers to keep
+     */
+    explicit LedgerHeaderCache(std::size_t maxSize = DEFAULT_SIZE);
+
+    /**
+     * @brief Add a header to the cache, dropping the oldest one if the cache is full.
+     *
+     * @param header The header of a validated ledger
+     */
+    void
+    put(ripple::LedgerHeader const& header);
+
+    /**
+     * @brief Get a cached header by ledger sequence.
+     *
+     * @param sequence The sequence of the ledger
+     * @return The header if cached; nullopt otherwise
+     */
+    std::optional<ripple::LedgerHeader>
+    getBySequence(std::uint32_t sequence) const;
+
+    /**
+     * @brief Get a cached header by ledger hash.
+     *
+     * @param hash The hash of the ledger
+     * @return The header if cached; nullopt otherwise
+     */
+    std::optional<ripple::LedgerHeader>
+    getByHash(ripple::uint256 const& hash) const;
+
+    /**
+     * @return The number of cached headers
+     */
+    std::size_t
+    size() const;
+};
+
+}  // namespace data
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/TransactionsBundle.h"
+
+#include "data/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace {
+
+constexpr std::size_t SIZE_PREFIX_BYTES = 4;
+
+void
+appendWithSize(Blob& chunk, Blob const& blob)
+{
+    auto const size = static_cast<std::uint32_t>(blob.size());
+    for (std::size_t shift = SIZE_PREFIX_BYTES; shift-- > 0;)
+        chunk.push_back(static_cast<unsigned char>((size >> (shift * 8)) & 0xFF));
+
+    chunk.insert(chunk.end(), blob.begin(), blob.end());
+}
+
+std::optional<Blob>
+readWithSize(Blob const& chunk, std::size_t& offset)
+{
+    if (chunk.size() - offset < SIZE_PREFIX_BYTES)
+        return std::nullopt;
+
+    std::uint32_t size = 0;
+    for (std::size_t i = 0; i < SIZE_PREFIX_BYTES; ++i)
+        size = (size << 8) | chunk[offset++];
+
+    if (chunk.size() - offset < size)
+        return std::nullopt;
+
+    auto const begin = chunk.begin() + static_cast<std::ptrdiff_t>(offset);
+    offset += size;
+    return Blob(begin, begin + size);
+}
+
+}  // namespace
+
+std::vector<Blob>
+makeTransactionsBundle(std::vector<TransactionAndMetadata> const& transactions, std::size_t chunkSize)
+{
+    std::vector<Blob> chunks(1);
+
+    for (auto const& txn : transactions) {
+        if (chunks.back().size() >= chunkSize)
+            chunks.emplace_back();
+
+        auto& chunk = chunks.back();
+        appendWithSize(chunk, txn.transaction);
+        appendWithSize(chunk, txn.metadata);
+    }
+
+    return chunks;
+}
+
+std::optional<std::vector<TransactionAndMetadata>>
+readTransactionsBundle(std::vector<Blob> const& chunks, std::uint32_t ledgerSequence, std::uint32_t date)
+{
+    std::vector<TransactionAndMetadata> transactions;
+
+    for (auto const& chunk : chunks) {
+        std::size_t offset = 0;
+        while (offset < chunk.size()) {
+            auto transaction = readWithSize(chunk, offset);
+            if (not transaction)
+                return std::nullopt;
+
+            auto metadata = readWithSize(chunk, offset);
+            if (not metadata)
+                return std::nullopt;
+
+            transactions.emplace_back(std::move(*transaction), std::move(*metadata), ledgerSequence, date);
+        }
+    }
+
+    return transactions;
+}
+
+}  // namespace data
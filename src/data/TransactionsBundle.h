@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace data {
+
+/** @brief The size a transactions bundle chunk is closed at */
+static constexpr std::size_t TRANSACTIONS_BUNDLE_CHUNK_SIZE = 1024 * 1024;
+
+/**
+ * @brief Serialize all transactions of a ledger into a few large blobs, so the ledger can be read with one query.
+ *
+ * Every transaction is written as the 32 bit big-endian size of the transaction blob, the blob, the size of the
+ * metadata and the metadata. A chunk holds whole transactions only and is closed once it reaches the chunk size, so a
+ * transaction larger than that gets a chunk of its own. A ledger without transactions yields one empty chunk.
+ *
+ * @param transactions The transactions of the ledger in transaction index order
+ * @param chunkSize The size a chunk is closed at
+ * @return The chunks in order
+ */
+std::vector<Blob>
+makeTransactionsBundle(
+    std::vector<TransactionAndMetadata> const& transactions,
+    std::size_t chunkSize = TRANSACTIONS_BUNDLE_CHUNK_SIZE
+);
+
+/**
+ * @brief Read back the transactions serialized by @ref makeTransactionsBundle.
+ *
+ * @param chunks The chunks in order
+ * @param ledgerSequence The sequence of the ledger the bundle belongs to
+ * @param date The close time of the ledger
+ * @return The transactions in transaction index order; nullopt if the bundle is malformed
+ */
+std::optional<std::vector<TransactionAndMetadata>>
+readTransactionsBundle(std::vector<Blob> const& chunks, std::uint32_t ledgerSequence, std::uint32_t date);
+
+}  // namespace data
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/TrustLineAggregatesCache.h"
+
+#include "data/LedgerCache.h"
+#include "data/Types.h"
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/LedgerFormats.h>
+#include <ripple/protocol/SField.h>
+#include <ripple/protocol/STLedgerEntry.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace {
+
+void
+collectTrustLineAccounts(ripple::uint256 const& key, Blob const& blob, std::vector<ripple::AccountID>& accounts)
+{
+    ripple::SLE const sle{ripple::SerialIter{blob.data(), blob.size()}, key};
+    if (sle.getType() != ripple::ltRIPPLE_STATE)
+        return;
+
+    accounts.push_back(sle.getFieldAmount(ripple::sfLowLimit).getIssuer());
+    accounts.push_back(sle.getFieldAmount(ripple::sfHighLimit).getIssuer());
+}
+
+}  // namespace
+
+TrustLineAggregatesCache::TrustLineAggregatesCache(std::size_t const maxSize) : maxSize_(maxSize)
+{
+}
+
+void
+TrustLineAggregatesCache::update(
+    std::vector<LedgerObject> const& diff,
+    std::uint32_t const sequence,
+    LedgerCache const& cache
+)
+{
+    std::vector<ripple::AccountID> changed;
+    bool complete = true;
+
+    for (auto const& obj : diff) {
+        if (not obj.blob.empty()) {
+            collectTrustLineAccounts(obj.key, obj.blob, changed);
+        } else if (auto const previous = cache.get(obj.key, sequence - 1); previous) {
+            collectTrustLineAccounts(obj.key, *previous, changed);
+        } else {
+            // can't tell whose trust line it was if it was one
+            complete = false;
+            break;
+        }
+    }
+
+    std::scoped_lock const lck{mtx_};
+    if (not complete or latestSequence_ + 1 != sequence) {
+        entries_.clear();
+    } else {
+        for (auto const& account : changed)
+            entries_.erase(account);
+    }
+
+    latestSequence_ = sequence;
+}
+
+void
+TrustLineAggregatesCache::put(
+    ripple::AccountID const& account,
+    std::uint32_t const sequence,
+    std::shared_ptr<TrustLineAggregates const> aggregates
+)
+{
+    if (maxSize_ == 0 or aggregates == nullptr)
+        return;
+
+    std::scoped_lock const lck{mtx_};
+    if (sequence != latestSequence_ or entries_.contains(account))
+        return;
+
+    if (entries_.size() >= maxSize_) {
+        auto const oldest = std::min_element(entries_.begin(), entries_.end(), [](auto const& a, auto const& b) {
+            return a.second.validFrom < b.second.validFrom;
+        });
+        entries_.erase(oldest);
+    }
+
+    entries_.emplace(account, Entry{std::move(aggregates), sequence});
+}
+
+std::shared_ptr<TrustLineAggregates const>
+TrustLineAggregatesCache::get(ripple::AccountID const& account, std::uint32_t const sequence) const
+{
+    ++reqCounter_.get();
+
+    std::shared_lock const lck{mtx_};
+    if (sequence > latestSequence_)
+        return nullptr;
+
+    auto const it = entries_.find(account);
+    if (it == entries_.end() or it->second.validFrom > sequence)
+        return nullptr;
+
+    ++hitCounter_.get();
+    return it->second.aggregates;
+}
+
+std::uint32_t
+TrustLineAggregatesCache::latestSequence() const
+{
+    std::shared_lock const lck{mtx_};
+    return latestSequence_;
+}
+
+std::size_t
+TrustLineAggregatesCache::size() const
+{
+    std::shared_lock const lck{mtx_};
+    return entries_.size();
+}
+
+}  // namespace data
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/LedgerCache.h"
+#include "data/Types.h"
+#include "util/prometheus/Prometheus.h"
+
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/hardened_hash.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief Summary of the trust lines of an account, as returned by gateway_balances and account_currencies.
+ */
+struct TrustLineAggregates {
+    std::map<ripple::Currency, ripple::STAmount> obligations;
+    std::map<ripple::AccountID, std::vector<ripple::STAmount>> hotBalances;
+    std::map<ripple::AccountID, std::vector<ripple::STAmount>> assets;
+    std::map<ripple::AccountID, std::vector<ripple::STAmount>> frozenBalances;
+    std::set<std::string> receiveCurrencies;
+    std::set<std::string> sendCurrencies;
+};
+
+/**
+ * @brief Memoized trust line summaries of accounts, kept valid for the latest ledgers from the ledger diffs.
+ *
+ * A summary computed at the latest ledger stays valid until one of the trust lines of the account changes, so
+ * repeated requests for big issuers don't walk all of their trust lines again. Deleted objects are looked up in the
+ * ledger cache to find out whose trust line they were; if that is not possible all summaries are dropped.
+ */
+class TrustLineAggregatesCache {
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "trust_line_aggregates"}}),
+        "LedgerCache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "trust_line_aggregates"}})
+    )};
+
+    struct Entry {
+        std::shared_ptr<TrustLineAggregates const> aggregates;
+        std::uint32_t validFrom = 0;
+    };
+
+    std::size_t const maxSize_;
+
+    mutable std::shared_mutex mtx_;
+    std::uint32_t latestSequence_ = 0;
+    std::unordered_map<ripple::AccountID, Entry, ripple::hardened_hash<>> entries_;
+
+public:
+    static constexpr std::size_t DEFAULT_SIZE = 1024;
+
+    /**
+     * @brief Construct a new Trust Line Aggregates Cache object
+     *
+     * @param maxSize The maximum number of accounts to keep summaries for
+     */
+    explicit TrustLineAggregatesCache(std::size_t maxSize = DEFAULT_SIZE);
+
+    /**
+     * @brief Drop the summaries of all accounts whose trust lines changed in a ledger.
+     *
+     * Must be called with the diff of every ledger in order, before the ledger cache is updated with it.
+     *
+     * @param diff The objects created, modified or deleted in the ledger
+     * @param sequence The sequence of the ledger
+     * @param cache The ledger cache, still at the previous ledger
+     */
+    void
+    update(std::vector<LedgerObject> const& diff, std::uint32_t sequence, LedgerCache const& cache);
+
+    /**
+     * @brief Memoize the summary of an account.
+     *
+     * Summaries of any but the latest ledger seen by @ref update are ignored as they may already be outdated.
+     *
+     * @param account The account
+     * @param sequence The ledger the summary was computed at
+     * @param aggregates The summary
+     */
+    void
+    put(
+        ripple::AccountID const& account,
+        std::uint32_t sequence,
+        std::shared_ptr<TrustLineAggregates const> aggregates
+    );
+
+    /**
+     * @brief Get the memoized summary of an account.
+     *
+     * @param account The account
+     * @param sequence The ledger to get the summary at
+     * @return The summary if it is memoized and valid at the ledger; nullptr otherwise
+     */
+    std::shared_ptr<TrustLineAggregates const>
+    get(ripple::AccountID const& account, std::uint32_t sequence) const;
+
+    /**
+     * @return The latest ledger seen by @ref update
+     */
+    std::uint32_t
+    latestSequence() const;
+
+    /**
+     * @return The number of memoized summaries
+     */
+    std::size_t
+    size() const;
+};
+
+}  // namespace data
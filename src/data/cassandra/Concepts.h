@@ -63,6 +63,7 @@ concept SomeExecutionStrategy = requires(
     Handle handle,
     Statement statement,
     std::vector<Statement> statements,
+    Batch batch,
     PreparedStatement prepared,
     boost::asio::yield_context token
 ) {
@@ -87,6 +88,9 @@ concept SomeExecutionStrategy = requires(
     {
         a.write(std::move(statements))
     } -> std::same_as<void>;
+    {
+        a.write(std::move(batch))
+    } -> std::same_as<void>;
     {
         a.read(token, prepared)
     } -> std::same_as<ResultOrError>;
@@ -153,6 +153,12 @@ Handle::asyncExecute(std::vector<Statement> const& statements, std::function<voi
     return Handle::FutureWithCallbackType{cass_session_execute_batch(session_, Batch{statements}), std::move(cb)};
 }
 
+Handle::FutureWithCallbackType
+Handle::asyncExecute(Batch const& batch, std::function<void(Handle::ResultOrErrorType)>&& cb) const
+{
+    return Handle::FutureWithCallbackType{cass_session_execute_batch(session_, batch), std::move(cb)};
+}
+
 Handle::PreparedStatementType
 Handle::prepare(std::string_view query) const
 {
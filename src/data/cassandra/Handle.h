@@ -301,6 +301,16 @@ public:
     [[nodiscard]] FutureWithCallbackType
     asyncExecute(std::vector<StatementType> const& statements, std::function<void(ResultOrErrorType)>&& cb) const;
 
+    /**
+     * @brief Execute a batch asynchronously with a completion callback.
+     *
+     * @param batch The batch to execute
+     * @param cb The callback to execute when data is ready
+     * @return A future that holds onto the callback provided
+     */
+    [[nodiscard]] FutureWithCallbackType
+    asyncExecute(Batch const& batch, std::function<void(ResultOrErrorType)>&& cb) const;
+
     /**
      * @brief Prepare a statement.
      *
@@ -23,12 +23,15 @@
 #include "data/cassandra/Handle.h"
 #include "data/cassandra/SettingsProvider.h"
 #include "data/cassandra/Types.h"
+#include "data/cassandra/impl/AccountTxInline.h"
 #include "util/Expected.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
 
 #include <fmt/compile.h>
 
+#include <optional>
+
 namespace data::cassandra {
 
 template <SomeSettingsProvider SettingsProviderType>
@@ -118,6 +121,23 @@ public:
             settingsProvider_.get().getTtl()
         ));
 
+        statements.emplace_back(fmt::format(
+            R"(
+           CREATE TABLE IF NOT EXISTS {}
+                  ( 
+                    sequence bigint,
+                       chunk bigint,
+                    tx_count bigint,
+                        date bigint,
+                transactions blob,
+                 PRIMARY KEY (sequence, chunk)
+                  ) 
+             WITH default_time_to_live = {}
+            )",
+            qualifiedTableName(settingsProvider_.get(), "ledger_transactions_bundle"),
+            settingsProvider_.get().getTtl()
+        ));
+
         statements.emplace_back(fmt::format(
             R"(
            CREATE TABLE IF NOT EXISTS {}
@@ -163,6 +183,39 @@ public:
             settingsProvider_.get().getTtl()
         ));
 
+        // account_tx_inline holds the transactions of each account as well, so that they don't have to be read one by
+        // one; account_tx_inline_range has the first and the latest ledger it is complete for
+        if (settingsProvider_.get().getSettings().inlineAccountTransactions) {
+            statements.emplace_back(fmt::format(
+                R"(
+               CREATE TABLE IF NOT EXISTS {}
+                      ( 
+                        account blob,    
+                        seq_idx tuple<bigint, bigint>, 
+                    transaction blob,
+                       metadata blob,
+                           date bigint,
+                        PRIMARY KEY (account, seq_idx) 
+                      ) 
+                 WITH CLUSTERING ORDER BY (seq_idx DESC)
+                  AND default_time_to_live = {}
+                )",
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline"),
+                settingsProvider_.get().getTtl()
+            ));
+
+            statements.emplace_back(fmt::format(
+                R"(
+               CREATE TABLE IF NOT EXISTS {}
+                      ( 
+                        is_latest boolean PRIMARY KEY,
+                         sequence bigint
+                      )
+                )",
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline_range")
+            ));
+        }
+
         statements.emplace_back(fmt::format(
             R"(
            CREATE TABLE IF NOT EXISTS {}
@@ -281,6 +334,17 @@ public:
         {
         }
 
+        /**
+         * @brief Whether the account_tx_inline statements are prepared; they are only if the tables are created.
+         *
+         * @return true if account transactions are stored inline; false otherwise
+         */
+        [[nodiscard]] bool
+        inlineAccountTransactions() const
+        {
+            return settingsProvider_.get().getSettings().inlineAccountTransactions;
+        }
+
         //
         // Insert queries
         //
@@ -318,6 +382,17 @@ public:
             ));
         }();
 
+        PreparedStatement insertLedgerTransactionsBundle = [this]() {
+            return handle_.get().prepare(fmt::format(
+                R"(
+                INSERT INTO {} 
+                       (sequence, chunk, tx_count, date, transactions)
+                VALUES (?, ?, ?, ?, ?)
+                )",
+                qualifiedTableName(settingsProvider_.get(), "ledger_transactions_bundle")
+            ));
+        }();
+
         PreparedStatement insertSuccessor = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
@@ -351,6 +426,34 @@ public:
             ));
         }();
 
+        std::optional<PreparedStatement> insertAccountTxInline = [this]() -> std::optional<PreparedStatement> {
+            if (not inlineAccountTransactions())
+                return std::nullopt;
+
+            return handle_.get().prepare(fmt::format(
+                R"(
+                INSERT INTO {} 
+                       (account, seq_idx, transaction, metadata, date)
+                VALUES (?, ?, ?, ?, ?)
+                )",
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline")
+            ));
+        }();
+
+        std::optional<PreparedStatement> insertAccountTxInlineRange = [this]() -> std::optional<PreparedStatement> {
+            if (not inlineAccountTransactions())
+                return std::nullopt;
+
+            return handle_.get().prepare(fmt::format(
+                R"(
+                INSERT INTO {} 
+                       (is_latest, sequence)
+                VALUES (?, ?)
+                )",
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline_range")
+            ));
+        }();
+
         PreparedStatement insertNFT = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
@@ -509,6 +612,17 @@ public:
             ));
         }();
 
+        PreparedStatement selectLedgerTransactionsBundle = [this]() {
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT tx_count, date, transactions
+                  FROM {}
+                 WHERE sequence = ?
+                )",
+                qualifiedTableName(settingsProvider_.get(), "ledger_transactions_bundle")
+            ));
+        }();
+
         PreparedStatement selectLedgerPageKeys = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
@@ -578,6 +692,56 @@ public:
             ));
         }();
 
+        std::optional<PreparedStatement> selectAccountTxInline = [this]() -> std::optional<PreparedStatement> {
+            if (not inlineAccountTransactions())
+                return std::nullopt;
+
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT {}
+                  FROM {}               
+                 WHERE account = ?
+                   AND seq_idx < ?
+                   AND seq_idx >= ?
+                 LIMIT ?
+                )",
+                detail::ACCOUNT_TX_INLINE_COLUMNS,
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline")
+            ));
+        }();
+
+        std::optional<PreparedStatement> selectAccountTxInlineForward = [this]() -> std::optional<PreparedStatement> {
+            if (not inlineAccountTransactions())
+                return std::nullopt;
+
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT {}
+                  FROM {}               
+                 WHERE account = ?
+                   AND seq_idx > ?
+                   AND seq_idx <= ?
+              ORDER BY seq_idx ASC 
+                 LIMIT ?
+                )",
+                detail::ACCOUNT_TX_INLINE_COLUMNS,
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline")
+            ));
+        }();
+
+        std::optional<PreparedStatement> selectAccountTxInlineRange = [this]() -> std::optional<PreparedStatement> {
+            if (not inlineAccountTransactions())
+                return std::nullopt;
+
+            return handle_.get().prepare(fmt::format(
+                R"(
+                SELECT is_latest, sequence
+                  FROM {}
+                )",
+                qualifiedTableName(settingsProvider_.get(), "account_tx_inline_range")
+            ));
+        }();
+
         PreparedStatement selectNFT = [this]() {
             return handle_.get().prepare(fmt::format(
                 R"(
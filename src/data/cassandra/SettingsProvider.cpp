@@ -125,6 +125,12 @@ SettingsProvider::parseSettings() const
         config_.valueOr<uint32_t>("core_connections_per_host", settings.coreConnectionsPerHost);
     settings.queueSizeIO = config_.maybeValue<uint32_t>("queue_size_io");
     settings.writeBatchSize = config_.valueOr<std::size_t>("write_batch_size", settings.writeBatchSize);
+    if (auto const batchSizeKb = config_.maybeValue<std::size_t>("write_batch_size_kb"); batchSizeKb)
+        settings.writeBatchSizeBytes = *batchSizeKb * 1024;
+    settings.inlineAccountTransactions =
+        config_.valueOr<bool>("account_tx_inline", settings.inlineAccountTransactions);
+    settings.bundleLedgerTransactions =
+        config_.valueOr<bool>("ledger_transactions_bundle", settings.bundleLedgerTransactions);
 
     auto const connectTimeoutSecond = config_.maybeValue<uint32_t>("connect_timeout");
     if (connectTimeoutSecond)
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.h"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace data::cassandra::detail {
+
+/**
+ * @brief The columns read from account_tx_inline, in the order of @ref AccountTxInlineRow.
+ */
+static constexpr std::string_view ACCOUNT_TX_INLINE_COLUMNS = "seq_idx, transaction, metadata, date";
+
+/**
+ * @brief A row read from account_tx_inline: the ledger sequence and transaction index, the transaction, its metadata
+ * and the close time of the ledger.
+ */
+using AccountTxInlineRow = std::tuple<std::tuple<std::uint32_t, std::uint32_t>, Blob, Blob, std::uint32_t>;
+
+/**
+ * @brief Build a page of account transactions from the rows read from account_tx_inline.
+ *
+ * The cursor is only set if the page is full. Going forward it points past the last transaction, so that cursors work
+ * the same with account_tx.
+ *
+ * @param rows The rows, each one an @ref AccountTxInlineRow
+ * @param limit The number of transactions that was asked for
+ * @param forward Whether the rows are in ascending order
+ * @return The transactions and the cursor to the next page
+ */
+template <typename RowsType>
+[[nodiscard]] TransactionsAndCursor
+toInlineAccountTransactions(RowsType&& rows, std::uint32_t limit, bool forward)
+{
+    TransactionsAndCursor result;
+    for (auto [seqIdx, transaction, metadata, date] : std::forward<RowsType>(rows)) {
+        result.txns.emplace_back(std::move(transaction), std::move(metadata), std::get<0>(seqIdx), date);
+        result.cursor = seqIdx;
+    }
+
+    if (result.txns.size() != limit) {
+        result.cursor = std::nullopt;
+    } else if (forward) {
+        ++result.cursor->transactionIndex;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Read the ledgers that account_tx_inline is complete for from the rows of account_tx_inline_range.
+ *
+ * @param rows The rows, each one the is_latest flag and a ledger sequence
+ * @return The first and the latest ledger; nullopt if either is missing or they are out of order
+ */
+template <typename RowsType>
+[[nodiscard]] std::optional<LedgerRange>
+toInlineAccountTransactionsRange(RowsType&& rows)
+{
+    std::optional<std::uint32_t> start;
+    std::optional<std::uint32_t> latest;
+    for (auto [isLatest, sequence] : std::forward<RowsType>(rows))
+        (isLatest ? latest : start) = sequence;
+
+    if (not start or not latest or *start > *latest)
+        return std::nullopt;
+
+    return LedgerRange{.minSequence = *start, .maxSequence = *latest};
+}
+
+}  // namespace data::cassandra::detail
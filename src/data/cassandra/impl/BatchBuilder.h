@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data::cassandra::detail {
+
+/**
+ * @brief Groups write statements into single partition batches.
+ *
+ * A batch only holds statements writing to the same partition, so that it is applied by the replicas of that partition
+ * without a coordinator fanning it out. A batch never holds more than the given number of statements nor more than the
+ * given number of bytes, unless a single statement is bigger than that.
+ *
+ * @tparam StatementType The type of the statements to batch
+ */
+template <typename StatementType>
+class BatchBuilder {
+    struct Entry {
+        std::string partition;
+        std::size_t size;
+        StatementType statement;
+    };
+
+    std::size_t maxStatements_;
+    std::size_t maxBytes_;
+
+    std::vector<Entry> entries_;
+    std::size_t bytes_ = 0;
+
+public:
+    /**
+     * @brief Construct a new builder.
+     *
+     * @param maxStatements The maximum number of statements in a batch
+     * @param maxBytes The maximum size of the values written by a batch
+     */
+    BatchBuilder(std::size_t maxStatements, std::size_t maxBytes)
+        : maxStatements_{std::max<std::size_t>(maxStatements, 1)}, maxBytes_{maxBytes}
+    {
+    }
+
+    /**
+     * @brief Add a statement.
+     *
+     * @param partition Identifies the table and partition key written by the statement
+     * @param size The size of the values written by the statement
+     * @param statement The statement
+     */
+    void
+    add(std::string partition, std::size_t size, StatementType&& statement)
+    {
+        bytes_ += size;
+        entries_.push_back({.partition = std::move(partition), .size = size, .statement = std::move(statement)});
+    }
+
+    /**
+     * @return The number of statements added since the last call to take()
+     */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return entries_.size();
+    }
+
+    /**
+     * @brief Whether the added statements fill at least the given number of batches.
+     *
+     * @param numBatches The number of batches
+     * @return true if there are enough statements or bytes for that many batches; false otherwise
+     */
+    [[nodiscard]] bool
+    fills(std::size_t numBatches) const
+    {
+        return entries_.size() >= numBatches * maxStatements_ or bytes_ >= numBatches * maxBytes_;
+    }
+
+    /**
+     * @brief Split all added statements into batches and start over.
+     *
+     * @return The batches
+     */
+    [[nodiscard]] std::vector<std::vector<StatementType>>
+    take()
+    {
+        std::stable_sort(entries_.begin(), entries_.end(), [](Entry const& lhs, Entry const& rhs) {
+            return lhs.partition < rhs.partition;
+        });
+
+        std::vector<std::vector<StatementType>> batches;
+        std::size_t batchBytes = 0;
+        std::string const* batchPartition = nullptr;
+        for (auto& entry : entries_) {
+            if (batches.empty() or *batchPartition != entry.partition or batches.back().size() >= maxStatements_ or
+                batchBytes + entry.size > maxBytes_) {
+                batches.emplace_back();
+                batchBytes = 0;
+                batchPartition = &entry.partition;
+            }
+
+            batches.back().push_back(std::move(entry.statement));
+            batchBytes += entry.size;
+        }
+
+        entries_.clear();
+        bytes_ = 0;
+        return batches;
+    }
+};
+
+}  // namespace data::cassandra::detail
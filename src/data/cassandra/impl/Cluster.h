@@ -43,6 +43,7 @@ struct Settings {
     static constexpr uint32_t DEFAULT_MAX_WRITE_REQUESTS_OUTSTANDING = 10'000;
     static constexpr uint32_t DEFAULT_MAX_READ_REQUESTS_OUTSTANDING = 100'000;
     static constexpr std::size_t DEFAULT_BATCH_SIZE = 20;
+    static constexpr std::size_t DEFAULT_BATCH_SIZE_KB = 32;
 
     /**
      * @brief Represents the configuration of contact points for cassandra.
@@ -86,6 +87,15 @@ struct Settings {
     /** @brief Size of batches when writing */
     std::size_t writeBatchSize = DEFAULT_BATCH_SIZE;
 
+    /** @brief Most bytes written by one batch of ledger diffs */
+    std::size_t writeBatchSizeBytes = DEFAULT_BATCH_SIZE_KB * 1024;
+
+    /** @brief Whether account transactions are also written with their blobs inline and read from there */
+    bool inlineAccountTransactions = false;
+
+    /** @brief Whether all transactions of a ledger are also written as one bundle and read from there */
+    bool bundleLedgerTransactions = false;
+
     /** @brief Size of the IO queue */
     std::optional<uint32_t> queueSizeIO{};
 
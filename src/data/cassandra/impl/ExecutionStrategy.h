@@ -204,6 +204,35 @@ public:
         );
     }
 
+    /**
+     * @brief Non-blocking execution of a batch built by the caller, used for writing data.
+     *
+     * Retries forever with retry policy specified by @ref AsyncExecutor.
+     *
+     * @param batch The batch to execute
+     * @throw DatabaseTimeout on timeout
+     */
+    void
+    write(Batch&& batch)
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        incrementOutstandingRequestCount();
+        counters_->registerWriteStarted();
+
+        // Note: lifetime is controlled by std::shared_from_this internally
+        AsyncExecutor<Batch, HandleType>::run(
+            ioc_,
+            handle_,
+            std::move(batch),
+            [this, startTime](auto const&) {
+                decrementOutstandingRequestCount();
+                counters_->registerWriteFinished(startTime);
+            },
+            [this]() { counters_->registerWriteRetry(); }
+        );
+    }
+
     /**
      * @brief Non-blocking batched query execution used for writing data.
      *
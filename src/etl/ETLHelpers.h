@@ -85,6 +85,18 @@ public:
         return max_;
     }
 
+    /**
+     * @brief Get most recently validated sequence without waiting for one.
+     *
+     * @return Sequence of most recently validated ledger if any is known; nullopt otherwise
+     */
+    std::optional<uint32_t>
+    peekMostRecent() const
+    {
+        std::lock_guard const lck(m_);
+        return max_;
+    }
+
     /**
      * @brief Waits for the sequence to be validated by the network.
      *
@@ -19,7 +19,10 @@
 
 #include "etl/ETLService.h"
 
+#include "data/BackendFactory.h"
 #include "data/BackendInterface.h"
+#include "etl/impl/LedgerEventClient.h"
+#include "etl/impl/LedgerEventServer.h"
 #include "util/Assert.h"
 #include "util/Constants.h"
 #include "util/config/Config.h"
@@ -29,6 +32,7 @@
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/protocol/LedgerHeader.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +44,34 @@
 #include <vector>
 
 namespace etl {
+
+namespace {
+
+// how long read-only processes wait for the writer to stream the next ledger before looking for it in the database
+constexpr auto LEDGER_EVENT_WAIT_TIME = std::chrono::seconds{1};
+
+std::shared_ptr<detail::LedgerEventServer>
+makeLedgerEventServer(util::Config const& config)
+{
+    // read-only processes never write ledgers
+    if (config.valueOr("read_only", false) or not config.contains("ledger_stream"))
+        return nullptr;
+
+    auto const streamConfig = config.section("ledger_stream");
+    if (not streamConfig.contains("port"))
+        return nullptr;
+
+    return std::make_shared<detail::LedgerEventServer>(streamConfig);
+}
+
+std::size_t
+decodeThreads(util::Config const& config)
+{
+    return config.valueOr<std::size_t>("transaction_decode_threads", detail::TransactionDecoder::DEFAULT_NUM_THREADS);
+}
+
+}  // namespace
+
 // Database must be populated when this starts
 std::optional<uint32_t>
 ETLService::runETLPipeline(uint32_t startSequence, uint32_t numExtractors)
@@ -61,7 +93,7 @@ ETLService::runETLPipeline(uint32_t startSequence, uint32_t numExtractors)
 
     auto const begin = std::chrono::system_clock::now();
     auto extractors = std::vector<std::unique_ptr<ExtractorType>>{};
-    auto pipe = DataPipeType{numExtractors, startSequence};
+    auto pipe = DataPipeType{numExtractors, startSequence, extractorThreads_};
 
     for (auto i = 0u; i < numExtractors; ++i) {
         extractors.push_back(std::make_unique<ExtractorType>(
@@ -144,6 +176,9 @@ ETLService::monitor()
     }
 
     ASSERT(rng.has_value(), "Ledger range can't be null");
+    if (backfill_)
+        backfill_->start();
+
     uint32_t nextSequence = rng->maxSequence + 1;
 
     LOG(log_.debug()) << "Database is populated. "
@@ -177,7 +212,7 @@ ETLService::publishNextSequence(uint32_t nextSequence)
             LOG(log_.warn()) << "Failed to publish ledger with sequence = " << nextSequence << " . Beginning ETL";
 
             // returns the most recent sequence published empty optional if no sequence was published
-            std::optional<uint32_t> lastPublished = runETLPipeline(nextSequence, extractorThreads_);
+            std::optional<uint32_t> lastPublished = runETLPipeline(nextSequence, maxExtractorThreads_);
             LOG(log_.info()) << "Aborting ETL. Falling back to publishing";
 
             // if no ledger was published, don't increment nextSequence
@@ -218,6 +253,15 @@ ETLService::monitorReadOnly()
     latestSequence++;
 
     while (not isStopping()) {
+        // the writer streams each ledger right after writing it; only missed ledgers are read from the database
+        if (ledgerEventClient_) {
+            if (auto event = ledgerEventClient_->waitFor(latestSequence, LEDGER_EVENT_WAIT_TIME)) {
+                ledgerPublisher_.publish(std::move(event));
+                latestSequence = latestSequence + 1;
+                continue;
+            }
+        }
+
         if (auto rng = backend_->hardFetchLedgerRangeNoThrow(); rng && rng->maxSequence >= latestSequence) {
             ledgerPublisher_.publish(latestSequence, {});
             latestSequence = latestSequence + 1;
@@ -266,14 +310,32 @@ ETLService::ETLService(
     , networkValidatedLedgers_(std::move(ledgers))
     , cacheLoader_(config, ioc, backend, backend->cache())
     , ledgerFetcher_(backend, balancer)
-    , ledgerLoader_(backend, balancer, ledgerFetcher_, state_)
-    , ledgerPublisher_(ioc, backend, backend->cache(), subscriptions, state_)
+    , ledgerLoader_(backend, balancer, ledgerFetcher_, state_, decodeThreads(config))
+    , ledgerEventServer_(makeLedgerEventServer(config))
+    , ledgerPublisher_(ioc, backend, backend->cache(), subscriptions, state_, ledgerEventServer_)
     , amendmentBlockHandler_(ioc, state_)
 {
     startSequence_ = config.maybeValue<uint32_t>("start_sequence");
     finishSequence_ = config.maybeValue<uint32_t>("finish_sequence");
     state_.isReadOnly = config.valueOr("read_only", state_.isReadOnly);
     extractorThreads_ = config.valueOr<uint32_t>("extractor_threads", extractorThreads_);
+    maxExtractorThreads_ = std::max(config.valueOr<uint32_t>("max_extractor_threads", 0u), extractorThreads_);
     txnThreshold_ = config.valueOr<size_t>("txn_threshold", txnThreshold_);
+
+    if (state_.isReadOnly and config.contains("ledger_stream")) {
+        auto const streamConfig = config.section("ledger_stream");
+        if (not streamConfig.arrayOr("peers", {}).empty())
+            ledgerEventClient_ = std::make_unique<detail::LedgerEventClient>(streamConfig);
+    }
+
+    if (not state_.isReadOnly and config.contains("backfill")) {
+        // a backend of its own, so that waiting for the backfill writes never holds up the writes of new ledgers
+        backfillBackend_ = data::make_Backend(config);
+        backfillFetcher_.emplace(backfillBackend_, balancer);
+        backfillLoader_.emplace(backfillBackend_, balancer, *backfillFetcher_, state_, decodeThreads(config));
+        backfill_ = std::make_unique<BackfillType>(
+            config.section("backfill"), backfillBackend_, backend_, loadBalancer_, *backfillLoader_, state_
+        );
+    }
 }
 }  // namespace etl
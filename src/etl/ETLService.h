@@ -25,9 +25,12 @@
 #include "etl/Source.h"
 #include "etl/SystemState.h"
 #include "etl/impl/AmendmentBlock.h"
+#include "etl/impl/Backfill.h"
 #include "etl/impl/CacheLoader.h"
 #include "etl/impl/ExtractionDataPipe.h"
 #include "etl/impl/Extractor.h"
+#include "etl/impl/LedgerEventClient.h"
+#include "etl/impl/LedgerEventServer.h"
 #include "etl/impl/LedgerFetcher.h"
 #include "etl/impl/LedgerLoader.h"
 #include "etl/impl/LedgerPublisher.h"
@@ -81,6 +84,7 @@ class ETLService {
     using AmendmentBlockHandlerType = etl::detail::AmendmentBlockHandler<>;
     using TransformerType =
         etl::detail::Transformer<DataPipeType, LedgerLoaderType, LedgerPublisherType, AmendmentBlockHandlerType>;
+    using BackfillType = etl::detail::Backfill<LoadBalancerType, LedgerLoaderType>;
 
     util::Logger log_{"ETL"};
 
@@ -89,16 +93,24 @@ class ETLService {
     std::shared_ptr<NetworkValidatedLedgersType> networkValidatedLedgers_;
 
     std::uint32_t extractorThreads_ = 1;
+    std::uint32_t maxExtractorThreads_ = 1;
     std::thread worker_;
 
     CacheLoaderType cacheLoader_;
     LedgerFetcherType ledgerFetcher_;
     LedgerLoaderType ledgerLoader_;
+    std::shared_ptr<etl::detail::LedgerEventServer> ledgerEventServer_;
+    std::unique_ptr<etl::detail::LedgerEventClient> ledgerEventClient_;
     LedgerPublisherType ledgerPublisher_;
     AmendmentBlockHandlerType amendmentBlockHandler_;
 
     SystemState state_;
 
+    std::shared_ptr<BackendInterface> backfillBackend_;
+    std::optional<LedgerFetcherType> backfillFetcher_;
+    std::optional<LedgerLoaderType> backfillLoader_;
+    std::unique_ptr<BackfillType> backfill_;
+
     size_t numMarkers_ = 2;
     std::optional<uint32_t> startSequence_;
     std::optional<uint32_t> finishSequence_;
@@ -163,6 +175,9 @@ public:
         state_.isStopping = true;
         cacheLoader_.stop();
 
+        if (backfill_)
+            backfill_->stop();
+
         if (worker_.joinable())
             worker_.join();
 
@@ -223,8 +238,11 @@ private:
      * Extracts ledgers and writes them to the database, until a write conflict occurs (or the server shuts down).
      * @note database must already be populated when this function is called
      *
+     * Ledgers are fetched by extractorThreads_ extractors at once to start with. The limit then follows the pipeline:
+     * it grows while the writer waits for ledgers and shrinks while extracted ledgers pile up.
+     *
      * @param startSequence the first ledger to extract
-     * @param numExtractors number of extractors to use
+     * @param numExtractors number of extractors to use, which is also the most ledgers fetched at once
      * @return the last ledger written to the database, if any
      */
     std::optional<uint32_t>
@@ -255,7 +273,8 @@ private:
      * @brief Monitor the database for newly written ledgers.
      *
      * Similar to the monitor(), except this function will never call runETLPipeline() or loadInitialLedger().
-     * This function only publishes ledgers as they are written to the database.
+     * This function only publishes ledgers as they are written to the database. Ledgers streamed by the ETL writer
+     * are published without reading them from the database.
      */
     void
     monitorReadOnly();
@@ -25,8 +25,8 @@
 #include "etl/ETLState.h"
 #include "etl/ProbingSource.h"
 #include "etl/Source.h"
+#include "etl/impl/InitialLoadQueue.h"
 #include "util/Assert.h"
-#include "util/Random.h"
 #include "util/log/Logger.h"
 
 #include <boost/asio/io_context.hpp>
@@ -40,7 +40,10 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -87,10 +90,10 @@ LoadBalancer::LoadBalancer(
     std::shared_ptr<feed::SubscriptionManager> subscriptions,
     std::shared_ptr<NetworkValidatedLedgers> validatedLedgers
 )
+    : validatedLedgers_(validatedLedgers)
 {
-    static constexpr std::uint32_t MAX_DOWNLOAD = 256;
     if (auto value = config.maybeValue<uint32_t>("num_markers"); value) {
-        downloadRanges_ = std::clamp(*value, 1u, MAX_DOWNLOAD);
+        downloadRanges_ = std::clamp(*value, 1u, MAX_DOWNLOAD_RANGES);
     } else if (backend->fetchLedgerRange()) {
         downloadRanges_ = 4;
     }
@@ -127,6 +130,9 @@ LoadBalancer::LoadBalancer(
             etlState_ = stateOpt;
         }
 
+        scheduler_.add(
+            fmt::format("{}:{}", entry.valueOr<std::string>("ip", {}), entry.valueOr<std::string>("ws_port", {}))
+        );
         sources_.push_back(std::move(source));
         LOG(log_.info()) << "Added etl source - " << sources_.back()->toString();
     }
@@ -143,27 +149,80 @@ LoadBalancer::~LoadBalancer()
 std::pair<std::vector<std::string>, bool>
 LoadBalancer::loadInitialLedger(uint32_t sequence, bool cacheOnly)
 {
-    std::vector<std::string> response;
-    auto const success = execute(
-        [this, &response, &sequence, cacheOnly](auto& source) {
-            auto [data, res] = source->loadInitialLedger(sequence, downloadRanges_, cacheOnly);
-
-            if (!res) {
-                LOG(log_.error()) << "Failed to download initial ledger."
-                                  << " Sequence = " << sequence << " source = " << source->toString();
-            } else {
-                response = std::move(data);
+    auto const start = std::chrono::steady_clock::now();
+    auto backoff = std::chrono::steady_clock::duration{INITIAL_BACKOFF};
+
+    // created once the number of sources to download from is known; kept across attempts so that they resume
+    std::optional<detail::InitialLoadQueue> ranges;
+    std::vector<std::string> edgeKeys;
+    std::mutex edgeKeysMtx;
+
+    while (true) {
+        updateFreshness();
+
+        // ejected sources only download if no other source has the ledger
+        std::vector<std::size_t> downloaders;
+        for (std::size_t idx = 0; idx < sources_.size(); ++idx) {
+            if (sources_[idx]->hasLedger(sequence))
+                downloaders.push_back(idx);
+        }
+        auto const ejected = [this](auto idx) { return scheduler_.isEjected(idx); };
+        if (std::count_if(downloaders.cbegin(), downloaders.cend(), ejected) < std::ssize(downloaders))
+            std::erase_if(downloaders, ejected);
+
+        if (not downloaders.empty()) {
+            if (not ranges) {
+                auto const numRanges = std::min<std::size_t>(MAX_DOWNLOAD_RANGES, downloadRanges_ * downloaders.size());
+                ranges.emplace(getMarkers(numRanges));
             }
 
-            return res;
-        },
-        sequence
-    );
-    return {std::move(response), success};
+            LOG(log_.info()) << "Downloading ledger " << sequence << " from " << downloaders.size()
+                             << " sources. Ranges left = " << ranges->remaining();
+
+            std::vector<std::thread> threads;
+            threads.reserve(downloaders.size());
+            for (auto const idx : downloaders) {
+                threads.emplace_back([&, idx]() {
+                    auto& source = sources_[idx];
+
+                    scheduler_.onStart(idx);
+                    auto [keys, res] = source->loadInitialLedger(sequence, *ranges, downloadRanges_, cacheOnly);
+                    scheduler_.onFinish(idx, res, detail::SourceScheduler::RequestClass::Fetch, std::nullopt);
+
+                    if (!res) {
+                        LOG(log_.error()) << "Failed to download initial ledger."
+                                          << " Sequence = " << sequence << " source = " << source->toString();
+                    }
+
+                    std::scoped_lock const lck{edgeKeysMtx};
+                    std::move(keys.begin(), keys.end(), std::back_inserter(edgeKeys));
+                });
+            }
+
+            for (auto& thread : threads)
+                thread.join();
+
+            if (ranges->done()) {
+                auto const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                LOG(log_.info()) << "Downloaded ledger " << sequence << " in " << seconds << " seconds";
+                return {std::move(edgeKeys), true};
+            }
+        }
+
+        LOG(log_.info()) << "Ledger sequence " << sequence << " could not be downloaded completely yet. Ranges left = "
+                         << (ranges ? ranges->remaining() : 0) << ". Sleeping and trying again";
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min<std::chrono::steady_clock::duration>(backoff * 2, MAX_BACKOFF);
+    }
 }
 
 LoadBalancer::OptionalGetLedgerResponseType
-LoadBalancer::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors)
+LoadBalancer::fetchLedger(
+    uint32_t ledgerSequence,
+    bool getObjects,
+    bool getObjectNeighbors,
+    std::optional<std::uint32_t> maxAttempts
+)
 {
     GetLedgerResponseType response;
     bool const success = execute(
@@ -181,7 +240,8 @@ LoadBalancer::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObje
                             << ", source = " << source->toString();
             return false;
         },
-        ledgerSequence
+        ledgerSequence,
+        maxAttempts
     );
     if (success) {
         return response;
@@ -196,18 +256,26 @@ LoadBalancer::forwardToRippled(
     boost::asio::yield_context yield
 ) const
 {
-    std::size_t sourceIdx = 0;
-    if (!sources_.empty())
-        sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
+    updateFreshness();
 
-    auto numAttempts = 0u;
+    std::vector<std::size_t> candidates(sources_.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
 
-    while (numAttempts < sources_.size()) {
-        if (auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, yield))
-            return res;
+    while (!candidates.empty()) {
+        auto const sourceIdx = scheduler_.pick(candidates, detail::SourceScheduler::RequestClass::Forward);
+        auto const start = std::chrono::steady_clock::now();
+
+        scheduler_.onStart(sourceIdx);
+        auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, yield);
+        scheduler_.onFinish(
+            sourceIdx,
+            res.has_value(),
+            detail::SourceScheduler::RequestClass::Forward,
+            std::chrono::steady_clock::now() - start
+        );
 
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        ++numAttempts;
+        if (res)
+            return res;
     }
 
     return {};
@@ -232,55 +300,87 @@ boost::json::value
 LoadBalancer::toJson() const
 {
     boost::json::array ret;
-    for (auto& src : sources_)
-        ret.push_back(src->toJson());
+    for (std::size_t idx = 0; idx < sources_.size(); ++idx) {
+        auto json = sources_[idx]->toJson();
+        json["scheduling"] = scheduler_.toJson(idx);
+        ret.push_back(std::move(json));
+    }
 
     return ret;
 }
 
 template <class Func>
 bool
-LoadBalancer::execute(Func f, uint32_t ledgerSequence)
+LoadBalancer::execute(Func f, uint32_t ledgerSequence, std::optional<std::uint32_t> maxAttempts)
 {
-    std::size_t sourceIdx = 0;
-    if (!sources_.empty())
-        sourceIdx = util::Random::uniform(0ul, sources_.size() - 1);
+    if (sources_.empty()) {
+        LOG(log_.error()) << "No sources configured to fetch ledger sequence " << ledgerSequence << " from";
+        return false;
+    }
 
-    auto numAttempts = 0;
+    auto backoff = std::chrono::steady_clock::duration{INITIAL_BACKOFF};
 
-    while (true) {
-        auto& source = sources_[sourceIdx];
-
-        LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
-                          << " - source = " << source->toString();
-        // Originally, it was (source->hasLedger(ledgerSequence) || true)
-        /* Sometimes rippled has ledger but doesn't actually know. However,
-        but this does NOT happen in the normal case and is safe to remove
-        This || true is only needed when loading full history standalone */
-        if (source->hasLedger(ledgerSequence)) {
+    for (std::uint32_t attempt = 1;; ++attempt) {
+        updateFreshness();
+
+        std::vector<std::size_t> candidates;
+        for (std::size_t idx = 0; idx < sources_.size(); ++idx) {
+            // Originally, it was (source->hasLedger(ledgerSequence) || true)
+            /* Sometimes rippled has ledger but doesn't actually know. However,
+            but this does NOT happen in the normal case and is safe to remove
+            This || true is only needed when loading full history standalone */
+            if (sources_[idx]->hasLedger(ledgerSequence)) {
+                candidates.push_back(idx);
+            } else {
+                LOG(log_.warn()) << "Ledger not present at source = " << sources_[idx]->toString()
+                                 << " - ledger sequence = " << ledgerSequence;
+            }
+        }
+
+        while (!candidates.empty()) {
+            auto const sourceIdx = scheduler_.pick(candidates, detail::SourceScheduler::RequestClass::Fetch);
+            auto& source = sources_[sourceIdx];
+
+            LOG(log_.debug()) << "Attempting to execute func. ledger sequence = " << ledgerSequence
+                              << " - source = " << source->toString();
+
+            auto const start = std::chrono::steady_clock::now();
+            scheduler_.onStart(sourceIdx);
             bool const res = f(source);
+            scheduler_.onFinish(
+                sourceIdx, res, detail::SourceScheduler::RequestClass::Fetch, std::chrono::steady_clock::now() - start
+            );
+
             if (res) {
                 LOG(log_.debug()) << "Successfully executed func at source = " << source->toString()
                                   << " - ledger sequence = " << ledgerSequence;
-                break;
+                return true;
             }
 
             LOG(log_.warn()) << "Failed to execute func at source = " << source->toString()
                              << " - ledger sequence = " << ledgerSequence;
-        } else {
-            LOG(log_.warn()) << "Ledger not present at source = " << source->toString()
-                             << " - ledger sequence = " << ledgerSequence;
         }
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        numAttempts++;
-        if (numAttempts % sources_.size() == 0) {
-            LOG(log_.info()) << "Ledger sequence " << ledgerSequence
-                             << " is not yet available from any configured sources. "
-                             << "Sleeping and trying again";
-            std::this_thread::sleep_for(std::chrono::seconds(2));
+
+        if (maxAttempts and attempt >= *maxAttempts) {
+            LOG(log_.warn()) << "Ledger sequence " << ledgerSequence << " is not available from any configured sources"
+                             << " after " << attempt << " attempts";
+            return false;
         }
+
+        LOG(log_.info()) << "Ledger sequence " << ledgerSequence
+                         << " is not yet available from any configured sources. "
+                         << "Sleeping and trying again";
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min<std::chrono::steady_clock::duration>(backoff * 2, MAX_BACKOFF);
     }
-    return true;
+}
+
+void
+LoadBalancer::updateFreshness() const
+{
+    auto const latest = validatedLedgers_ ? validatedLedgers_->peekMostRecent() : std::nullopt;
+    for (std::size_t idx = 0; idx < sources_.size(); ++idx)
+        scheduler_.setFresh(idx, !latest || sources_[idx]->hasLedger(*latest));
 }
 
 std::optional<ETLState>
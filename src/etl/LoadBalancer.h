@@ -22,6 +22,7 @@
 #include "data/BackendInterface.h"
 #include "etl/ETLHelpers.h"
 #include "etl/ETLState.h"
+#include "etl/impl/SourceScheduler.h"
 #include "feed/SubscriptionManager.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
@@ -56,9 +57,14 @@ public:
 
 private:
     static constexpr std::uint32_t DEFAULT_DOWNLOAD_RANGES = 16;
+    static constexpr std::uint32_t MAX_DOWNLOAD_RANGES = 256;
+    static constexpr auto INITIAL_BACKOFF = std::chrono::milliseconds{250};
+    static constexpr auto MAX_BACKOFF = std::chrono::seconds{2};
 
     util::Logger log_{"ETL"};
     std::vector<std::unique_ptr<Source>> sources_;
+    std::shared_ptr<NetworkValidatedLedgers> validatedLedgers_;
+    mutable detail::SourceScheduler scheduler_;
     std::optional<ETLState> etlState_;
     std::uint32_t downloadRanges_ =
         DEFAULT_DOWNLOAD_RANGES; /*< The number of markers to use when downloading intial ledger */
@@ -124,6 +130,10 @@ public:
     /**
      * @brief Load the initial ledger, writing data to the queue.
      *
+     * The ledger is split into ranges downloaded by all healthy sources having the ledger at once. Ranges of sources
+     * that fail or stall are resumed by the other sources. This function will not return until the whole ledger was
+     * downloaded.
+     *
      * @param sequence Sequence of ledger to download
      * @param cacheOnly Whether to only write to cache and not to the DB; defaults to false
      */
@@ -134,16 +144,23 @@ public:
      * @brief Fetch data for a specific ledger.
      *
      * This function will continuously try to fetch data for the specified ledger until the fetch succeeds, the ledger
-     * is found in the database, or the server is shutting down.
+     * is found in the database, the server is shutting down or it tried maxAttempts times.
      *
      * @param ledgerSequence Sequence of the ledger to fetch
      * @param getObjects Whether to get the account state diff between this ledger and the prior one
      * @param getObjectNeighbors Whether to request object neighbors
-     * @return The extracted data, if extraction was successful. If the ledger was found in the database or the server
-     * is shutting down, the optional will be empty
+     * @param maxAttempts The number of times to try every source that has the ledger; nullopt to try until it succeeds
+     * @return The extracted data, if extraction was successful. If the ledger was found in the database, the server
+     * is shutting down, no source is configured or no source returned the ledger in maxAttempts, the optional will be
+     * empty
      */
     OptionalGetLedgerResponseType
-    fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors);
+    fetchLedger(
+        uint32_t ledgerSequence,
+        bool getObjects,
+        bool getObjectNeighbors,
+        std::optional<std::uint32_t> maxAttempts = std::nullopt
+    );
 
     /**
      * @brief Determine whether messages received on the transactions_proposed stream should be forwarded to subscribing
@@ -165,7 +182,7 @@ public:
     toJson() const;
 
     /**
-     * @brief Forward a JSON RPC request to a randomly selected rippled node.
+     * @brief Forward a JSON RPC request to a rippled node picked by the source scheduler.
      *
      * @param request JSON-RPC request to forward
      * @param clientIp The IP address of the peer, if known
@@ -188,19 +205,28 @@ public:
 
 private:
     /**
-     * @brief Execute a function on a randomly selected source.
+     * @brief Execute a function on a source picked by the source scheduler.
      *
      * @note f is a function that takes an Source as an argument and returns a bool.
-     * Attempt to execute f for one randomly chosen Source that has the specified ledger. If f returns false, another
-     * randomly chosen Source is used. The process repeats until f returns true.
+     * Attempt to execute f for one Source that has the specified ledger, picked by the scheduler. If f returns false,
+     * another Source is picked; ejected Sources are only picked once no other Source is left. Once every Source was
+     * tried, wait with an increasing backoff and start over. The process repeats until f returns true or every Source
+     * was tried maxAttempts times.
      *
      * @param f Function to execute. This function takes the ETL source as an argument, and returns a bool
      * @param ledgerSequence f is executed for each Source that has this ledger
-     * @return true if f was eventually executed successfully. false if the ledger was found in the database or the
-     * server is shutting down
+     * @param maxAttempts The number of times to try every Source; nullopt to try until f returns true
+     * @return true if f was eventually executed successfully. false if the ledger was found in the database, the
+     * server is shutting down, no Source is configured or no Source succeeded in maxAttempts
      */
     template <class Func>
     bool
-    execute(Func f, uint32_t ledgerSequence);
+    execute(Func f, uint32_t ledgerSequence, std::optional<std::uint32_t> maxAttempts = std::nullopt);
+
+    /**
+     * @brief Tell the scheduler which sources have the latest ledger validated by the network.
+     */
+    void
+    updateFreshness() const;
 };
 }  // namespace etl
@@ -130,11 +130,16 @@ ProbingSource::token() const
 }
 
 std::pair<std::vector<std::string>, bool>
-ProbingSource::loadInitialLedger(std::uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly)
+ProbingSource::loadInitialLedger(
+    std::uint32_t sequence,
+    etl::detail::InitialLoadQueue& ranges,
+    std::uint32_t maxConcurrentRanges,
+    bool cacheOnly
+)
 {
     if (!currentSrc_)
         return {{}, false};
-    return currentSrc_->loadInitialLedger(sequence, numMarkers, cacheOnly);
+    return currentSrc_->loadInitialLedger(sequence, ranges, maxConcurrentRanges, cacheOnly);
 }
 
 std::pair<grpc::Status, ProbingSource::GetLedgerResponseType>
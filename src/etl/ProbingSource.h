@@ -20,6 +20,7 @@
 #pragma once
 
 #include "etl/Source.h"
+#include "etl/impl/InitialLoadQueue.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
 
@@ -99,7 +100,12 @@ public:
     toString() const override;
 
     std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(std::uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) override;
+    loadInitialLedger(
+        std::uint32_t sequence,
+        etl::detail::InitialLoadQueue& ranges,
+        std::uint32_t maxConcurrentRanges,
+        bool cacheOnly = false
+    ) override;
 
     std::pair<grpc::Status, GetLedgerResponseType>
     fetchLedger(uint32_t sequence, bool getObjects = true, bool getObjectNeighbors = false) override;
@@ -24,6 +24,8 @@
 #include "etl/LoadBalancer.h"
 #include "etl/impl/AsyncData.h"
 #include "etl/impl/ForwardCache.h"
+#include "etl/impl/ForwardingConnectionPool.h"
+#include "etl/impl/InitialLoadQueue.h"
 #include "feed/SubscriptionManager.h"
 #include "util/Assert.h"
 #include "util/config/Config.h"
@@ -40,6 +42,7 @@
 #include <grpcpp/grpcpp.h>
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <list>
 #include <utility>
 
 namespace feed {
@@ -112,15 +115,24 @@ public:
     fetchLedger(uint32_t sequence, bool getObjects = true, bool getObjectNeighbors = false) = 0;
 
     /**
-     * @brief Download a ledger in full.
+     * @brief Download ranges of a ledger until none are left.
+     *
+     * Several sources may download the same ledger at once, sharing the ranges left to download.
      *
      * @param sequence Sequence of the ledger to download
-     * @param numMarkers Number of markers to generate for async calls
+     * @param ranges The ranges left to download
+     * @param maxConcurrentRanges Number of ranges to download at the same time
      * @param cacheOnly Only insert into cache, not the DB; defaults to false
-     * @return A std::pair of the data and a bool indicating whether the download was successfull
+     * @return A std::pair of the last keys of the downloaded ranges and a bool indicating whether the download was
+     * successfull
      */
     virtual std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) = 0;
+    loadInitialLedger(
+        uint32_t sequence,
+        etl::detail::InitialLoadQueue& ranges,
+        std::uint32_t maxConcurrentRanges,
+        bool cacheOnly = false
+    ) = 0;
 
     /**
      * @brief Forward a request to rippled.
@@ -210,7 +222,8 @@ class SourceImpl : public Source {
     std::shared_ptr<feed::SubscriptionManager> subscriptions_;
     LoadBalancer& balancer_;
 
-    etl::detail::ForwardCache forwardCache_;
+    mutable etl::detail::ForwardCache forwardCache_;
+    mutable etl::detail::ForwardingConnectionPool forwardingConnections_;
     boost::uuids::uuid uuid_{};
 
 protected:
@@ -255,7 +268,8 @@ public:
         , backend_(std::move(backend))
         , subscriptions_(std::move(subscriptions))
         , balancer_(balancer)
-        , forwardCache_(config, ioc, *this)
+        , forwardCache_(config, *this)
+        , forwardingConnections_(config)
         , strand_(boost::asio::make_strand(ioc))
         , timer_(strand_)
         , resolver_(strand_)
@@ -310,72 +324,7 @@ public:
     ) const override
     {
         LOG(log_.trace()) << "Attempting to forward request to tx. Request = " << boost::json::serialize(request);
-
-        boost::json::object response;
-
-        namespace beast = boost::beast;
-        namespace http = boost::beast::http;
-        namespace websocket = beast::websocket;
-        namespace net = boost::asio;
-        using tcp = boost::asio::ip::tcp;
-
-        try {
-            auto executor = boost::asio::get_associated_executor(yield);
-            beast::error_code ec;
-            tcp::resolver resolver{executor};
-
-            auto ws = std::make_unique<websocket::stream<beast::tcp_stream>>(executor);
-
-            auto const results = resolver.async_resolve(ip_, wsPort_, yield[ec]);
-            if (ec)
-                return {};
-
-            ws->next_layer().expires_after(std::chrono::seconds(3));
-            ws->next_layer().async_connect(results, yield[ec]);
-            if (ec)
-                return {};
-
-            // if client ip is know, change the User-Agent of the handshake and to tell rippled to charge the client
-            // IP for RPC resources. See "secure_gateway" in
-            // https://github.com/ripple/rippled/blob/develop/cfg/rippled-example.cfg
-
-            // TODO: user-agent can be clio-[version]
-            ws->set_option(websocket::stream_base::decorator([&clientIp](websocket::request_type& req) {
-                req.set(http::field::user_agent, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-client-coro");
-                if (clientIp)
-                    req.set(http::field::forwarded, "for=" + *clientIp);
-            }));
-
-            ws->async_handshake(ip_, "/", yield[ec]);
-            if (ec)
-                return {};
-
-            ws->async_write(net::buffer(boost::json::serialize(request)), yield[ec]);
-            if (ec)
-                return {};
-
-            beast::flat_buffer buffer;
-            ws->async_read(buffer, yield[ec]);
-            if (ec)
-                return {};
-
-            auto begin = static_cast<char const*>(buffer.data().data());
-            auto end = begin + buffer.data().size();
-            auto parsed = boost::json::parse(std::string(begin, end));
-
-            if (!parsed.is_object()) {
-                LOG(log_.error()) << "Error parsing response: " << std::string{begin, end};
-                return {};
-            }
-
-            response = parsed.as_object();
-            response["forwarded"] = true;
-
-            return response;
-        } catch (std::exception const& e) {
-            LOG(log_.error()) << "Encountered exception : " << e.what();
-            return {};
-        }
+        return forwardingConnections_.request(request, clientIp, yield);
     }
 
     bool
@@ -442,6 +391,7 @@ public:
         res["ip"] = ip_;
         res["ws_port"] = wsPort_;
         res["grpc_port"] = grpcPort_;
+        res["forwarding_connections"] = std::to_string(forwardingConnections_.size());
 
         auto last = getLastMsgTime();
         if (last.time_since_epoch().count() != 0) {
@@ -455,7 +405,12 @@ public:
     }
 
     std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(std::uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) override
+    loadInitialLedger(
+        std::uint32_t sequence,
+        etl::detail::InitialLoadQueue& ranges,
+        std::uint32_t maxConcurrentRanges,
+        bool cacheOnly = false
+    ) override
     {
         if (!stub_)
             return {{}, false};
@@ -463,22 +418,12 @@ public:
         grpc::CompletionQueue cq;
         void* tag = nullptr;
         bool ok = false;
-        std::vector<etl::detail::AsyncCallData> calls;
-        auto markers = getMarkers(numMarkers);
-
-        for (size_t i = 0; i < markers.size(); ++i) {
-            std::optional<ripple::uint256> nextMarker;
-
-            if (i + 1 < markers.size())
-                nextMarker = markers[i + 1];
-
-            calls.emplace_back(sequence, markers[i], nextMarker);
-        }
+        std::list<etl::detail::AsyncCallData> calls;
 
         LOG(log_.debug()) << "Starting data download for ledger " << sequence << ". Using source = " << toString();
 
-        for (auto& c : calls)
-            c.call(stub_, cq);
+        // ranges this source released because they stalled are left to other sources
+        auto const name = ip_ + ":" + grpcPort_;
 
         size_t numFinished = 0;
         bool abort = false;
@@ -486,19 +431,39 @@ public:
         size_t progress = incr;
         std::vector<std::string> edgeKeys;
 
-        while (numFinished < calls.size() && cq.Next(&tag, &ok)) {
+        while (true) {
+            // wait for ranges of other sources only when there is nothing else to do
+            while (!abort && calls.size() < maxConcurrentRanges) {
+                auto range = ranges.take(name, calls.empty());
+                if (!range)
+                    break;
+
+                calls.emplace_back(sequence, std::move(*range)).call(stub_, cq);
+            }
+
+            if (calls.empty() || !cq.Next(&tag, &ok))
+                break;
+
             ASSERT(tag != nullptr, "Tag can't be null.");
             auto ptr = static_cast<etl::detail::AsyncCallData*>(tag);
+            auto const done = [&calls, ptr]() {
+                calls.remove_if([ptr](auto const& entry) { return &entry == ptr; });
+            };
 
             if (!ok) {
                 LOG(log_.error()) << "loadInitialLedger - ok is false";
-                return {{}, false};  // handle cancelled
+                abort = true;
+                ranges.giveBack(ptr->getRemaining());
+                done();
+                continue;
             }
 
             LOG(log_.trace()) << "Marker prefix = " << ptr->getMarkerPrefix();
 
-            auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly);
-            if (result != etl::detail::AsyncCallData::CallStatus::MORE) {
+            auto const release = ranges.shouldRelease(ptr->getRangeId());
+            auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly, release);
+
+            if (result == etl::detail::AsyncCallData::CallStatus::DONE) {
                 ++numFinished;
                 LOG(log_.debug()) << "Finished a marker. "
                                   << "Current number of finished = " << numFinished;
@@ -507,10 +472,20 @@ public:
 
                 if (!lastKey.empty())
                     edgeKeys.push_back(ptr->getLastKey());
-            }
 
-            if (result == etl::detail::AsyncCallData::CallStatus::ERRORED)
+                ranges.finish(ptr->getRangeId());
+                done();
+            } else if (result == etl::detail::AsyncCallData::CallStatus::ERRORED) {
                 abort = true;
+                ranges.giveBack(ptr->getRemaining());
+                done();
+            } else if (release) {
+                LOG(log_.info()) << "Giving a stalled range to another source. source = " << toString();
+                ranges.release(ptr->getRemaining(), name);
+                done();
+            } else {
+                ranges.progress(ptr->getRangeId());
+            }
 
             if (backend_->cache().size() > progress) {
                 LOG(log_.info()) << "Downloaded " << backend_->cache().size() << " records from rippled";
@@ -518,7 +493,8 @@ public:
             }
         }
 
-        LOG(log_.info()) << "Finished loadInitialLedger. cache size = " << backend_->cache().size();
+        LOG(log_.info()) << "Finished loadInitialLedger. ranges downloaded = " << numFinished
+                         << " cache size = " << backend_->cache().size() << " source = " << toString();
         return {std::move(edgeKeys), !abort};
     }
 
@@ -529,12 +505,7 @@ public:
         boost::asio::yield_context yield
     ) const override
     {
-        if (auto resp = forwardCache_.get(request); resp) {
-            LOG(log_.debug()) << "request hit forwardCache";
-            return resp;
-        }
-
-        return requestFromRippled(request, clientIp, yield);
+        return forwardCache_.get(request, clientIp, yield);
     }
 
     void
@@ -686,7 +657,6 @@ public:
             } else {
                 if (balancer_.shouldPropagateTxnStream(this)) {
                     if (response.contains("transaction")) {
-                        forwardCache_.freshen();
                         subscriptions_->forwardProposedTransaction(response);
                     } else if (response.contains("type") && response.at("type") == "validationReceived") {
                         subscriptions_->forwardValidation(response);
@@ -699,6 +669,7 @@ public:
             if (ledgerIndex != 0) {
                 LOG(log_.trace()) << "Pushing ledger sequence = " << ledgerIndex << " - " << toString();
                 networkValidatedLedgers_->push(ledgerIndex);
+                forwardCache_.onLedgerClosed(ledgerIndex);
             }
 
             return true;
@@ -21,15 +21,22 @@
 
 #include "data/BackendInterface.h"
 #include "etl/NFTHelpers.h"
+#include "etl/impl/InitialLoadQueue.h"
 #include "util/Assert.h"
 #include "util/log/Logger.h"
 
 #include <grpcpp/grpcpp.h>
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <chrono>
+#include <optional>
+
 namespace etl::detail {
 
 class AsyncCallData {
+    // a page not received by then is retried, possibly by another source
+    static constexpr auto PAGE_TIMEOUT = std::chrono::minutes{2};
+
     util::Logger log_{"ETL"};
 
     std::unique_ptr<org::xrpl::rpc::v1::GetLedgerDataResponse> cur_;
@@ -41,19 +48,23 @@ class AsyncCallData {
     grpc::Status status_;
     unsigned char nextPrefix_;
 
+    std::size_t rangeId_;
+    std::optional<ripple::uint256> end_;
     std::string lastKey_;
 
 public:
-    AsyncCallData(uint32_t seq, ripple::uint256 const& marker, std::optional<ripple::uint256> const& nextMarker)
+    AsyncCallData(uint32_t seq, InitialLoadQueue::Range range)
+        : rangeId_(range.id), end_(range.end), lastKey_(std::move(range.lastKey))
     {
+        auto const& marker = range.marker;
         request_.mutable_ledger()->set_sequence(seq);
         if (marker.isNonZero()) {
             request_.set_marker(marker.data(), ripple::uint256::size());
         }
         request_.set_user("ETL");
         nextPrefix_ = 0x00;
-        if (nextMarker)
-            nextPrefix_ = nextMarker->data()[0];
+        if (end_)
+            nextPrefix_ = end_->data()[0];
 
         unsigned char const prefix = marker.data()[0];
 
@@ -81,7 +92,8 @@ public:
         grpc::CompletionQueue& cq,
         BackendInterface& backend,
         bool abort,
-        bool cacheOnly = false
+        bool cacheOnly = false,
+        bool release = false
     )
     {
         LOG(log_.trace()) << "Processing response. "
@@ -113,10 +125,11 @@ public:
         if (nextPrefix_ != 0x00 && prefix >= nextPrefix_)
             more = false;
 
-        // if we are not done, make the next async call
+        // if we are not done, make the next async call unless the rest of the range is given to another source
         if (more) {
             request_.set_marker(cur_->marker());
-            call(stub, cq);
+            if (!release)
+                call(stub, cq);
         }
 
         auto const numObjects = cur_->ledger_objects().objects_size();
@@ -154,6 +167,7 @@ public:
     call(std::unique_ptr<org::xrpl::rpc::v1::XRPLedgerAPIService::Stub>& stub, grpc::CompletionQueue& cq)
     {
         context_ = std::make_unique<grpc::ClientContext>();
+        context_->set_deadline(std::chrono::system_clock::now() + PAGE_TIMEOUT);
 
         std::unique_ptr<grpc::ClientAsyncResponseReader<org::xrpl::rpc::v1::GetLedgerDataResponse>> rpc(
             stub->PrepareAsyncGetLedgerData(context_.get(), request_, &cq)
@@ -178,6 +192,23 @@ public:
     {
         return lastKey_;
     }
+
+    std::size_t
+    getRangeId() const
+    {
+        return rangeId_;
+    }
+
+    /** @return The part of the range not written yet */
+    InitialLoadQueue::Range
+    getRemaining() const
+    {
+        ripple::uint256 marker;
+        if (request_.marker().size() == ripple::uint256::size())
+            marker = ripple::uint256::fromVoid(request_.marker().data());
+
+        return {.id = rangeId_, .marker = marker, .end = end_, .lastKey = lastKey_};
+    }
 };
 
 }  // namespace etl::detail
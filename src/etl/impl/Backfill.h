@@ -0,0 +1,547 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/BackendInterface.h"
+#include "data/DBHelpers.h"
+#include "etl/ETLHelpers.h"
+#include "etl/NFTHelpers.h"
+#include "etl/SystemState.h"
+#include "util/LedgerUtils.h"
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/json/object.hpp>
+#include <ripple/basics/Slice.h>
+#include <ripple/basics/StringUtilities.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/strHex.h>
+#include <ripple/beast/core/CurrentThreadName.h>
+#include <ripple/protocol/LedgerHeader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief Fills in the ledgers older than the oldest one in the database, next to the live ETL.
+ *
+ * The range from the configured start sequence up to the current minimum is split into chunks that are fetched from
+ * the ETL sources and written by several workers at once. The state of the ledger just before the start is downloaded
+ * in key ranges first, so that the objects and successors of the backfilled ledgers have something to build on.
+ *
+ * A ledger header is written only after everything else of that ledger is in the database, so the headers double as
+ * progress markers: an interrupted backfill resumes each chunk at its first missing header. A ledger that no source
+ * returns within a few attempts fails its chunk, so that a stop is never held up by the sources.
+ *
+ * The ledger range of the live backend is extended downwards only once all ledgers down to the start are in place.
+ * Read-only instances pick up the new minimum when they publish their next ledger. Writes are never finished as for a
+ * new ledger, so the range of ledgers complete in account_tx_inline stays with the live ETL at the tip.
+ *
+ * @tparam LoadBalancerType The type of the load balancer to fetch ledgers with
+ * @tparam LedgerLoaderType The type of the ledger loader to write transactions with
+ */
+template <typename LoadBalancerType, typename LedgerLoaderType>
+class Backfill {
+public:
+    using GetLedgerResponseType = typename LedgerLoaderType::GetLedgerResponseType;
+    using RawLedgerObjectType = typename LedgerLoaderType::RawLedgerObjectType;
+
+    static constexpr std::uint32_t DEFAULT_CHUNK_SIZE = 10'000;
+    static constexpr std::size_t DEFAULT_NUM_WORKERS = 2;
+    static constexpr std::size_t DEFAULT_NUM_STATE_RANGES = 16;
+
+private:
+    static constexpr std::uint32_t STATE_PAGE_SIZE = 2048;
+    static constexpr std::size_t HEADER_BATCH_SIZE = 64;
+    static constexpr std::size_t HEADER_READ_SIZE = 256;
+    static constexpr auto RETRY_DELAY = std::chrono::seconds{1};
+    static constexpr std::uint32_t FETCH_ATTEMPTS = 5;
+
+    /** @brief A key range of the state before the start, or a chunk of ledgers */
+    struct Task {
+        std::optional<std::size_t> stateRange;
+        std::uint32_t firstSequence = 0;
+        std::uint32_t lastSequence = 0;
+    };
+
+    /** @brief The first and last keys downloaded in a key range, to link the successors across ranges */
+    struct RangeEdges {
+        std::optional<ripple::uint256> first;
+        std::optional<ripple::uint256> last;
+    };
+
+    util::Logger log_{"ETL"};
+
+    std::shared_ptr<BackendInterface> backend_;
+    std::shared_ptr<BackendInterface> liveBackend_;
+    std::shared_ptr<LoadBalancerType> loadBalancer_;
+    std::reference_wrapper<LedgerLoaderType> loader_;
+    std::reference_wrapper<SystemState const> state_;
+
+    std::uint32_t startSequence_;
+    std::uint32_t chunkSize_;
+    std::size_t numWorkers_;
+    std::vector<ripple::uint256> stateMarkers_;
+
+    std::mutex mtx_;
+    std::vector<Task> tasks_;
+    std::size_t nextTask_ = 0;
+    std::vector<RangeEdges> stateEdges_;
+    bool failed_ = false;
+
+    std::atomic_bool stopping_ = false;
+    std::thread thread_;
+
+public:
+    /**
+     * @brief Create an instance of the backfill.
+     *
+     * @param config The "backfill" section of the config
+     * @param backend The backend to write the backfilled ledgers with; should not be the one of the live ETL
+     * @param liveBackend The backend of the live ETL, whose ledger range is extended when done
+     * @param loadBalancer The load balancer to fetch ledgers with
+     * @param loader The ledger loader to write transactions with; must write to @p backend
+     * @param state The state of the ETL
+     */
+    Backfill(
+        util::Config const& config,
+        std::shared_ptr<BackendInterface> backend,
+        std::shared_ptr<BackendInterface> liveBackend,
+        std::shared_ptr<LoadBalancerType> loadBalancer,
+        LedgerLoaderType& loader,
+        SystemState const& state
+    )
+        : backend_{std::move(backend)}
+        , liveBackend_{std::move(liveBackend)}
+        , loadBalancer_{std::move(loadBalancer)}
+        , loader_{std::ref(loader)}
+        , state_{std::cref(state)}
+        , startSequence_{config.valueOrThrow<std::uint32_t>("start_sequence", "Backfill needs a start_sequence")}
+        , chunkSize_{std::max(config.valueOr("chunk_size", DEFAULT_CHUNK_SIZE), 1u)}
+        , numWorkers_{std::max<std::size_t>(config.valueOr("workers", DEFAULT_NUM_WORKERS), 1)}
+        , stateMarkers_{
+              getMarkers(std::clamp<std::size_t>(config.valueOr("state_ranges", DEFAULT_NUM_STATE_RANGES), 1, 256))
+          }
+    {
+        if (startSequence_ < 2)
+            throw std::runtime_error("Backfill start_sequence must be greater than 1");
+    }
+
+    ~Backfill()
+    {
+        stop();
+    }
+
+    Backfill(Backfill const&) = delete;
+    Backfill&
+    operator=(Backfill const&) = delete;
+
+    /**
+     * @brief Run the backfill on a thread of its own.
+     */
+    void
+    start()
+    {
+        thread_ = std::thread([this]() {
+            beast::setCurrentThreadName("ETLService backfill");
+            run();
+        });
+    }
+
+    /**
+     * @brief Stop the backfill and wait for it; what was written so far is picked up by the next run.
+     */
+    void
+    stop()
+    {
+        stopping_ = true;
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    /**
+     * @brief Backfill the ledgers from the start sequence up to the oldest one in the database.
+     *
+     * @return true if the ledger range of the live backend was extended down to the start sequence; false otherwise
+     */
+    bool
+    run()
+    {
+        auto const range = liveBackend_->hardFetchLedgerRangeNoThrow();
+        if (not range) {
+            LOG(log_.warn()) << "Nothing to backfill before the database is populated";
+            return false;
+        }
+
+        if (range->minSequence <= startSequence_) {
+            LOG(log_.info()) << "Database already has ledgers back to " << range->minSequence << ", no backfill needed";
+            return false;
+        }
+
+        // created before the database was populated, the backfill backend would not know to write ledger diffs
+        if (not backend_->fetchLedgerRange())
+            backend_->setRange(range->minSequence, range->maxSequence);
+
+        auto const lastSequence = range->minSequence - 1;
+        LOG(log_.info()) << "Backfilling ledgers " << startSequence_ << " to " << lastSequence << " in chunks of "
+                         << chunkSize_ << " using " << numWorkers_ << " workers";
+
+        plan(lastSequence);
+
+        std::vector<std::thread> workers;
+        workers.reserve(numWorkers_);
+        for (std::size_t i = 0; i < numWorkers_; ++i)
+            workers.emplace_back([this]() { work(); });
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (failed_ or isStopping()) {
+            LOG(log_.warn()) << "Backfill did not finish; it resumes where it stopped on the next start";
+            return false;
+        }
+
+        if (not stateEdges_.empty() and not finishState())
+            return false;
+
+        backend_->waitForWrites();
+        if (not liveBackend_->extendRangeDown(startSequence_))
+            return false;
+
+        LOG(log_.info()) << "Backfill done, database now starts at ledger " << startSequence_;
+        return true;
+    }
+
+private:
+    bool
+    isStopping() const
+    {
+        return stopping_ or state_.get().isStopping;
+    }
+
+    void
+    plan(std::uint32_t lastSequence)
+    {
+        // the header of the ledger before the start is written once its whole state is in
+        if (firstMissingHeader(startSequence_ - 1, startSequence_ - 1)) {
+            for (std::size_t i = 0; i < stateMarkers_.size(); ++i)
+                tasks_.push_back({.stateRange = i, .firstSequence = 0, .lastSequence = 0});
+
+            stateEdges_.assign(stateMarkers_.size(), {});
+        }
+
+        for (std::uint64_t first = startSequence_; first <= lastSequence; first += chunkSize_) {
+            auto const chunkFirst = static_cast<std::uint32_t>(first);
+            auto const chunkLast =
+                static_cast<std::uint32_t>(std::min<std::uint64_t>(lastSequence, first + chunkSize_ - 1));
+
+            if (auto const resumeAt = firstMissingHeader(chunkFirst, chunkLast); resumeAt) {
+                tasks_.push_back({.stateRange = std::nullopt, .firstSequence = *resumeAt, .lastSequence = chunkLast});
+            } else {
+                LOG(log_.debug()) << "Ledgers " << chunkFirst << " to " << chunkLast << " are already backfilled";
+            }
+        }
+    }
+
+    std::optional<std::uint32_t>
+    firstMissingHeader(std::uint32_t first, std::uint32_t last) const
+    {
+        std::vector<std::uint32_t> sequences;
+        for (std::uint64_t seq = first; seq <= last; ++seq) {
+            sequences.push_back(static_cast<std::uint32_t>(seq));
+            if (sequences.size() < HEADER_READ_SIZE and seq < last)
+                continue;
+
+            auto const headers = data::synchronousAndRetryOnTimeout([&](auto yield) {
+                return backend_->fetchLedgerHeaders(sequences, yield);
+            });
+
+            for (std::size_t i = 0; i < headers.size(); ++i) {
+                if (not headers[i])
+                    return sequences[i];
+            }
+
+            sequences.clear();
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<Task>
+    nextTask()
+    {
+        std::scoped_lock const lck{mtx_};
+        if (failed_ or nextTask_ >= tasks_.size())
+            return std::nullopt;
+
+        return tasks_[nextTask_++];
+    }
+
+    void
+    work()
+    {
+        while (auto const task = nextTask()) {
+            bool done = false;
+            try {
+                done = task->stateRange ? loadStateRange(*task->stateRange)
+                                        : loadLedgers(task->firstSequence, task->lastSequence);
+            } catch (std::exception const& e) {
+                LOG(log_.error()) << "Backfill failed: " << e.what();
+            }
+
+            if (not done) {
+                std::scoped_lock const lck{mtx_};
+                failed_ = true;
+                return;
+            }
+        }
+    }
+
+    bool
+    loadStateRange(std::size_t index)
+    {
+        auto const sequence = startSequence_ - 1;
+        auto const end =
+            index + 1 < stateMarkers_.size() ? std::make_optional(stateMarkers_[index + 1]) : std::nullopt;
+
+        std::optional<std::string> marker;
+        if (index > 0)
+            marker = ripple::strHex(stateMarkers_[index]);
+
+        RangeEdges edges;
+        auto prev = stateMarkers_[index];
+        std::size_t numObjects = 0;
+
+        while (not isStopping()) {
+            boost::json::object request = {
+                {"command", "ledger_data"},
+                {"ledger_index", sequence},
+                {"binary", true},
+                {"limit", STATE_PAGE_SIZE},
+            };
+            if (marker)
+                request["marker"] = *marker;
+
+            auto const response = data::synchronous([&](auto yield) {
+                return loadBalancer_->forwardToRippled(request, std::nullopt, yield);
+            });
+
+            boost::json::object const* result = nullptr;
+            if (response)
+                result = response->contains("result") ? response->at("result").if_object() : &*response;
+
+            if (result == nullptr or result->contains("error") or not result->contains("state")) {
+                LOG(log_.warn()) << "Could not download the state of ledger " << sequence << ", retrying";
+                std::this_thread::sleep_for(RETRY_DELAY);
+                continue;
+            }
+
+            std::vector<NFTsData> nfts;
+            for (auto const& item : result->at("state").as_array()) {
+                auto const& entry = item.as_object();
+
+                ripple::uint256 key;
+                if (not key.parseHex(entry.at("index").as_string()))
+                    throw std::runtime_error("Invalid key in the state of ledger " + std::to_string(sequence));
+
+                if (end and key > *end)
+                    return finishStateRange(index, edges, numObjects);
+
+                auto const blob = ripple::strUnHex(std::string{entry.at("data").as_string()});
+                if (not blob)
+                    throw std::runtime_error("Invalid object in the state of ledger " + std::to_string(sequence));
+
+                std::string object{blob->begin(), blob->end()};
+                auto keyString = uint256ToString(key);
+
+                // the first directory of a book is the successor of the book base
+                if (isBookDir(key, object)) {
+                    auto const base = getBookBase(key);
+                    if (prev <= base and base != key)
+                        backend_->writeSuccessor(uint256ToString(base), sequence, std::string{keyString});
+                }
+
+                if (edges.last) {
+                    backend_->writeSuccessor(uint256ToString(*edges.last), sequence, std::string{keyString});
+                } else {
+                    edges.first = key;
+                }
+
+                auto objectNfts = getNFTDataFromObj(sequence, keyString, object);
+                nfts.insert(nfts.end(), objectNfts.begin(), objectNfts.end());
+
+                backend_->writeLedgerObject(std::move(keyString), sequence, std::move(object));
+                prev = key;
+                edges.last = key;
+                ++numObjects;
+            }
+
+            if (not nfts.empty())
+                backend_->writeNFTs(nfts);
+
+            if (not result->contains("marker"))
+                return finishStateRange(index, edges, numObjects);
+
+            marker = std::string{result->at("marker").as_string()};
+        }
+
+        return false;
+    }
+
+    bool
+    finishStateRange(std::size_t index, RangeEdges const& edges, std::size_t numObjects)
+    {
+        LOG(log_.info()) << "Downloaded key range " << index << " of the state before the backfill: " << numObjects
+                         << " objects";
+
+        std::scoped_lock const lck{mtx_};
+        stateEdges_[index] = edges;
+        return true;
+    }
+
+    bool
+    finishState()
+    {
+        auto const sequence = startSequence_ - 1;
+
+        auto prev = data::firstKey;
+        for (auto const& edges : stateEdges_) {
+            if (not edges.first)
+                continue;
+
+            backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(*edges.first));
+            prev = *edges.last;
+        }
+        backend_->writeSuccessor(uint256ToString(prev), sequence, uint256ToString(data::lastKey));
+
+        auto response = loadBalancer_->fetchLedger(sequence, false, false, FETCH_ATTEMPTS);
+        if (not response) {
+            LOG(log_.warn()) << "Could not fetch ledger " << sequence << " from any source";
+            return false;
+        }
+
+        auto const header = ::util::deserializeHeader(ripple::makeSlice(response->ledger_header()));
+
+        backend_->waitForWrites();
+        backend_->writeLedger(header, std::move(*response->mutable_ledger_header()));
+        return true;
+    }
+
+    bool
+    loadLedgers(std::uint32_t first, std::uint32_t last)
+    {
+        LOG(log_.info()) << "Backfilling ledgers " << first << " to " << last;
+
+        std::vector<std::pair<ripple::LedgerHeader, std::string>> headers;
+        for (std::uint64_t seq = first; seq <= last; ++seq) {
+            if (isStopping())
+                return false;
+
+            auto rawData = loadBalancer_->fetchLedger(static_cast<std::uint32_t>(seq), true, true, FETCH_ATTEMPTS);
+            if (not rawData) {
+                LOG(log_.warn()) << "Could not fetch ledger " << seq << " from any source";
+                return false;
+            }
+
+            if (not rawData->object_neighbors_included()) {
+                throw std::runtime_error(
+                    "ETL source did not include object neighbors for ledger " + std::to_string(seq)
+                );
+            }
+
+            auto const header = ::util::deserializeHeader(ripple::makeSlice(rawData->ledger_header()));
+            writeSuccessors(header.seq, *rawData);
+
+            for (auto& obj : *(rawData->mutable_ledger_objects()->mutable_objects()))
+                backend_->writeLedgerObject(std::move(*obj.mutable_key()), header.seq, std::move(*obj.mutable_data()));
+
+            auto transactions = loader_.get().insertTransactions(header, *rawData);
+            backend_->writeAccountTransactions(std::move(transactions.accountTxData));
+            backend_->writeNFTs(transactions.nfTokensData);
+            backend_->writeNFTTransactions(transactions.nfTokenTxData);
+
+            headers.emplace_back(header, std::move(*rawData->mutable_ledger_header()));
+            if (headers.size() >= HEADER_BATCH_SIZE or seq == last)
+                writeHeaders(headers);
+        }
+
+        return true;
+    }
+
+    void
+    writeSuccessors(std::uint32_t seq, GetLedgerResponseType& rawData)
+    {
+        for (auto& obj : *(rawData.mutable_book_successors())) {
+            auto firstBook = std::move(*obj.mutable_first_book());
+            if (firstBook.empty())
+                firstBook = uint256ToString(data::lastKey);
+
+            backend_->writeSuccessor(std::move(*obj.mutable_book_base()), seq, std::move(firstBook));
+        }
+
+        for (auto& obj : *(rawData.mutable_ledger_objects()->mutable_objects())) {
+            if (obj.mod_type() == RawLedgerObjectType::MODIFIED)
+                continue;
+
+            auto pred = std::move(*obj.mutable_predecessor());
+            if (pred.empty())
+                pred = uint256ToString(data::firstKey);
+
+            auto succ = std::move(*obj.mutable_successor());
+            if (succ.empty())
+                succ = uint256ToString(data::lastKey);
+
+            if (obj.mod_type() == RawLedgerObjectType::DELETED) {
+                backend_->writeSuccessor(std::move(pred), seq, std::move(succ));
+            } else {
+                backend_->writeSuccessor(std::move(pred), seq, std::string{obj.key()});
+                backend_->writeSuccessor(std::string{obj.key()}, seq, std::move(succ));
+            }
+        }
+    }
+
+    void
+    writeHeaders(std::vector<std::pair<ripple::LedgerHeader, std::string>>& headers)
+    {
+        // the data of these ledgers must be in the database before their headers mark them as done
+        backend_->waitForWrites();
+        for (auto& [header, blob] : headers)
+            backend_->writeLedger(header, std::move(blob));
+
+        headers.clear();
+    }
+};
+
+}  // namespace etl::detail
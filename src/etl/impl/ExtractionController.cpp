@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ExtractionController.h"
+
+#include "util/log/Logger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace etl::detail {
+
+ExtractionController::ExtractionController(std::uint32_t initialLimit, std::uint32_t maxLimit)
+    : maxLimit_(std::max(maxLimit, MIN_LIMIT)), limit_(std::clamp(initialLimit, MIN_LIMIT, maxLimit_))
+{
+}
+
+bool
+ExtractionController::acquire(std::uint32_t sequence)
+{
+    std::unique_lock lck{mtx_};
+    waiting_.insert(sequence);
+
+    cv_.wait(lck, [this, sequence]() {
+        return stopped_ or (inFlight_ < limit_ and *waiting_.begin() == sequence);
+    });
+
+    waiting_.erase(sequence);
+    if (stopped_)
+        return false;
+
+    ++inFlight_;
+
+    // the next waiting ledger may fit in the limit as well
+    cv_.notify_all();
+    return true;
+}
+
+void
+ExtractionController::release()
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        --inFlight_;
+    }
+    cv_.notify_all();
+}
+
+void
+ExtractionController::onConsumed(bool starved, std::uint32_t backlog)
+{
+    std::scoped_lock const lck{mtx_};
+    auto const previous = limit_;
+
+    // grow only if the limit is what held the fetches back rather than e.g. waiting for the network to validate
+    if (starved and inFlight_ >= limit_ and limit_ < maxLimit_) {
+        ++limit_;
+        cv_.notify_all();
+    } else if (not starved and backlog > BACKLOG_FACTOR * limit_ and limit_ > MIN_LIMIT) {
+        --limit_;
+    }
+
+    if (limit_ != previous)
+        LOG(log_.debug()) << "Extraction limit changed from " << previous << " to " << limit_
+                          << "; backlog = " << backlog;
+}
+
+void
+ExtractionController::stop()
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        stopped_ = true;
+    }
+    cv_.notify_all();
+}
+
+std::uint32_t
+ExtractionController::limit() const
+{
+    std::scoped_lock const lck{mtx_};
+    return limit_;
+}
+
+std::uint32_t
+ExtractionController::inFlight() const
+{
+    std::scoped_lock const lck{mtx_};
+    return inFlight_;
+}
+
+}  // namespace etl::detail
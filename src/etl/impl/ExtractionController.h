@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/log/Logger.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <set>
+
+namespace etl::detail {
+
+/**
+ * @brief Limits how many ledgers the extractors fetch at once while the ETL pipeline catches up.
+ *
+ * Fetches are granted in ledger order so the ledger the transformer needs next is never held back by later ones. The
+ * limit grows while the transformer waits for ledgers that are still being fetched and shrinks while extracted ledgers
+ * pile up because writing them is slower than fetching them.
+ */
+class ExtractionController {
+public:
+    static constexpr std::uint32_t MIN_LIMIT = 1;
+
+private:
+    // the limit shrinks once more ledgers are waiting to be written than this many times the limit
+    static constexpr std::uint32_t BACKLOG_FACTOR = 2;
+
+    util::Logger log_{"ETL"};
+
+    std::uint32_t maxLimit_;
+    std::uint32_t limit_;
+    std::uint32_t inFlight_ = 0;
+    bool stopped_ = false;
+    std::set<std::uint32_t> waiting_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+
+public:
+    /**
+     * @brief Construct a new controller.
+     *
+     * @param initialLimit The ledgers fetched at once to start with
+     * @param maxLimit The most ledgers fetched at once; usually the number of extractors
+     */
+    ExtractionController(std::uint32_t initialLimit, std::uint32_t maxLimit);
+
+    /**
+     * @brief Wait until the given ledger may be fetched.
+     *
+     * @param sequence The sequence of the ledger to fetch
+     * @return true if the ledger may be fetched and release must be called afterwards; false if the controller stopped
+     */
+    bool
+    acquire(std::uint32_t sequence);
+
+    /**
+     * @brief Record that a fetch allowed by acquire is over.
+     */
+    void
+    release();
+
+    /**
+     * @brief Adjust the limit after the transformer took the next ledger.
+     *
+     * @param starved Whether the ledger was not extracted yet when the transformer asked for it
+     * @param backlog The number of extracted ledgers still waiting for the transformer
+     */
+    void
+    onConsumed(bool starved, std::uint32_t backlog);
+
+    /**
+     * @brief Stop granting fetches and wake up all waiting extractors.
+     */
+    void
+    stop();
+
+    /**
+     * @return The current limit of ledgers fetched at once
+     */
+    std::uint32_t
+    limit() const;
+
+    /**
+     * @return The number of ledgers being fetched
+     */
+    std::uint32_t
+    inFlight() const;
+};
+
+}  // namespace etl::detail
@@ -20,15 +20,22 @@
 #pragma once
 
 #include "etl/ETLHelpers.h"
+#include "etl/impl/ExtractionController.h"
 #include "util/log/Logger.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 namespace etl::detail {
 
 /**
  * @brief A collection of thread safe async queues used by Extractor and Transformer to communicate
+ *
+ * The pipe also decides how many ledgers the extractors fetch at once, see ExtractionController.
  */
 template <typename RawDataType>
 class ExtractionDataPipe {
@@ -46,14 +53,22 @@ private:
 
     std::vector<std::shared_ptr<QueueType>> queues_;
 
+    ExtractionController controller_;
+
+    std::mutex readyMtx_;
+    std::vector<std::uint32_t> ready_;  // extracted but not yet taken entries per queue
+    std::uint32_t backlog_ = 0;
+
 public:
     /**
      * @brief Create a new instance of the extraction data pipe
      *
-     * @param stride
+     * @param stride The number of extractors, which is also the most ledgers fetched at once
      * @param startSequence
+     * @param initialLimit The ledgers fetched at once to start with; the limit then follows the pipeline up to stride
      */
-    ExtractionDataPipe(uint32_t stride, uint32_t startSequence) : stride_{stride}, startSequence_{startSequence}
+    ExtractionDataPipe(uint32_t stride, uint32_t startSequence, uint32_t initialLimit)
+        : stride_{stride}, startSequence_{startSequence}, controller_{initialLimit, stride}, ready_(stride, 0u)
     {
         auto const maxQueueSize = TOTAL_MAX_IN_QUEUE / stride;
         for (size_t i = 0; i < stride_; ++i)
@@ -71,6 +86,11 @@ public:
     void
     push(uint32_t sequence, DataType&& data)
     {
+        {
+            std::scoped_lock const lck{readyMtx_};
+            ++ready_[getIndex(sequence)];
+            ++backlog_;
+        }
         getQueue(sequence)->push(std::move(data));
     }
 
@@ -85,7 +105,40 @@ public:
     DataType
     popNext(uint32_t sequence)
     {
-        return getQueue(sequence)->pop();
+        auto const [starved, backlog] = [this, sequence]() {
+            std::scoped_lock const lck{readyMtx_};
+            return std::make_pair(ready_[getIndex(sequence)] == 0, backlog_);
+        }();
+        controller_.onConsumed(starved, backlog);
+
+        auto data = getQueue(sequence)->pop();
+
+        std::scoped_lock const lck{readyMtx_};
+        --ready_[getIndex(sequence)];
+        --backlog_;
+        return data;
+    }
+
+    /**
+     * @brief Wait until the ledger with the given sequence may be fetched.
+     *
+     * @param sequence The sequence of the ledger to fetch
+     * @return true if the ledger may be fetched, release must be called once it's fetched; false if the pipe is being
+     * cleaned up
+     */
+    bool
+    acquire(uint32_t sequence)
+    {
+        return controller_.acquire(sequence);
+    }
+
+    /**
+     * @brief Record that fetching a ledger allowed by acquire is over.
+     */
+    void
+    release()
+    {
+        controller_.release();
     }
 
     /**
@@ -117,6 +170,7 @@ public:
     cleanup()
     {
         // TODO: this should not have to be called by hand. it should be done via RAII
+        controller_.stop();
         for (auto i = 0u; i < stride_; ++i)
             getQueue(i)->tryPop();  // pop from each queue that might be blocked on a push
     }
@@ -126,7 +180,13 @@ private:
     getQueue(uint32_t sequence)
     {
         LOG(log_.debug()) << "Grabbing extraction queue for " << sequence << "; start was " << startSequence_;
-        return queues_[(sequence - startSequence_) % stride_];
+        return queues_[getIndex(sequence)];
+    }
+
+    std::size_t
+    getIndex(uint32_t sequence) const
+    {
+        return (sequence - startSequence_) % stride_;
     }
 };
 
@@ -35,6 +35,8 @@ namespace etl::detail {
 
 /**
  * @brief Extractor thread that is fetching GRPC data and enqueue it on the DataPipeType
+ *
+ * Each fetch is allowed by the DataPipeType first, which limits how many extractors fetch at once.
  */
 template <typename DataPipeType, typename NetworkValidatedLedgersType, typename LedgerFetcherType>
 class Extractor {
@@ -92,9 +94,14 @@ private:
 
         while (!shouldFinish(currentSequence) && networkValidatedLedgers_->waitUntilValidatedByNetwork(currentSequence)
         ) {
+            // wait for the pipe to allow one more ledger to be fetched; false means the pipe is being cleaned up
+            if (!pipe_.get().acquire(currentSequence))
+                break;
+
             auto [fetchResponse, time] = ::util::timed<std::chrono::duration<double>>([this, currentSequence]() {
                 return ledgerFetcher_.get().fetchDataAndDiff(currentSequence);
             });
+            pipe_.get().release();
             totalTime += time;
 
             // if the fetch is unsuccessful, stop. fetchLedger only returns false if the server is shutting down, or
@@ -20,57 +20,223 @@
 #include "etl/impl/ForwardCache.h"
 
 #include "etl/Source.h"
-#include "rpc/RPCHelpers.h"
+#include "util/config/Config.h"
 #include "util/log/Logger.h"
+#include "util/prometheus/Label.h"
+#include "util/prometheus/Prometheus.h"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
 
-#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <shared_mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace etl::detail {
 
+namespace {
+
+void
+appendNormalized(boost::json::value const& value, std::string& out);
+
+// Members are written sorted by key so that requests differing only in the order of their parameters share the key
 void
-ForwardCache::freshen()
+appendNormalized(boost::json::object const& object, std::string& out, bool skipRequestFields = false)
+{
+    std::vector<boost::json::key_value_pair const*> members;
+    for (auto const& member : object) {
+        auto const key = member.key();
+        if (not skipRequestFields or (key != "id" and key != "command" and key != "method"))
+            members.push_back(&member);
+    }
+
+    std::sort(members.begin(), members.end(), [](auto const* lhs, auto const* rhs) { return lhs->key() < rhs->key(); });
+
+    out += '{';
+    for (auto const* member : members) {
+        if (out.back() != '{')
+            out += ',';
+        out += boost::json::serialize(boost::json::value(member->key()));
+        out += ':';
+        appendNormalized(member->value(), out);
+    }
+    out += '}';
+}
+
+void
+appendNormalized(boost::json::value const& value, std::string& out)
+{
+    if (value.is_object()) {
+        appendNormalized(value.as_object(), out);
+    } else if (value.is_array()) {
+        out += '[';
+        for (auto const& element : value.as_array()) {
+            if (out.back() != '[')
+                out += ',';
+            appendNormalized(element, out);
+        }
+        out += ']';
+    } else {
+        out += boost::json::serialize(value);
+    }
+}
+
+// A shared response carries the id of the request it was fetched for
+boost::json::object
+withIdOf(boost::json::object response, boost::json::object const& request)
+{
+    if (auto const it = request.find("id"); it != request.end()) {
+        response["id"] = it->value();
+    } else {
+        response.erase("id");
+    }
+
+    return response;
+}
+
+}  // namespace
+
+ForwardCache::ForwardCache(util::Config const& config, Source const& source)
+    : source_(source)
+    , maxSize_(config.valueOr<std::size_t>("cache_max_size_mb", DEFAULT_MAX_SIZE_MB) * 1024 * 1024)
+    , hitCounter_(PrometheusService::counterInt(
+          "forward_cache_counter_total_number",
+          util::prometheus::Labels({{"result", "hit"}}),
+          "The number of forwarded requests answered from the cache"
+      ))
+    , coalescedCounter_(PrometheusService::counterInt(
+          "forward_cache_counter_total_number",
+          util::prometheus::Labels({{"result", "coalesced"}}),
+          "The number of forwarded requests that waited for the response to an identical request"
+      ))
+    , missCounter_(PrometheusService::counterInt(
+          "forward_cache_counter_total_number",
+          util::prometheus::Labels({{"result", "miss"}}),
+          "The number of cacheable forwarded requests sent to rippled"
+      ))
+    , bypassCounter_(PrometheusService::counterInt(
+          "forward_cache_counter_total_number",
+          util::prometheus::Labels({{"result", "bypass"}}),
+          "The number of forwarded requests sent to rippled that are never cached"
+      ))
 {
-    LOG(log_.trace()) << "Freshening ForwardCache";
+    std::chrono::seconds duration{DEFAULT_DURATION};
+    if (config.contains("cache_duration"))
+        duration = std::chrono::seconds{
+            config.valueOrThrow<std::uint32_t>("cache_duration", "Source cache_duration must be a number")
+        };
 
-    auto numOutstanding = std::make_shared<std::atomic_uint>(latestForwarded_.size());
+    if (config.contains("cache")) {
+        auto commands = config.arrayOrThrow("cache", "Source cache must be array");
+        for (auto const& command : commands) {
+            auto key = command.valueOrThrow<std::string>("Source forward command must be array of strings");
+            ttls_[key] = duration;
+        }
+    }
 
-    for (auto const& cacheEntry : latestForwarded_) {
-        boost::asio::spawn(
-            strand_,
-            [this, numOutstanding, command = cacheEntry.first](boost::asio::yield_context yield) {
-                boost::json::object const request = {{"command", command}};
-                auto resp = source_.requestFromRippled(request, std::nullopt, yield);
+    for (auto const& policy : config.arrayOr("cache_ttl", {})) {
+        auto command = policy.valueOrThrow<std::string>("command", "Source cache_ttl command must be a string");
+        ttls_[command] = std::chrono::seconds{
+            policy.valueOrThrow<std::uint32_t>("ttl", "Source cache_ttl ttl must be a number of seconds")
+        };
+    }
+}
 
-                if (!resp || resp->contains("error"))
-                    resp = {};
+std::optional<boost::json::object>
+ForwardCache::get(
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    boost::asio::yield_context yield
+)
+{
+    auto const commandAndKey = makeKey(request);
+    auto const ttl = commandAndKey ? ttls_.find(commandAndKey->first) : ttls_.end();
+    if (ttl == ttls_.end()) {
+        ++bypassCounter_.get();
+        return source_.requestFromRippled(request, clientIp, yield);
+    }
+
+    auto const& key = commandAndKey->second;
+    std::shared_ptr<ChannelType> channel;
+    std::uint64_t generation = 0;
 
-                {
-                    std::scoped_lock const lk(mtx_);
-                    latestForwarded_[command] = resp;
-                }
+    {
+        std::scoped_lock const lck{mtx_};
+
+        if (auto const it = index_.find(key); it != index_.end()) {
+            if (it->second->expiresAt > std::chrono::steady_clock::now()) {
+                ++hitCounter_.get();
+                entries_.splice(entries_.begin(), entries_, it->second);
+                LOG(log_.debug()) << "request hit forwardCache";
+                return withIdOf(it->second->response, request);
             }
-        );
+
+            erase(it->second);
+        }
+
+        if (auto const it = waiting_.find(key); it != waiting_.end()) {
+            ++coalescedCounter_.get();
+            channel = std::make_shared<ChannelType>(yield.get_executor(), 1);
+            it->second.push_back(channel);
+        } else {
+            ++missCounter_.get();
+            waiting_.emplace(key, std::vector<std::shared_ptr<ChannelType>>{});
+            generation = generation_;
+        }
+    }
+
+    if (channel) {
+        boost::system::error_code ec;
+        auto response = channel->async_receive(yield[ec]);
+        if (ec or not response)
+            return std::nullopt;
+
+        return withIdOf(std::move(*response), request);
     }
+
+    ResponseType response;
+    try {
+        response = source_.requestFromRippled(request, clientIp, yield);
+    } catch (...) {
+        complete(key, generation, std::nullopt, ttl->second);
+        throw;
+    }
+
+    complete(key, generation, response, ttl->second);
+    return response;
 }
 
 void
-ForwardCache::clear()
+ForwardCache::onLedgerClosed(std::uint32_t ledgerSequence)
 {
-    std::scoped_lock const lk(mtx_);
-    for (auto& cacheEntry : latestForwarded_)
-        latestForwarded_[cacheEntry.first] = {};
+    std::scoped_lock const lck{mtx_};
+    if (ledgerSequence <= ledgerSequence_)
+        return;
+
+    ledgerSequence_ = ledgerSequence;
+    ++generation_;
+    clear();
 }
 
-std::optional<boost::json::object>
-ForwardCache::get(boost::json::object const& request) const
+std::size_t
+ForwardCache::size()
+{
+    std::scoped_lock const lck{mtx_};
+    return entries_.size();
+}
+
+std::optional<std::pair<std::string, std::string>>
+ForwardCache::makeKey(boost::json::object const& request)
 {
     std::optional<std::string> command = {};
     if (request.contains("command") && !request.contains("method") && request.at("command").is_string()) {
@@ -80,15 +246,76 @@ ForwardCache::get(boost::json::object const& request) const
     }
 
     if (!command)
-        return {};
-    if (rpc::specifiesCurrentOrClosedLedger(request))
-        return {};
+        return std::nullopt;
 
-    std::shared_lock const lk(mtx_);
-    if (!latestForwarded_.contains(*command))
-        return {};
+    auto key = *command;
+    appendNormalized(request, key, true);
+
+    return std::make_pair(std::move(*command), std::move(key));
+}
+
+void
+ForwardCache::complete(
+    std::string const& key,
+    std::uint64_t generation,
+    ResponseType const& response,
+    std::chrono::steady_clock::duration ttl
+)
+{
+    std::vector<std::shared_ptr<ChannelType>> waiting;
+
+    {
+        std::scoped_lock const lck{mtx_};
+        if (auto const it = waiting_.find(key); it != waiting_.end()) {
+            waiting = std::move(it->second);
+            waiting_.erase(it);
+        }
+
+        // responses fetched before the latest ledger was seen may already be outdated
+        if (response and not response->contains("error") and generation == generation_)
+            store(key, *response, ttl);
+    }
 
-    return {latestForwarded_.at(*command)};
+    for (auto const& waiter : waiting)
+        waiter->try_send(boost::system::error_code{}, response);
+}
+
+void
+ForwardCache::store(
+    std::string const& key,
+    boost::json::object const& response,
+    std::chrono::steady_clock::duration ttl
+)
+{
+    auto const size = key.size() + boost::json::serialize(response).size();
+    if (size > maxSize_)
+        return;
+
+    if (auto const it = index_.find(key); it != index_.end())
+        erase(it->second);
+
+    while (size_ + size > maxSize_)
+        erase(std::prev(entries_.end()));
+
+    entries_.push_front(Entry{key, response, size, std::chrono::steady_clock::now() + ttl});
+    index_[key] = entries_.begin();
+    size_ += size;
+}
+
+void
+ForwardCache::erase(std::list<Entry>::iterator it)
+{
+    size_ -= it->size;
+    index_.erase(it->key);
+    entries_.erase(it);
+}
+
+void
+ForwardCache::clear()
+{
+    entries_.clear();
+    index_.clear();
+    size_ = 0;
 }
 
 }  // namespace etl::detail
@@ -19,17 +19,26 @@
 
 #pragma once
 
-#include "data/BackendInterface.h"
-#include "etl/ETLHelpers.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
-
-#include <boost/asio.hpp>
-#include <boost/json.hpp>
-
-#include <atomic>
+#include "util/prometheus/Counter.h"
+
+#include <boost/asio/experimental/concurrent_channel.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/json/object.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace etl {
 class Source;
@@ -39,44 +48,109 @@ namespace etl::detail {
 
 /**
  * @brief Cache for rippled responses
+ *
+ * Responses are cached for the commands listed in the "cache" section of the source configuration, keyed by the
+ * normalized request, i.e. the command and its sorted parameters without the request id. Every entry lives for the
+ * time-to-live of its command and all entries are dropped when the source reports a new ledger, so responses about the
+ * current or closed ledger are never older than that ledger. Concurrent misses for the same request are sent to rippled
+ * once and share the response. The total size of the cached responses is bounded; the least recently used ones are
+ * evicted first.
  */
 class ForwardCache {
     using ResponseType = std::optional<boost::json::object>;
+    using ChannelType = boost::asio::experimental::concurrent_channel<void(boost::system::error_code, ResponseType)>;
+
     static constexpr std::uint32_t DEFAULT_DURATION = 10;
+    static constexpr std::size_t DEFAULT_MAX_SIZE_MB = 16;
+
+    struct Entry {
+        std::string key;
+        boost::json::object response;
+        std::size_t size;
+        std::chrono::steady_clock::time_point expiresAt;
+    };
 
     util::Logger log_{"ETL"};
 
-    mutable std::shared_mutex mtx_;
-    std::unordered_map<std::string, ResponseType> latestForwarded_;
-    boost::asio::strand<boost::asio::io_context::executor_type> strand_;
     etl::Source const& source_;
-    std::uint32_t duration_ = DEFAULT_DURATION;
+    std::unordered_map<std::string, std::chrono::steady_clock::duration> ttls_;  // by command
+    std::size_t maxSize_;
+
+    std::mutex mtx_;
+    std::list<Entry> entries_;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<ChannelType>>> waiting_;  // by key of the request
+    std::size_t size_ = 0;
+    std::uint32_t ledgerSequence_ = 0;
+    std::uint64_t generation_ = 0;
+
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> coalescedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> missCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> bypassCounter_;
 
+public:
+    /**
+     * @brief Construct a new cache from the configuration of an ETL source.
+     *
+     * @param config The configuration of the source
+     * @param source The source to forward requests to
+     */
+    ForwardCache(util::Config const& config, Source const& source);
+
+    /**
+     * @brief Get the response to a request from the cache, or from rippled if it isn't cached.
+     *
+     * @param request The request to forward
+     * @param clientIp IP of the client forwarding this request if known
+     * @param yield The coroutine context
+     * @return The response on success; nullopt otherwise
+     */
+    std::optional<boost::json::object>
+    get(
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        boost::asio::yield_context yield
+    );
+
+    /**
+     * @brief Drop all cached responses if the ledger is newer than the latest one seen.
+     *
+     * @param ledgerSequence The sequence of a ledger validated or closed by rippled
+     */
     void
-    clear();
+    onLedgerClosed(std::uint32_t ledgerSequence);
+
+    /** @return The number of cached responses */
+    std::size_t
+    size();
+
+    /**
+     * @brief Make the key a request is cached under.
+     *
+     * @param request The request
+     * @return The command and the key if the request names its command; nullopt otherwise
+     */
+    static std::optional<std::pair<std::string, std::string>>
+    makeKey(boost::json::object const& request);
+
+private:
+    void
+    complete(
+        std::string const& key,
+        std::uint64_t generation,
+        ResponseType const& response,
+        std::chrono::steady_clock::duration ttl
+    );
 
-public:
-    ForwardCache(util::Config const& config, boost::asio::io_context& ioc, Source const& source)
-        : strand_(boost::asio::make_strand(ioc)), source_(source)
-    {
-        if (config.contains("cache")) {
-            auto commands = config.arrayOrThrow("cache", "Source cache must be array");
-
-            if (config.contains("cache_duration"))
-                duration_ = config.valueOrThrow<uint32_t>("cache_duration", "Source cache_duration must be a number");
-
-            for (auto const& command : commands) {
-                auto key = command.valueOrThrow<std::string>("Source forward command must be array of strings");
-                latestForwarded_[key] = {};
-            }
-        }
-    }
+    void
+    store(std::string const& key, boost::json::object const& response, std::chrono::steady_clock::duration ttl);
 
     void
-    freshen();
+    erase(std::list<Entry>::iterator it);
 
-    std::optional<boost::json::object>
-    get(boost::json::object const& request) const;
+    void
+    clear();
 };
 
 }  // namespace etl::detail
@@ -0,0 +1,457 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ForwardingConnectionPool.h"
+
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/role.hpp>
+#include <boost/beast/core/stream_traits.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/version.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <boost/beast/websocket/stream_base.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <boost/json/value.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace etl::detail {
+
+namespace {
+
+constexpr auto CONNECT_TIMEOUT = std::chrono::seconds{3};
+
+}  // namespace
+
+ForwardingConnection::ForwardingConnection(boost::asio::any_io_executor executor)
+    : strand_(boost::asio::make_strand(std::move(executor))), ws_(strand_)
+{
+}
+
+std::shared_ptr<ForwardingConnection>
+ForwardingConnection::connect(
+    std::string const& host,
+    std::string const& port,
+    std::optional<std::string> const& clientIp,
+    std::chrono::steady_clock::duration const healthCheckInterval,
+    boost::asio::yield_context yield
+)
+{
+    namespace beast = boost::beast;
+    namespace websocket = beast::websocket;
+
+    auto connection = std::make_shared<ForwardingConnection>(yield.get_executor());
+    auto& ws = connection->ws_;
+    beast::error_code ec;
+
+    boost::asio::ip::tcp::resolver resolver{yield.get_executor()};
+    auto const results = resolver.async_resolve(host, port, yield[ec]);
+    if (ec)
+        return nullptr;
+
+    ws.next_layer().expires_after(CONNECT_TIMEOUT);
+    ws.next_layer().async_connect(results, yield[ec]);
+    if (ec)
+        return nullptr;
+
+    // from here on the websocket timeouts apply; they ping rippled when the connection is idle
+    ws.next_layer().expires_never();
+    websocket::stream_base::timeout timeout{};
+    timeout.handshake_timeout = CONNECT_TIMEOUT;
+    timeout.idle_timeout = healthCheckInterval;
+    timeout.keep_alive_pings = true;
+    ws.set_option(timeout);
+
+    // if client ip is know, change the User-Agent of the handshake and to tell rippled to charge the client IP for RPC
+    // resources. See "secure_gateway" in https://github.com/ripple/rippled/blob/develop/cfg/rippled-example.cfg
+
+    // TODO: user-agent can be clio-[version]
+    ws.set_option(websocket::stream_base::decorator([clientIp](websocket::request_type& req) {
+        req.set(beast::http::field::user_agent, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-client-coro");
+        if (clientIp)
+            req.set(beast::http::field::forwarded, "for=" + *clientIp);
+    }));
+
+    ws.async_handshake(host, "/", yield[ec]);
+    if (ec)
+        return nullptr;
+
+    connection->alive_ = true;
+    boost::asio::dispatch(connection->strand_, [connection]() { connection->read(); });
+
+    return connection;
+}
+
+void
+ForwardingConnection::reserve()
+{
+    ++inFlight_;
+    lastUsed_ = std::chrono::steady_clock::now();
+}
+
+std::optional<boost::json::object>
+ForwardingConnection::request(
+    boost::json::object request,
+    std::chrono::steady_clock::duration const timeout,
+    boost::asio::yield_context yield
+)
+{
+    if (not alive_) {
+        release();
+        return std::nullopt;
+    }
+
+    auto const id = nextId_++;
+    std::optional<boost::json::value> clientId;
+    if (auto const it = request.find("id"); it != request.end())
+        clientId = it->value();
+
+    request["id"] = id;
+
+    auto channel = std::make_shared<ChannelType>(yield.get_executor(), 1);
+    boost::asio::dispatch(
+        strand_,
+        [self = shared_from_this(), id, channel, message = boost::json::serialize(request)]() mutable {
+            if (not self->alive_) {
+                channel->try_send(
+                    boost::asio::error::make_error_code(boost::asio::error::not_connected), boost::json::object{}
+                );
+                return;
+            }
+
+            self->pending_.emplace(id, channel);
+            self->write(std::move(message));
+        }
+    );
+
+    boost::asio::steady_timer timer{yield.get_executor(), timeout};
+    timer.async_wait([self = shared_from_this(), id](boost::system::error_code ec) {
+        if (not ec)
+            boost::asio::dispatch(self->strand_, [self, id]() { self->fail(id, boost::asio::error::timed_out); });
+    });
+
+    boost::system::error_code ec;
+    auto response = channel->async_receive(yield[ec]);
+    timer.cancel();
+    release();
+
+    if (ec) {
+        LOG(log_.debug()) << "Forwarded request failed: " << ec.message();
+        return std::nullopt;
+    }
+
+    if (clientId) {
+        response["id"] = std::move(*clientId);
+    } else {
+        response.erase("id");
+    }
+
+    return response;
+}
+
+void
+ForwardingConnection::close()
+{
+    boost::asio::dispatch(strand_, [self = shared_from_this()]() {
+        self->failAll(boost::asio::error::operation_aborted);
+    });
+}
+
+bool
+ForwardingConnection::isAlive() const
+{
+    return alive_;
+}
+
+std::size_t
+ForwardingConnection::inFlight() const
+{
+    return inFlight_;
+}
+
+std::chrono::steady_clock::time_point
+ForwardingConnection::lastUsed() const
+{
+    return lastUsed_;
+}
+
+void
+ForwardingConnection::release()
+{
+    --inFlight_;
+    lastUsed_ = std::chrono::steady_clock::now();
+}
+
+void
+ForwardingConnection::read()
+{
+    ws_.async_read(
+        readBuffer_,
+        boost::asio::bind_executor(strand_, [self = shared_from_this()](boost::beast::error_code ec, std::size_t) {
+            self->onRead(ec);
+        })
+    );
+}
+
+void
+ForwardingConnection::onRead(boost::beast::error_code ec)
+{
+    if (ec) {
+        failAll(ec);
+        return;
+    }
+
+    auto const data = readBuffer_.cdata();
+    std::string_view const message{static_cast<char const*>(data.data()), data.size()};
+
+    boost::system::error_code parseEc;
+    auto parsed = boost::json::parse(message, parseEc);
+    readBuffer_.consume(readBuffer_.size());
+
+    if (parseEc or not parsed.is_object()) {
+        LOG(log_.error()) << "Error parsing response: " << message;
+    } else if (auto const it = parsed.as_object().find("id"); it != parsed.as_object().end()) {
+        std::optional<std::uint64_t> id;
+        if (auto const* value = it->value().if_int64(); value != nullptr and *value >= 0)
+            id = static_cast<std::uint64_t>(*value);
+        if (auto const* value = it->value().if_uint64(); value != nullptr)
+            id = *value;
+
+        if (auto const request = id ? pending_.find(*id) : pending_.end(); request != pending_.end()) {
+            request->second->try_send(boost::system::error_code{}, std::move(parsed.as_object()));
+            pending_.erase(request);
+        }
+    }
+
+    read();
+}
+
+void
+ForwardingConnection::write(std::string message)
+{
+    writeQueue_.push_back(std::move(message));
+    if (not writing_)
+        doWrite();
+}
+
+void
+ForwardingConnection::doWrite()
+{
+    auto message = std::make_shared<std::string>(std::move(writeQueue_.front()));
+    writeQueue_.pop_front();
+    writing_ = true;
+
+    ws_.async_write(
+        boost::asio::buffer(*message),
+        boost::asio::bind_executor(
+            strand_,
+            [self = shared_from_this(), message](boost::beast::error_code ec, std::size_t) {
+                self->writing_ = false;
+                if (ec) {
+                    self->failAll(ec);
+                } else if (not self->writeQueue_.empty()) {
+                    self->doWrite();
+                }
+            }
+        )
+    );
+}
+
+void
+ForwardingConnection::fail(std::uint64_t const id, boost::beast::error_code ec)
+{
+    if (auto const request = pending_.find(id); request != pending_.end()) {
+        request->second->try_send(ec, boost::json::object{});
+        pending_.erase(request);
+    }
+}
+
+void
+ForwardingConnection::failAll(boost::beast::error_code ec)
+{
+    if (alive_.exchange(false)) {
+        LOG(log_.debug()) << "Closing forwarding connection: " << ec.message();
+        boost::beast::error_code ignored;
+        boost::beast::get_lowest_layer(ws_).socket().close(ignored);
+    }
+
+    for (auto& [_, channel] : pending_)
+        channel->try_send(ec, boost::json::object{});
+
+    pending_.clear();
+    writeQueue_.clear();
+}
+
+ForwardingConnectionPool::ForwardingConnectionPool(util::Config const& config)
+    : host_(config.valueOr<std::string>("ip", {}))
+    , port_(config.valueOr<std::string>("ws_port", {}))
+    , maxConnections_(config.valueOr<std::size_t>("forwarding.max_connections", DEFAULT_MAX_CONNECTIONS))
+    , maxInFlight_(config.valueOr<std::size_t>("forwarding.max_in_flight", DEFAULT_MAX_IN_FLIGHT))
+    , idleTimeout_(std::chrono::seconds{
+          config.valueOr<std::uint32_t>("forwarding.idle_timeout", DEFAULT_IDLE_TIMEOUT_SECONDS)
+      })
+    , healthCheckInterval_(std::chrono::seconds{
+          config.valueOr<std::uint32_t>("forwarding.health_check_interval", DEFAULT_HEALTH_CHECK_INTERVAL_SECONDS)
+      })
+    , requestTimeout_(std::chrono::seconds{
+          config.valueOr<std::uint32_t>("forwarding.request_timeout", DEFAULT_REQUEST_TIMEOUT_SECONDS)
+      })
+{
+}
+
+ForwardingConnectionPool::~ForwardingConnectionPool()
+{
+    std::scoped_lock const lck{mtx_};
+    for (auto const& [_, connection] : connections_)
+        connection->close();
+}
+
+std::optional<boost::json::object>
+ForwardingConnectionPool::request(
+    boost::json::object const& request,
+    std::optional<std::string> const& clientIp,
+    boost::asio::yield_context yield
+)
+{
+    struct InFlightGuard {
+        std::atomic_size_t& inFlight;
+        ~InFlightGuard()
+        {
+            --inFlight;
+        }
+    };
+
+    if (inFlight_++ >= maxInFlight_) {
+        --inFlight_;
+        LOG(log_.warn()) << "Too many forwarded requests in flight to " << host_ << ":" << port_;
+        return std::nullopt;
+    }
+    InFlightGuard const guard{inFlight_};
+
+    auto const key = clientIp.value_or("");
+    auto connection = acquire(key);
+    auto pooled = true;
+
+    if (not connection) {
+        connection = ForwardingConnection::connect(host_, port_, clientIp, healthCheckInterval_, yield);
+        if (not connection)
+            return std::nullopt;
+
+        connection->reserve();
+        pooled = store(key, connection);
+    }
+
+    auto response = connection->request(request, requestTimeout_, yield);
+
+    // connections that didn't fit into the pool serve only this request
+    if (not pooled)
+        connection->close();
+
+    if (response)
+        (*response)["forwarded"] = true;
+
+    return response;
+}
+
+std::size_t
+ForwardingConnectionPool::size() const
+{
+    std::scoped_lock const lck{mtx_};
+    return connections_.size();
+}
+
+std::shared_ptr<ForwardingConnection>
+ForwardingConnectionPool::acquire(std::string const& key)
+{
+    auto const now = std::chrono::steady_clock::now();
+
+    std::scoped_lock const lck{mtx_};
+    std::erase_if(connections_, [&](auto const& entry) {
+        auto const& connection = entry.second;
+        if (not connection->isAlive())
+            return true;
+
+        if (connection->inFlight() == 0 and now - connection->lastUsed() > idleTimeout_) {
+            connection->close();
+            return true;
+        }
+
+        return false;
+    });
+
+    // reserved under the lock, otherwise another request could close it as idle before the request is sent
+    if (auto const it = connections_.find(key); it != connections_.end()) {
+        it->second->reserve();
+        return it->second;
+    }
+
+    return nullptr;
+}
+
+bool
+ForwardingConnectionPool::store(std::string const& key, std::shared_ptr<ForwardingConnection> const& connection)
+{
+    std::scoped_lock const lck{mtx_};
+    if (auto const it = connections_.find(key); it != connections_.end())
+        return false;  // another request connected for the same client meanwhile
+
+    if (connections_.size() >= maxConnections_) {
+        auto const idle = [](auto const& entry) { return entry.second->inFlight() == 0; };
+        auto leastRecentlyUsed = connections_.end();
+        for (auto it = connections_.begin(); it != connections_.end(); ++it) {
+            if (idle(*it) and
+                (leastRecentlyUsed == connections_.end() or
+                 it->second->lastUsed() < leastRecentlyUsed->second->lastUsed()))
+                leastRecentlyUsed = it;
+        }
+
+        if (leastRecentlyUsed == connections_.end())
+            return false;
+
+        leastRecentlyUsed->second->close();
+        connections_.erase(leastRecentlyUsed);
+    }
+
+    connections_.emplace(key, connection);
+    return true;
+}
+
+}  // namespace etl::detail
@@ -0,0 +1,232 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/experimental/concurrent_channel.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <boost/json/object.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace etl::detail {
+
+/**
+ * @brief A websocket connection to rippled that carries many forwarded requests at once.
+ *
+ * Every request is sent with an id unique to the connection and the response carrying that id is handed back to the
+ * waiting coroutine; the id of the original request is restored in the response. Idle connections are pinged and
+ * closed if rippled stops answering.
+ */
+class ForwardingConnection : public std::enable_shared_from_this<ForwardingConnection> {
+    using StreamType = boost::beast::websocket::stream<boost::beast::tcp_stream>;
+    using ChannelType =
+        boost::asio::experimental::concurrent_channel<void(boost::system::error_code, boost::json::object)>;
+
+    util::Logger log_{"ETL"};
+
+    boost::asio::strand<boost::asio::any_io_executor> strand_;
+    StreamType ws_;
+    boost::beast::flat_buffer readBuffer_;
+
+    // only accessed on strand_
+    std::deque<std::string> writeQueue_;
+    bool writing_ = false;
+    std::unordered_map<std::uint64_t, std::shared_ptr<ChannelType>> pending_;
+
+    std::atomic_uint64_t nextId_ = 1;
+    std::atomic_size_t inFlight_ = 0;
+    std::atomic_bool alive_ = false;
+    std::atomic<std::chrono::steady_clock::time_point> lastUsed_ = std::chrono::steady_clock::now();
+
+public:
+    /**
+     * @brief Construct a new, not yet connected connection.
+     *
+     * @param executor The executor to run the connection on
+     */
+    explicit ForwardingConnection(boost::asio::any_io_executor executor);
+
+    /**
+     * @brief Connect to rippled.
+     *
+     * @param host The host of rippled
+     * @param port The websocket port of rippled
+     * @param clientIp The client the requests are forwarded for, passed on to rippled to charge for the requests
+     * @param healthCheckInterval The time without messages after which rippled is pinged and the connection is closed
+     * if it doesn't answer
+     * @param yield The coroutine context
+     * @return The connection if connected; nullptr otherwise
+     */
+    static std::shared_ptr<ForwardingConnection>
+    connect(
+        std::string const& host,
+        std::string const& port,
+        std::optional<std::string> const& clientIp,
+        std::chrono::steady_clock::duration healthCheckInterval,
+        boost::asio::yield_context yield
+    );
+
+    /**
+     * @brief Reserve the connection for one request, so that it is not closed as idle before the request is sent.
+     */
+    void
+    reserve();
+
+    /**
+     * @brief Send a request and wait for its response.
+     *
+     * The connection has to be reserved for the request with @ref reserve first; the reservation ends with the request.
+     *
+     * @param request The request to send
+     * @param timeout The time to wait for the response
+     * @param yield The coroutine context
+     * @return The response on success; nullopt otherwise
+     */
+    std::optional<boost::json::object>
+    request(boost::json::object request, std::chrono::steady_clock::duration timeout, boost::asio::yield_context yield);
+
+    /** @brief Close the connection, failing all requests in flight */
+    void
+    close();
+
+    /** @return true if the connection can still be used; false otherwise */
+    bool
+    isAlive() const;
+
+    /** @return The number of requests reserved or waiting for their response */
+    std::size_t
+    inFlight() const;
+
+    /** @return The time the last request was sent or answered */
+    std::chrono::steady_clock::time_point
+    lastUsed() const;
+
+private:
+    void
+    release();
+
+    void
+    read();
+
+    void
+    onRead(boost::beast::error_code ec);
+
+    void
+    write(std::string message);
+
+    void
+    doWrite();
+
+    void
+    fail(std::uint64_t id, boost::beast::error_code ec);
+
+    void
+    failAll(boost::beast::error_code ec);
+};
+
+/**
+ * @brief Long-lived forwarding connections to one rippled.
+ *
+ * Connections are kept per client IP because rippled charges the client named in the handshake for all requests on a
+ * connection. Connections idle for longer than the idle timeout are closed, and the number of connections as well as
+ * the number of requests in flight are capped so that a slow rippled can't pile up requests.
+ */
+class ForwardingConnectionPool {
+    static constexpr std::size_t DEFAULT_MAX_CONNECTIONS = 64;
+    static constexpr std::size_t DEFAULT_MAX_IN_FLIGHT = 512;
+    static constexpr std::uint32_t DEFAULT_IDLE_TIMEOUT_SECONDS = 60;
+    static constexpr std::uint32_t DEFAULT_HEALTH_CHECK_INTERVAL_SECONDS = 30;
+    static constexpr std::uint32_t DEFAULT_REQUEST_TIMEOUT_SECONDS = 10;
+
+    util::Logger log_{"ETL"};
+
+    std::string host_;
+    std::string port_;
+    std::size_t maxConnections_;
+    std::size_t maxInFlight_;
+    std::chrono::steady_clock::duration idleTimeout_;
+    std::chrono::steady_clock::duration healthCheckInterval_;
+    std::chrono::steady_clock::duration requestTimeout_;
+
+    std::atomic_size_t inFlight_ = 0;
+
+    mutable std::mutex mtx_;
+    std::unordered_map<std::string, std::shared_ptr<ForwardingConnection>> connections_;  // by client IP
+
+public:
+    /**
+     * @brief Construct a new pool from the configuration of an ETL source.
+     *
+     * @param config The configuration of the source
+     */
+    explicit ForwardingConnectionPool(util::Config const& config);
+
+    ~ForwardingConnectionPool();
+
+    ForwardingConnectionPool(ForwardingConnectionPool const&) = delete;
+    ForwardingConnectionPool&
+    operator=(ForwardingConnectionPool const&) = delete;
+
+    /**
+     * @brief Forward a request to rippled.
+     *
+     * @param request The request to forward
+     * @param clientIp IP of the client forwarding this request if known
+     * @param yield The coroutine context
+     * @return The response marked as forwarded on success; nullopt otherwise
+     */
+    std::optional<boost::json::object>
+    request(
+        boost::json::object const& request,
+        std::optional<std::string> const& clientIp,
+        boost::asio::yield_context yield
+    );
+
+    /** @return The number of open connections */
+    std::size_t
+    size() const;
+
+private:
+    std::shared_ptr<ForwardingConnection>
+    acquire(std::string const& key);
+
+    bool
+    store(std::string const& key, std::shared_ptr<ForwardingConnection> const& connection);
+};
+
+}  // namespace etl::detail
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/InitialLoadQueue.h"
+
+#include <ripple/basics/base_uint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace etl::detail {
+
+InitialLoadQueue::InitialLoadQueue(
+    std::vector<ripple::uint256> const& markers,
+    std::chrono::steady_clock::duration stallTimeout
+)
+    : stallTimeout_(stallTimeout), total_(markers.size())
+{
+    for (std::size_t i = 0; i < markers.size(); ++i) {
+        std::optional<ripple::uint256> end;
+        if (i + 1 < markers.size())
+            end = markers[i + 1];
+
+        pending_.push_back(Pending{
+            .range = Range{.id = i, .marker = markers[i], .end = end, .lastKey = {}}, .releasedBy = {}, .releasedAt = {}
+        });
+    }
+}
+
+std::optional<InitialLoadQueue::Range>
+InitialLoadQueue::take(std::string_view source, bool wait)
+{
+    std::unique_lock lck{mtx_};
+
+    while (true) {
+        auto const now = std::chrono::steady_clock::now();
+        auto const available = std::find_if(pending_.begin(), pending_.end(), [&](Pending const& entry) {
+            return entry.releasedBy != source or now - entry.releasedAt > stallTimeout_;
+        });
+
+        if (available != pending_.end()) {
+            auto range = std::move(available->range);
+            pending_.erase(available);
+            inProgress_[range.id] = Progress{.lastProgress = now};
+            return range;
+        }
+
+        if (not wait or (inProgress_.empty() and pending_.empty()))
+            return std::nullopt;
+
+        if (inProgress_.empty()) {
+            // only ranges this source released are left, they are taken back if no other source takes them in time
+            cv_.wait_for(lck, stallTimeout_);
+            continue;
+        }
+
+        // ask the owner of the range stalled the longest to give it back
+        auto stalled = std::min_element(inProgress_.begin(), inProgress_.end(), [](auto const& lhs, auto const& rhs) {
+            return lhs.second.lastProgress < rhs.second.lastProgress;
+        });
+        if (not stalled->second.release and now - stalled->second.lastProgress > stallTimeout_)
+            stalled->second.release = true;
+
+        cv_.wait_for(lck, stallTimeout_);
+    }
+}
+
+void
+InitialLoadQueue::progress(std::size_t id)
+{
+    std::scoped_lock const lck{mtx_};
+    if (auto const it = inProgress_.find(id); it != inProgress_.end())
+        it->second.lastProgress = std::chrono::steady_clock::now();
+}
+
+bool
+InitialLoadQueue::shouldRelease(std::size_t id) const
+{
+    std::scoped_lock const lck{mtx_};
+    auto const it = inProgress_.find(id);
+    return it != inProgress_.end() and it->second.release;
+}
+
+void
+InitialLoadQueue::finish(std::size_t id)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        inProgress_.erase(id);
+        ++finished_;
+    }
+    cv_.notify_all();
+}
+
+void
+InitialLoadQueue::giveBack(Range range)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        inProgress_.erase(range.id);
+        pending_.push_front(Pending{.range = std::move(range), .releasedBy = {}, .releasedAt = {}});
+    }
+    cv_.notify_all();
+}
+
+void
+InitialLoadQueue::release(Range range, std::string_view source)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        inProgress_.erase(range.id);
+        pending_.push_front(Pending{
+            .range = std::move(range), .releasedBy = std::string{source}, .releasedAt = std::chrono::steady_clock::now()
+        });
+    }
+    cv_.notify_all();
+}
+
+bool
+InitialLoadQueue::done() const
+{
+    std::scoped_lock const lck{mtx_};
+    return finished_ == total_;
+}
+
+std::size_t
+InitialLoadQueue::remaining() const
+{
+    std::scoped_lock const lck{mtx_};
+    return total_ - finished_;
+}
+
+}  // namespace etl::detail
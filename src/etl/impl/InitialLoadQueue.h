@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <ripple/basics/base_uint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief The ranges of a ledger's state left to download, shared by all sources downloading the ledger.
+ *
+ * Sources take ranges and report progress after every page. A source that fails gives the rest of its ranges back to
+ * be resumed by another source. A source with nothing left to take steals ranges that stalled: their owner releases
+ * them after the page it's waiting for, and doesn't get them back unless no other source took them in time.
+ */
+class InitialLoadQueue {
+public:
+    static constexpr auto DEFAULT_STALL_TIMEOUT = std::chrono::seconds{10};
+
+    /** @brief A range of keys to download */
+    struct Range {
+        std::size_t id = 0;
+        ripple::uint256 marker;               ///< Where to continue downloading
+        std::optional<ripple::uint256> end;   ///< Where the next range starts; nullopt for the last range
+        std::string lastKey;                  ///< The last key downloaded so far, empty if none
+    };
+
+private:
+    struct Progress {
+        std::chrono::steady_clock::time_point lastProgress;
+        bool release = false;
+    };
+
+    struct Pending {
+        Range range;
+        std::string releasedBy;  ///< The source that released the range because it stalled, empty if none
+        std::chrono::steady_clock::time_point releasedAt;
+    };
+
+    std::chrono::steady_clock::duration stallTimeout_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<Pending> pending_;
+    std::unordered_map<std::size_t, Progress> inProgress_;
+    std::size_t total_;
+    std::size_t finished_ = 0;
+
+public:
+    /**
+     * @brief Create the ranges between the given markers.
+     *
+     * @param markers The first key of each range, in ascending order
+     * @param stallTimeout The time without progress after which a range may be stolen
+     */
+    explicit InitialLoadQueue(
+        std::vector<ripple::uint256> const& markers,
+        std::chrono::steady_clock::duration stallTimeout = DEFAULT_STALL_TIMEOUT
+    );
+
+    /**
+     * @brief Take a range to download.
+     *
+     * A range the source released is left for other sources for the stall timeout.
+     *
+     * @param source The source taking the range
+     * @param wait Whether to wait for a range if none is left; while waiting, stalled ranges are stolen
+     * @return The range to download; nullopt if there is none, or when waiting, if no range is being downloaded either
+     */
+    std::optional<Range>
+    take(std::string_view source, bool wait);
+
+    /**
+     * @brief Record that a page of a range was downloaded.
+     *
+     * @param id The id of the range
+     */
+    void
+    progress(std::size_t id);
+
+    /**
+     * @param id The id of the range
+     * @return true if the range was stolen and should be given back after the current page; false otherwise
+     */
+    bool
+    shouldRelease(std::size_t id) const;
+
+    /**
+     * @brief Record that a range was downloaded completely.
+     *
+     * @param id The id of the range
+     */
+    void
+    finish(std::size_t id);
+
+    /**
+     * @brief Give back the rest of a range for another source to download.
+     *
+     * @param range The rest of the range
+     */
+    void
+    giveBack(Range range);
+
+    /**
+     * @brief Give back the rest of a stalled range for another source to download.
+     *
+     * @param range The rest of the range
+     * @param source The source releasing the range
+     */
+    void
+    release(Range range, std::string_view source);
+
+    /** @return true if all ranges were downloaded; false otherwise */
+    bool
+    done() const;
+
+    /** @return The number of ranges not downloaded yet */
+    std::size_t
+    remaining() const;
+};
+
+}  // namespace etl::detail
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/LedgerEvent.h"
+
+#include "data/Types.h"
+#include "util/LedgerUtils.h"
+
+#include <ripple/basics/Slice.h>
+#include <ripple/protocol/LedgerHeader.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace etl::detail {
+
+namespace {
+
+constexpr std::uint32_t VERSION = 1;
+
+// blobs are prefixed with a 32 bit length because variable length fields of the ledger format are limited to ~900KB
+void
+addBlob(ripple::Serializer& serializer, void const* data, std::size_t size)
+{
+    serializer.add32(static_cast<std::uint32_t>(size));
+    serializer.addRaw(data, size);
+}
+
+data::Blob
+getBlob(ripple::SerialIter& iter)
+{
+    auto const size = iter.get32();
+    auto const slice = iter.getSlice(size);
+    return {slice.begin(), slice.end()};
+}
+
+}  // namespace
+
+std::string
+serialize(LedgerEvent const& event)
+{
+    ripple::Serializer header;
+    ripple::addRaw(event.header, header, /* includeHash = */ true);
+
+    ripple::Serializer serializer;
+    serializer.add32(VERSION);
+    addBlob(serializer, header.data(), header.size());
+
+    serializer.add32(static_cast<std::uint32_t>(event.diff.size()));
+    for (auto const& object : event.diff) {
+        serializer.addBitString(object.key);
+        addBlob(serializer, object.blob.data(), object.blob.size());
+    }
+
+    serializer.add32(static_cast<std::uint32_t>(event.transactions.size()));
+    for (auto const& txn : event.transactions) {
+        addBlob(serializer, txn.transaction.data(), txn.transaction.size());
+        addBlob(serializer, txn.metadata.data(), txn.metadata.size());
+        serializer.add32(txn.ledgerSequence);
+        serializer.add32(txn.date);
+    }
+
+    return {static_cast<char const*>(serializer.data()), serializer.size()};
+}
+
+std::optional<LedgerEvent>
+deserializeLedgerEvent(std::string_view data)
+{
+    try {
+        ripple::SerialIter iter{data.data(), data.size()};
+        if (iter.get32() != VERSION)
+            return std::nullopt;
+
+        LedgerEvent event;
+        auto const header = getBlob(iter);
+        event.header = util::deserializeHeader(ripple::makeSlice(header));
+
+        // the counts are read from the network; never reserve more entries than there are bytes left
+        auto const numObjects = iter.get32();
+        event.diff.reserve(std::min<std::size_t>(numObjects, iter.getBytesLeft()));
+        for (std::uint32_t i = 0; i < numObjects; ++i) {
+            auto const key = iter.get256();
+            event.diff.push_back({key, getBlob(iter)});
+        }
+
+        auto const numTransactions = iter.get32();
+        event.transactions.reserve(std::min<std::size_t>(numTransactions, iter.getBytesLeft()));
+        for (std::uint32_t i = 0; i < numTransactions; ++i) {
+            auto transaction = getBlob(iter);
+            auto metadata = getBlob(iter);
+            auto const ledgerSequence = iter.get32();
+            auto const date = iter.get32();
+            event.transactions.emplace_back(std::move(transaction), std::move(metadata), ledgerSequence, date);
+        }
+
+        if (not iter.empty())
+            return std::nullopt;
+
+        return event;
+    } catch (std::exception const&) {
+        return std::nullopt;
+    }
+}
+
+}  // namespace etl::detail
@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.h"
+
+#include <ripple/protocol/LedgerHeader.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief Everything needed to publish a ledger without reading it back from the database.
+ *
+ * The ETL writer creates one for each ledger it writes and streams it to read-only replicas once the ledger is
+ * committed, see LedgerEventServer and LedgerEventClient.
+ */
+struct LedgerEvent {
+    ripple::LedgerHeader header;
+    std::vector<data::LedgerObject> diff;  ///< Created, modified and deleted objects; deleted ones have an empty blob
+    std::vector<data::TransactionAndMetadata> transactions;
+};
+
+/**
+ * @brief Serialize a ledger event to send it to replicas.
+ *
+ * @param event The event to serialize
+ * @return The binary representation of the event
+ */
+std::string
+serialize(LedgerEvent const& event);
+
+/**
+ * @brief Deserialize a ledger event created by serialize.
+ *
+ * @param data The binary representation of the event
+ * @return The event; nullopt if the data is malformed
+ */
+std::optional<LedgerEvent>
+deserializeLedgerEvent(std::string_view data);
+
+}  // namespace etl::detail
@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/LedgerEventClient.h"
+
+#include "etl/impl/LedgerEvent.h"
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace etl::detail {
+
+LedgerEventClient::LedgerEventClient(util::Config const& config)
+    : maxLedgers_(std::max<std::size_t>(config.valueOr<std::size_t>("max_ledgers", DEFAULT_MAX_LEDGERS), 1))
+{
+    for (auto const& writer : config.arrayOr("peers", {})) {
+        auto ip = writer.value<std::string>("ip");
+        auto port = std::to_string(writer.value<std::uint16_t>("port"));
+
+        boost::asio::spawn(ioc_, [this, ip = std::move(ip), port = std::move(port)](boost::asio::yield_context yield) {
+            run(ip, port, yield);
+        });
+    }
+
+    thread_ = std::thread([this]() { ioc_.run(); });
+}
+
+LedgerEventClient::~LedgerEventClient()
+{
+    ioc_.stop();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+std::shared_ptr<LedgerEvent const>
+LedgerEventClient::waitFor(std::uint32_t sequence, std::chrono::steady_clock::duration timeout)
+{
+    std::unique_lock lck{mtx_};
+    events_.erase(events_.begin(), events_.lower_bound(sequence));
+
+    auto const streaming = std::chrono::steady_clock::now() - lastReceived_ < MAX_IDLE_TIME;
+    if (streaming) {
+        cv_.wait_for(lck, timeout, [this, sequence]() {
+            return numConnected_ == 0 or (not events_.empty() and events_.rbegin()->first >= sequence);
+        });
+    }
+
+    auto const it = events_.find(sequence);
+    if (it == events_.end())
+        return nullptr;
+
+    auto event = std::move(it->second);
+    events_.erase(it);
+    return event;
+}
+
+bool
+LedgerEventClient::isConnected() const
+{
+    std::scoped_lock const lck{mtx_};
+    return numConnected_ > 0;
+}
+
+void
+LedgerEventClient::run(std::string const& ip, std::string const& port, boost::asio::yield_context yield)
+{
+    auto retryDelay = std::chrono::steady_clock::duration{MIN_RETRY_DELAY};
+
+    while (true) {
+        boost::system::error_code ec;
+        boost::asio::ip::tcp::resolver resolver{ioc_};
+        boost::asio::ip::tcp::socket socket{ioc_};
+
+        auto const results = resolver.async_resolve(ip, port, yield[ec]);
+        if (not ec)
+            boost::asio::async_connect(socket, results, yield[ec]);
+
+        if (not ec) {
+            LOG(log_.info()) << "Receiving written ledgers from " << ip << ":" << port;
+            setConnected(true);
+
+            std::array<std::uint8_t, sizeof(std::uint32_t)> header{};
+            std::string payload;
+
+            while (not ec) {
+                boost::asio::async_read(socket, boost::asio::buffer(header), yield[ec]);
+                if (ec)
+                    break;
+
+                ripple::SerialIter iter{header.data(), header.size()};
+                auto const size = iter.get32();
+                if (size > MAX_FRAME_SIZE) {
+                    LOG(log_.error()) << "Ledger from " << ip << ":" << port << " is too big: " << size << " bytes";
+                    break;
+                }
+
+                payload.resize(size);
+                boost::asio::async_read(socket, boost::asio::buffer(payload), yield[ec]);
+                if (ec)
+                    break;
+
+                auto event = deserializeLedgerEvent(payload);
+                if (not event) {
+                    LOG(log_.error()) << "Malformed ledger received from " << ip << ":" << port;
+                    break;
+                }
+
+                store(std::move(*event));
+                retryDelay = MIN_RETRY_DELAY;
+            }
+
+            setConnected(false);
+        }
+
+        LOG(log_.warn()) << "Not receiving written ledgers from " << ip << ":" << port << ": " << ec.message()
+                         << ". Retrying in " << std::chrono::duration_cast<std::chrono::seconds>(retryDelay).count()
+                         << " seconds";
+
+        boost::asio::steady_timer timer{ioc_, retryDelay};
+        timer.async_wait(yield[ec]);
+        retryDelay = std::min<std::chrono::steady_clock::duration>(retryDelay * 2, MAX_RETRY_DELAY);
+    }
+}
+
+void
+LedgerEventClient::setConnected(bool connected)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        if (connected) {
+            ++numConnected_;
+            lastReceived_ = std::chrono::steady_clock::now();
+        } else {
+            --numConnected_;
+        }
+    }
+    cv_.notify_all();
+}
+
+void
+LedgerEventClient::store(LedgerEvent&& event)
+{
+    {
+        std::scoped_lock const lck{mtx_};
+        auto const sequence = event.header.seq;
+        events_[sequence] = std::make_shared<LedgerEvent const>(std::move(event));
+        lastReceived_ = std::chrono::steady_clock::now();
+
+        while (events_.size() > maxLedgers_)
+            events_.erase(events_.begin());
+    }
+    cv_.notify_all();
+}
+
+}  // namespace etl::detail
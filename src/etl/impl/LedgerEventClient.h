@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "etl/impl/LedgerEvent.h"
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace etl::detail {
+
+/**
+ * @brief Receives the ledgers streamed by the LedgerEventServer of the ETL writer.
+ *
+ * Used by read-only replicas to publish ledgers without reading them from the database. The client connects to all
+ * configured writers since any of them may be the one writing; connections are retried with a backoff. Only the most
+ * recent ledgers are kept. Ledgers missed while disconnected are read from the database instead.
+ */
+class LedgerEventClient {
+public:
+    static constexpr std::size_t DEFAULT_MAX_LEDGERS = 64;
+
+private:
+    static constexpr std::uint32_t MAX_FRAME_SIZE = 512u * 1024u * 1024u;
+    static constexpr auto MIN_RETRY_DELAY = std::chrono::seconds{1};
+    static constexpr auto MAX_RETRY_DELAY = std::chrono::seconds{30};
+
+    // writers that sent nothing for this long since connecting or since their last ledger are not writing; don't
+    // wait for them
+    static constexpr auto MAX_IDLE_TIME = std::chrono::seconds{10};
+
+    util::Logger log_{"ETL"};
+
+    std::size_t maxLedgers_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::map<std::uint32_t, std::shared_ptr<LedgerEvent const>> events_;
+    std::size_t numConnected_ = 0;
+    std::chrono::steady_clock::time_point lastReceived_{};
+
+    boost::asio::io_context ioc_;
+    std::thread thread_;
+
+public:
+    /**
+     * @brief Start connecting to the writers.
+     *
+     * @param config The "ledger_stream" section of the configuration
+     */
+    explicit LedgerEventClient(util::Config const& config);
+
+    ~LedgerEventClient();
+
+    LedgerEventClient(LedgerEventClient const&) = delete;
+    LedgerEventClient&
+    operator=(LedgerEventClient const&) = delete;
+
+    /**
+     * @brief Wait for a ledger to be received.
+     *
+     * Returns right away if no writer is streaming ledgers or if a later ledger was received already, meaning the
+     * requested one was missed. Ledgers older than the requested one are dropped.
+     *
+     * @param sequence The sequence of the ledger
+     * @param timeout How long to wait at most
+     * @return The ledger; nullptr if it was not received in time
+     */
+    std::shared_ptr<LedgerEvent const>
+    waitFor(std::uint32_t sequence, std::chrono::steady_clock::duration timeout);
+
+    /**
+     * @return true if connected to at least one writer; false otherwise
+     */
+    bool
+    isConnected() const;
+
+private:
+    void
+    run(std::string const& ip, std::string const& port, boost::asio::yield_context yield);
+
+    void
+    setConnected(bool connected);
+
+    void
+    store(LedgerEvent&& event);
+};
+
+}  // namespace etl::detail
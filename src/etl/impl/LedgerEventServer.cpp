@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/LedgerEventServer.h"
+
+#include "etl/impl/LedgerEvent.h"
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+#include <fmt/core.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace etl::detail {
+
+class LedgerEventServer::Session : public std::enable_shared_from_this<Session> {
+    boost::asio::ip::tcp::socket socket_;
+    std::deque<std::shared_ptr<std::string const>> queue_;
+    bool closed_ = false;
+
+public:
+    explicit Session(boost::asio::ip::tcp::socket socket) : socket_(std::move(socket))
+    {
+    }
+
+    /** @return false if the session is closed, possibly because too many frames are waiting to be written */
+    bool
+    send(std::shared_ptr<std::string const> frame, std::size_t maxQueued)
+    {
+        if (closed_)
+            return false;
+
+        if (queue_.size() >= maxQueued) {
+            close();
+            return false;
+        }
+
+        queue_.push_back(std::move(frame));
+        if (queue_.size() == 1)
+            write();
+
+        return true;
+    }
+
+private:
+    void
+    write()
+    {
+        boost::asio::async_write(
+            socket_,
+            boost::asio::buffer(*queue_.front()),
+            [self = shared_from_this()](boost::system::error_code ec, std::size_t) {
+                if (ec) {
+                    self->close();
+                    return;
+                }
+
+                self->queue_.pop_front();
+                if (not self->queue_.empty())
+                    self->write();
+            }
+        );
+    }
+
+    void
+    close()
+    {
+        closed_ = true;
+        queue_.clear();
+
+        boost::system::error_code ec;
+        socket_.close(ec);
+    }
+};
+
+LedgerEventServer::LedgerEventServer(util::Config const& config)
+    : maxQueued_(config.valueOr<std::size_t>("max_queued_ledgers", DEFAULT_MAX_QUEUED_LEDGERS)), acceptor_(ioc_)
+{
+    auto const address = boost::asio::ip::make_address(config.valueOr<std::string>("ip", "127.0.0.1"));
+    auto const port = config.valueOrThrow<std::uint16_t>("port", "Missing ledger_stream.port");
+    auto const endpoint = boost::asio::ip::tcp::endpoint{address, port};
+
+    boost::system::error_code ec;
+    acceptor_.open(endpoint.protocol(), ec);
+    if (not ec)
+        acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
+    if (not ec)
+        acceptor_.bind(endpoint, ec);
+    if (not ec)
+        acceptor_.listen(boost::asio::socket_base::max_listen_connections, ec);
+
+    if (ec) {
+        LOG(log_.error()) << "Failed to listen for replicas at " << endpoint << ". message: " << ec.message();
+        throw std::runtime_error(
+            fmt::format("Failed to listen for replicas at {}:{}", endpoint.address().to_string(), endpoint.port())
+        );
+    }
+
+    LOG(log_.info()) << "Streaming written ledgers to replicas at " << acceptor_.local_endpoint();
+
+    accept();
+    thread_ = std::thread([this]() { ioc_.run(); });
+}
+
+LedgerEventServer::~LedgerEventServer()
+{
+    ioc_.stop();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void
+LedgerEventServer::publish(std::shared_ptr<LedgerEvent const> event)
+{
+    boost::asio::post(ioc_, [this, event = std::move(event)]() {
+        if (sessions_.empty())
+            return;
+
+        auto const payload = serialize(*event);
+
+        ripple::Serializer frame;
+        frame.add32(static_cast<std::uint32_t>(payload.size()));
+        frame.addRaw(payload.data(), payload.size());
+        auto const shared =
+            std::make_shared<std::string const>(static_cast<char const*>(frame.data()), frame.size());
+
+        auto const numBefore = sessions_.size();
+        std::erase_if(sessions_, [&](auto const& session) { return not session->send(shared, maxQueued_); });
+        numSubscribers_ = sessions_.size();
+
+        if (sessions_.size() < numBefore) {
+            LOG(log_.warn()) << "Dropped " << numBefore - sessions_.size() << " replicas that are gone or too slow";
+        }
+    });
+}
+
+std::uint16_t
+LedgerEventServer::port() const
+{
+    return acceptor_.local_endpoint().port();
+}
+
+std::size_t
+LedgerEventServer::numSubscribers() const
+{
+    return numSubscribers_;
+}
+
+void
+LedgerEventServer::accept()
+{
+    acceptor_.async_accept([this](boost::system::error_code ec, boost::asio::ip::tcp::socket socket) {
+        if (ec == boost::asio::error::operation_aborted)
+            return;
+
+        if (not ec) {
+            LOG(log_.info()) << "Replica connected from " << socket.remote_endpoint(ec);
+
+            socket.set_option(boost::asio::ip::tcp::no_delay(true), ec);
+            sessions_.push_back(std::make_shared<Session>(std::move(socket)));
+            numSubscribers_ = sessions_.size();
+        }
+
+        accept();
+    });
+}
+
+}  // namespace etl::detail
@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "etl/impl/LedgerEvent.h"
+#include "util/config/Config.h"
+#include "util/log/Logger.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief Streams the ledgers written by the ETL writer to read-only replicas.
+ *
+ * Replicas connect over plain TCP and receive every ledger written after they connected as a frame made of the 32 bit
+ * big-endian size of the serialized LedgerEvent followed by the event. Replicas are expected to run in the same trusted
+ * network; nothing is read from them. A replica that falls more than a few ledgers behind is disconnected and reads
+ * ledgers from the database until it reconnects.
+ */
+class LedgerEventServer {
+public:
+    static constexpr std::size_t DEFAULT_MAX_QUEUED_LEDGERS = 16;
+
+private:
+    class Session;
+
+    util::Logger log_{"ETL"};
+
+    std::size_t maxQueued_;
+    boost::asio::io_context ioc_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+
+    // only accessed on the thread running ioc_
+    std::vector<std::shared_ptr<Session>> sessions_;
+    std::atomic_size_t numSubscribers_ = 0;
+
+    std::thread thread_;
+
+public:
+    /**
+     * @brief Start listening for replicas.
+     *
+     * @param config The "ledger_stream" section of the configuration
+     * @throws std::runtime_error if the server can't listen on the configured endpoint
+     */
+    explicit LedgerEventServer(util::Config const& config);
+
+    ~LedgerEventServer();
+
+    LedgerEventServer(LedgerEventServer const&) = delete;
+    LedgerEventServer&
+    operator=(LedgerEventServer const&) = delete;
+
+    /**
+     * @brief Send a ledger to all connected replicas; the ledger must already be committed to the database.
+     *
+     * @param event The ledger to send; it is serialized on the thread of the server
+     */
+    void
+    publish(std::shared_ptr<LedgerEvent const> event);
+
+    /**
+     * @return The port the server listens on
+     */
+    std::uint16_t
+    port() const;
+
+    /**
+     * @return The number of connected replicas
+     */
+    std::size_t
+    numSubscribers() const;
+
+private:
+    void
+    accept();
+};
+
+}  // namespace etl::detail
@@ -23,15 +23,23 @@
 #include "etl/NFTHelpers.h"
 #include "etl/SystemState.h"
 #include "etl/impl/LedgerFetcher.h"
+#include "etl/impl/TransactionDecoder.h"
 #include "util/Assert.h"
 #include "util/LedgerUtils.h"
 #include "util/Profiler.h"
 #include "util/log/Logger.h"
+#include "util/prometheus/Label.h"
+#include "util/prometheus/Prometheus.h"
 
 #include <ripple/beast/core/CurrentThreadName.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 /**
  * @brief Account transactions, NFT transactions and NFT data bundled togeher.
@@ -61,21 +69,26 @@ private:
     std::shared_ptr<LoadBalancerType> loadBalancer_;
     std::reference_wrapper<LedgerFetcherType> fetcher_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
+    TransactionDecoder decoder_;
 
 public:
     /**
      * @brief Create an instance of the loader
+     *
+     * @param decodeThreads The number of threads decoding the transactions of a ledger
      */
     LedgerLoader(
         std::shared_ptr<BackendInterface> backend,
         std::shared_ptr<LoadBalancerType> balancer,
         LedgerFetcherType& fetcher,
-        SystemState const& state
+        SystemState const& state,
+        std::size_t decodeThreads = TransactionDecoder::DEFAULT_NUM_THREADS
     )
         : backend_{std::move(backend)}
         , loadBalancer_{std::move(balancer)}
         , fetcher_{std::ref(fetcher)}
         , state_{std::cref(state)}
+        , decoder_{decodeThreads}
     {
     }
 
@@ -94,25 +107,50 @@ public:
     insertTransactions(ripple::LedgerHeader const& ledger, GetLedgerResponseType& data)
     {
         FormattedTransactionsData result;
+        auto& transactions = *(data.mutable_transactions_list()->mutable_transactions());
+
+        std::vector<TransactionDecoder::RawTransaction> rawTransactions;
+        rawTransactions.reserve(transactions.size());
+        for (auto const& txn : transactions)
+            rawTransactions.push_back({.transaction = txn.transaction_blob(), .metadata = txn.metadata_blob()});
 
-        for (auto& txn : *(data.mutable_transactions_list()->mutable_transactions())) {
+        auto [decoded, decodeTime] = ::util::timed<std::chrono::duration<double>>([&]() {
+            return decoder_.decode(ledger.seq, rawTransactions);
+        });
+        LOG(log_.debug()) << "Decoded " << decoded.size() << " transactions in " << decodeTime
+                          << " seconds; seq = " << ledger.seq;
+
+        // decoded in transaction index order, so everything below is written in the same order whatever the order
+        // of the extracted data
+        std::vector<data::TransactionAndMetadata> bundle;
+        for (auto& tx : decoded) {
+            auto& txn = transactions[static_cast<int>(tx.position)];
             std::string* raw = txn.mutable_transaction_blob();
 
-            ripple::SerialIter it{raw->data(), raw->size()};
-            ripple::STTx const sttx{it};
+            LOG(log_.trace()) << "Inserting transaction = " << tx.hash;
 
-            LOG(log_.trace()) << "Inserting transaction = " << sttx.getTransactionID();
+            result.nfTokenTxData.insert(result.nfTokenTxData.end(), tx.nftTxs.begin(), tx.nftTxs.end());
+            if (tx.nft)
+                result.nfTokensData.push_back(std::move(*tx.nft));
 
-            ripple::TxMeta txMeta{sttx.getTransactionID(), ledger.seq, txn.metadata_blob()};
+            auto& accountTx = result.accountTxData.emplace_back(std::move(tx.accountTx));
+            if (backend_->storesAccountTransactionsInline()) {
+                accountTx.transaction = *raw;
+                accountTx.metadata = txn.metadata_blob();
+                accountTx.date = ledger.closeTime.time_since_epoch().count();
+            }
 
-            auto const [nftTxs, maybeNFT] = getNFTDataFromTx(txMeta, sttx);
-            result.nfTokenTxData.insert(result.nfTokenTxData.end(), nftTxs.begin(), nftTxs.end());
-            if (maybeNFT)
-                result.nfTokensData.push_back(*maybeNFT);
+            if (backend_->storesLedgerTransactionsBundle()) {
+                bundle.push_back(data::TransactionAndMetadata{
+                    data::Blob(raw->begin(), raw->end()),
+                    data::Blob(txn.metadata_blob().begin(), txn.metadata_blob().end()),
+                    ledger.seq,
+                    static_cast<std::uint32_t>(ledger.closeTime.time_since_epoch().count())
+                });
+            }
 
-            result.accountTxData.emplace_back(txMeta, sttx.getTransactionID());
             static constexpr std::size_t KEY_SIZE = 32;
-            std::string keyStr{reinterpret_cast<char const*>(sttx.getTransactionID().data()), KEY_SIZE};
+            std::string keyStr{reinterpret_cast<char const*>(tx.hash.data()), KEY_SIZE};
             backend_->writeTransaction(
                 std::move(keyStr),
                 ledger.seq,
@@ -122,6 +160,9 @@ public:
             );
         }
 
+        if (backend_->storesLedgerTransactionsBundle())
+            backend_->writeLedgerTransactionsBundle(ledger.seq, bundle);
+
         // Remove all but the last NFTsData for each id. unique removes all but the first of a group, so we want to
         // reverse sort by transaction index
         std::sort(result.nfTokensData.begin(), result.nfTokensData.end(), [](NFTsData const& a, NFTsData const& b) {
@@ -247,7 +288,14 @@ public:
             backend_->finishWrites(sequence);
         });
 
-        LOG(log_.debug()) << "Time to download and store ledger = " << timeDiff;
+        LOG(log_.info()) << "Time to first ledger = " << timeDiff << " seconds. Sequence = " << sequence;
+        PrometheusService::gaugeDouble(
+            "etl_time_to_first_ledger_seconds",
+            util::prometheus::Labels(),
+            "The time it took to download and store the first ledger in seconds"
+        )
+            .set(timeDiff);
+
         return lgrInfo;
     }
 };
@@ -21,6 +21,8 @@
 
 #include "data/BackendInterface.h"
 #include "etl/SystemState.h"
+#include "etl/impl/LedgerEvent.h"
+#include "etl/impl/LedgerEventServer.h"
 #include "feed/SubscriptionManager.h"
 #include "util/Assert.h"
 #include "util/LedgerUtils.h"
@@ -28,8 +30,12 @@
 
 #include <ripple/protocol/LedgerHeader.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <memory>
 #include <utility>
+#include <vector>
 
 namespace etl::detail {
 
@@ -42,7 +48,11 @@ namespace etl::detail {
  * calls, which can be slow. It is imperative however that the monitoring processes keep up with the writer, else the
  * monitoring processes will not be able to detect if the writer failed. Therefore, publishing each ledger (which
  * includes reading all of the transactions from the database) is done from the application wide asio io_service, and a
- * strand is used to ensure ledgers are published in order.
+ * strand is used to ensure ledgers are published in order. The per-transaction work of the transactions feed is done
+ * by the subscription workers, which preserve the order in which the transactions are handed over.
+ *
+ * Ledgers published together with their LedgerEvent are not read from the database at all. The ETL writer passes the
+ * events of the ledgers it writes on to read-only replicas through the LedgerEventServer.
  */
 template <typename SubscriptionManagerType, typename CacheType>
 class LedgerPublisher {
@@ -54,6 +64,7 @@ class LedgerPublisher {
     std::reference_wrapper<CacheType> cache_;
     std::shared_ptr<SubscriptionManagerType> subscriptions_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
+    std::shared_ptr<LedgerEventServer> eventServer_;
 
     std::chrono::time_point<ripple::NetClock> lastCloseTime_;
     mutable std::shared_mutex closeTimeMtx_;
@@ -67,19 +78,23 @@ class LedgerPublisher {
 public:
     /**
      * @brief Create an instance of the publisher
+     *
+     * @param eventServer Where to stream the ledgers written by this process to; nullptr to not stream them
      */
     LedgerPublisher(
         boost::asio::io_context& ioc,
         std::shared_ptr<BackendInterface> backend,
         CacheType& cache,
         std::shared_ptr<SubscriptionManagerType> subscriptions,
-        SystemState const& state
+        SystemState const& state,
+        std::shared_ptr<LedgerEventServer> eventServer = nullptr
     )
         : publishStrand_{boost::asio::make_strand(ioc)}
         , backend_{std::move(backend)}
         , cache_{cache}
         , subscriptions_{std::move(subscriptions)}
         , state_{std::cref(state)}
+        , eventServer_{std::move(eventServer)}
     {
     }
 
@@ -119,6 +134,8 @@ public:
             ASSERT(lgr.has_value(), "Ledger must exist in database. Ledger sequence = {}", ledgerSequence);
             publish(*lgr);
 
+            // older ledgers may have been backfilled by another instance meanwhile
+            backend_->updateRangeMin(range->minSequence);
             return true;
         }
         return false;
@@ -134,68 +151,34 @@ public:
     void
     publish(ripple::LedgerHeader const& lgrInfo)
     {
-        boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo]() {
-            LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
-
-            if (!state_.get().isWriting) {
-                LOG(log_.info()) << "Updating cache";
-
-                std::vector<data::LedgerObject> const diff = data::synchronousAndRetryOnTimeout([&](auto yield) {
-                    return backend_->fetchLedgerDiff(lgrInfo.seq, yield);
-                });
-
-                cache_.get().update(diff, lgrInfo.seq);
-                backend_->updateRange(lgrInfo.seq);
-            }
-
-            setLastClose(lgrInfo.closeTime);
-            auto age = lastCloseAgeSeconds();
-
-            // if the ledger closed over MAX_LEDGER_AGE_SECONDS ago, assume we are still catching up and don't publish
-            // TODO: this probably should be a strategy
-            static constexpr std::uint32_t MAX_LEDGER_AGE_SECONDS = 600;
-            if (age < MAX_LEDGER_AGE_SECONDS) {
-                std::optional<ripple::Fees> fees = data::synchronousAndRetryOnTimeout([&](auto yield) {
-                    return backend_->fetchFees(lgrInfo.seq, yield);
-                });
-                ASSERT(fees.has_value(), "Fees must exist for ledger {}", lgrInfo.seq);
-
-                std::vector<data::TransactionAndMetadata> transactions =
-                    data::synchronousAndRetryOnTimeout([&](auto yield) {
-                        return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
-                    });
-
-                auto const ledgerRange = backend_->fetchLedgerRange();
-                ASSERT(ledgerRange.has_value(), "Ledger range must exist");
-
-                std::string const range =
-                    std::to_string(ledgerRange->minSequence) + "-" + std::to_string(ledgerRange->maxSequence);
-
-                subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
-
-                // order with transaction index
-                std::sort(transactions.begin(), transactions.end(), [](auto const& t1, auto const& t2) {
-                    ripple::SerialIter iter1{t1.metadata.data(), t1.metadata.size()};
-                    ripple::STObject const object1(iter1, ripple::sfMetadata);
-                    ripple::SerialIter iter2{t2.metadata.data(), t2.metadata.size()};
-                    ripple::STObject const object2(iter2, ripple::sfMetadata);
-                    return object1.getFieldU32(ripple::sfTransactionIndex) <
-                        object2.getFieldU32(ripple::sfTransactionIndex);
-                });
-
-                for (auto& txAndMeta : transactions)
-                    subscriptions_->pubTransaction(txAndMeta, lgrInfo);
+        publish(lgrInfo, nullptr);
+    }
 
-                subscriptions_->pubBookChanges(lgrInfo, transactions);
+    /**
+     * @brief Publish a ledger this process just wrote to the database and stream it to the read-only replicas.
+     *
+     * @param event The written ledger
+     */
+    void
+    publish(LedgerEvent event)
+    {
+        auto const shared = std::make_shared<LedgerEvent const>(std::move(event));
+        if (eventServer_)
+            eventServer_->publish(shared);
 
-                setLastPublishTime();
-                LOG(log_.info()) << "Published ledger " << std::to_string(lgrInfo.seq);
-            } else
-                LOG(log_.info()) << "Skipping publishing ledger " << std::to_string(lgrInfo.seq);
-        });
+        publish(shared->header, shared);
+    }
 
-        // we track latest publish-requested seq, not necessarily already published
-        setLastPublishedSequence(lgrInfo.seq);
+    /**
+     * @brief Publish a ledger received from the ETL writer without reading it from the database.
+     *
+     * @param event The ledger to publish
+     */
+    void
+    publish(std::shared_ptr<LedgerEvent const> event)
+    {
+        auto const lgrInfo = event->header;
+        publish(lgrInfo, std::move(event));
     }
 
     /**
@@ -245,6 +228,84 @@ public:
     }
 
 private:
+    void
+    publish(ripple::LedgerHeader const& lgrInfo, std::shared_ptr<LedgerEvent const> event)
+    {
+        boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo, event = std::move(event)]() {
+            LOG(log_.info()) << "Publishing ledger " << std::to_string(lgrInfo.seq);
+            backend_->ledgerHeaderCache().put(lgrInfo);
+
+            if (!state_.get().isWriting) {
+                LOG(log_.info()) << "Updating cache";
+
+                std::vector<data::LedgerObject> const diff = event
+                    ? event->diff
+                    : data::synchronousAndRetryOnTimeout([&](auto yield) {
+                          return backend_->fetchLedgerDiff(lgrInfo.seq, yield);
+                      });
+
+                backend_->trustLineAggregates().update(diff, lgrInfo.seq, backend_->cache());
+                cache_.get().update(diff, lgrInfo.seq);
+                backend_->updateRange(lgrInfo.seq);
+            }
+
+            setLastClose(lgrInfo.closeTime);
+            auto age = lastCloseAgeSeconds();
+
+            // if the ledger closed over MAX_LEDGER_AGE_SECONDS ago, assume we are still catching up and don't publish
+            // TODO: this probably should be a strategy
+            static constexpr std::uint32_t MAX_LEDGER_AGE_SECONDS = 600;
+            if (age < MAX_LEDGER_AGE_SECONDS) {
+                std::optional<ripple::Fees> fees = data::synchronousAndRetryOnTimeout([&](auto yield) {
+                    return backend_->fetchFees(lgrInfo.seq, yield);
+                });
+                ASSERT(fees.has_value(), "Fees must exist for ledger {}", lgrInfo.seq);
+
+                std::vector<data::TransactionAndMetadata> transactions = event
+                    ? event->transactions
+                    : data::synchronousAndRetryOnTimeout([&](auto yield) {
+                          return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield);
+                      });
+
+                auto const ledgerRange = backend_->fetchLedgerRange();
+                ASSERT(ledgerRange.has_value(), "Ledger range must exist");
+
+                std::string const range =
+                    std::to_string(ledgerRange->minSequence) + "-" + std::to_string(ledgerRange->maxSequence);
+
+                subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
+
+                // order with transaction index; decode each metadata once instead of on every comparison
+                std::vector<std::pair<std::uint32_t, data::TransactionAndMetadata>> indexed;
+                indexed.reserve(transactions.size());
+                for (auto& txAndMeta : transactions) {
+                    ripple::SerialIter iter{txAndMeta.metadata.data(), txAndMeta.metadata.size()};
+                    ripple::STObject const object(iter, ripple::sfMetadata);
+                    indexed.emplace_back(object.getFieldU32(ripple::sfTransactionIndex), std::move(txAndMeta));
+                }
+                std::sort(indexed.begin(), indexed.end(), [](auto const& t1, auto const& t2) {
+                    return t1.first < t2.first;
+                });
+                std::transform(indexed.begin(), indexed.end(), transactions.begin(), [](auto& entry) {
+                    return std::move(entry.second);
+                });
+
+                // the feed prepares the messages in parallel but emits them in the order they are handed over here
+                for (auto& txAndMeta : transactions)
+                    subscriptions_->pubTransaction(txAndMeta, lgrInfo);
+
+                subscriptions_->pubBookChanges(lgrInfo, transactions);
+
+                setLastPublishTime();
+                LOG(log_.info()) << "Published ledger " << std::to_string(lgrInfo.seq);
+            } else
+                LOG(log_.info()) << "Skipping publishing ledger " << std::to_string(lgrInfo.seq);
+        });
+
+        // we track latest publish-requested seq, not necessarily already published
+        setLastPublishedSequence(lgrInfo.seq);
+    }
+
     void
     setLastClose(std::chrono::time_point<ripple::NetClock> lastCloseTime)
     {
@@ -0,0 +1,300 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SourceScheduler.h"
+
+#include "util/Assert.h"
+#include "util/Random.h"
+#include "util/prometheus/Label.h"
+#include "util/prometheus/Prometheus.h"
+
+#include <boost/json/object.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace etl::detail {
+
+namespace {
+
+using RequestClass = SourceScheduler::RequestClass;
+
+constexpr std::array REQUEST_CLASSES = {RequestClass::Fetch, RequestClass::Forward};
+
+std::size_t
+index(RequestClass requestClass)
+{
+    return static_cast<std::size_t>(requestClass);
+}
+
+char const*
+nameOf(RequestClass requestClass)
+{
+    return requestClass == RequestClass::Fetch ? "fetch" : "forward";
+}
+
+}  // namespace
+
+SourceScheduler::SourceScheduler(std::chrono::steady_clock::duration ejectionTime) : ejectionTime_(ejectionTime)
+{
+}
+
+void
+SourceScheduler::add(std::string const& name)
+{
+    using util::prometheus::Labels;
+
+    auto const gaugesOf = [&name](std::string const& gaugeName, std::string const& description) {
+        return std::array{
+            std::ref(PrometheusService::gaugeDouble(
+                gaugeName, Labels({{"source", name}, {"request", nameOf(RequestClass::Fetch)}}), description
+            )),
+            std::ref(PrometheusService::gaugeDouble(
+                gaugeName, Labels({{"source", name}, {"request", nameOf(RequestClass::Forward)}}), description
+            )),
+        };
+    };
+
+    std::scoped_lock const lck{mtx_};
+    sources_.push_back(SourceState{
+        .latencyMs = {},
+        .errorRate = 0.,
+        .inFlight = 0,
+        .consecutiveFailures = 0,
+        .fresh = true,
+        .ejectedUntil = {},
+        .scoreGauges = gaugesOf("etl_source_score", "The score of the ETL source, lower is better"),
+        .latencyGauges = gaugesOf(
+            "etl_source_latency_ms", "The moving average of the latency of requests to the ETL source in milliseconds"
+        ),
+        .errorRateGauge = PrometheusService::gaugeDouble(
+            "etl_source_error_rate",
+            Labels({{"source", name}}),
+            "The moving average of the share of failed requests to the ETL source"
+        ),
+        .inFlightGauge = PrometheusService::gaugeInt(
+            "etl_source_requests_in_flight_number",
+            Labels({{"source", name}}),
+            "The current number of requests sent to the ETL source"
+        ),
+        .ejectedGauge = PrometheusService::gaugeInt(
+            "etl_source_ejected", Labels({{"source", name}}), "Whether the ETL source is ejected for being unhealthy"
+        ),
+    });
+    report(sources_.back(), std::chrono::steady_clock::now());
+}
+
+void
+SourceScheduler::setFresh(std::size_t source, bool fresh)
+{
+    std::scoped_lock const lck{mtx_};
+    sources_.at(source).fresh = fresh;
+}
+
+std::size_t
+SourceScheduler::pick(std::vector<std::size_t>& candidates, RequestClass requestClass)
+{
+    ASSERT(not candidates.empty(), "There must be a source to pick from");
+    auto const now = std::chrono::steady_clock::now();
+
+    std::scoped_lock const lck{mtx_};
+
+    // ejected sources are only used when there is nothing else left
+    std::vector<std::size_t> healthy;
+    std::copy_if(candidates.cbegin(), candidates.cend(), std::back_inserter(healthy), [&](auto idx) {
+        return not ejected(sources_.at(idx), now);
+    });
+    auto const& choices = healthy.empty() ? candidates : healthy;
+
+    auto picked = choices[util::Random::uniform(0ul, choices.size() - 1)];
+    if (choices.size() > 1) {
+        auto other = choices[util::Random::uniform(0ul, choices.size() - 2)];
+        if (other == picked)
+            other = choices.back();
+
+        report(sources_.at(other), now);
+        if (scoreOf(sources_.at(other), requestClass) < scoreOf(sources_.at(picked), requestClass))
+            picked = other;
+    }
+    report(sources_.at(picked), now);
+
+    candidates.erase(std::find(candidates.begin(), candidates.end(), picked));
+    return picked;
+}
+
+void
+SourceScheduler::onStart(std::size_t source)
+{
+    std::scoped_lock const lck{mtx_};
+    auto& state = sources_.at(source);
+    ++state.inFlight;
+    report(state, std::chrono::steady_clock::now());
+}
+
+void
+SourceScheduler::onFinish(
+    std::size_t source,
+    bool success,
+    RequestClass requestClass,
+    std::optional<std::chrono::steady_clock::duration> latency
+)
+{
+    auto const now = std::chrono::steady_clock::now();
+
+    std::scoped_lock const lck{mtx_};
+    auto& state = sources_.at(source);
+    --state.inFlight;
+
+    if (success) {
+        state.consecutiveFailures = 0;
+        state.errorRate *= 1. - ERROR_WEIGHT;
+    } else {
+        ++state.consecutiveFailures;
+        state.errorRate = state.errorRate * (1. - ERROR_WEIGHT) + ERROR_WEIGHT;
+    }
+
+    if (latency) {
+        auto const ms = std::chrono::duration<double, std::milli>(*latency).count();
+        auto& average = state.latencyMs[index(requestClass)];
+        average = average == 0. ? ms : average * (1. - LATENCY_WEIGHT) + ms * LATENCY_WEIGHT;
+    }
+
+    if (not ejected(state, now) and
+        (state.consecutiveFailures >= MAX_CONSECUTIVE_FAILURES or isLatencyOutlier(source, requestClass, now)))
+        eject(state, now);
+
+    report(state, now);
+}
+
+double
+SourceScheduler::score(std::size_t source, RequestClass requestClass) const
+{
+    std::scoped_lock const lck{mtx_};
+    return scoreOf(sources_.at(source), requestClass);
+}
+
+bool
+SourceScheduler::isEjected(std::size_t source) const
+{
+    std::scoped_lock const lck{mtx_};
+    return ejected(sources_.at(source), std::chrono::steady_clock::now());
+}
+
+boost::json::object
+SourceScheduler::toJson(std::size_t source) const
+{
+    std::scoped_lock const lck{mtx_};
+    auto const& state = sources_.at(source);
+
+    boost::json::object score;
+    boost::json::object latencyMs;
+    for (auto const requestClass : REQUEST_CLASSES) {
+        score[nameOf(requestClass)] = scoreOf(state, requestClass);
+        latencyMs[nameOf(requestClass)] = state.latencyMs[index(requestClass)];
+    }
+
+    boost::json::object json{
+        {"error_rate", state.errorRate},
+        {"in_flight", state.inFlight},
+        {"fresh", state.fresh},
+        {"ejected", ejected(state, std::chrono::steady_clock::now())},
+    };
+    json["score"] = std::move(score);
+    json["latency_ms"] = std::move(latencyMs);
+
+    return json;
+}
+
+double
+SourceScheduler::scoreOf(SourceState const& state, RequestClass requestClass)
+{
+    auto const successRate = std::max(MIN_SUCCESS_RATE, 1. - state.errorRate);
+    auto const latencyMs = state.latencyMs[index(requestClass)];
+    auto const score = (latencyMs + LATENCY_PRIOR_MS) * static_cast<double>(state.inFlight + 1) / successRate;
+
+    return state.fresh ? score : score * STALE_PENALTY;
+}
+
+bool
+SourceScheduler::ejected(SourceState const& state, std::chrono::steady_clock::time_point now)
+{
+    return now < state.ejectedUntil;
+}
+
+bool
+SourceScheduler::isLatencyOutlier(
+    std::size_t source,
+    RequestClass requestClass,
+    std::chrono::steady_clock::time_point now
+) const
+{
+    // only latencies of the same class of requests are comparable
+    auto const latency = sources_.at(source).latencyMs[index(requestClass)];
+    if (sources_.size() < MIN_SOURCES_FOR_OUTLIERS or latency < MIN_OUTLIER_LATENCY_MS)
+        return false;
+
+    std::vector<double> others;
+    for (std::size_t idx = 0; idx < sources_.size(); ++idx) {
+        auto const otherLatency = sources_[idx].latencyMs[index(requestClass)];
+        if (idx != source and not ejected(sources_[idx], now) and otherLatency > 0.)
+            others.push_back(otherLatency);
+    }
+
+    if (others.size() + 1 < MIN_SOURCES_FOR_OUTLIERS)
+        return false;
+
+    auto const middle = others.begin() + static_cast<std::ptrdiff_t>(others.size() / 2);
+    std::nth_element(others.begin(), middle, others.end());
+
+    return latency > *middle * OUTLIER_FACTOR;
+}
+
+void
+SourceScheduler::eject(SourceState& state, std::chrono::steady_clock::time_point now)
+{
+    // the source starts over once it's back so that it isn't judged by the samples it was ejected for
+    state.ejectedUntil = now + ejectionTime_;
+    state.consecutiveFailures = 0;
+    state.errorRate = 0.;
+    state.latencyMs = {};
+}
+
+void
+SourceScheduler::report(SourceState& state, std::chrono::steady_clock::time_point now)
+{
+    for (auto const requestClass : REQUEST_CLASSES) {
+        state.scoreGauges[index(requestClass)].get().set(scoreOf(state, requestClass));
+        state.latencyGauges[index(requestClass)].get().set(state.latencyMs[index(requestClass)]);
+    }
+    state.errorRateGauge.get().set(state.errorRate);
+    state.inFlightGauge.get().set(static_cast<std::int64_t>(state.inFlight));
+    state.ejectedGauge.get().set(ejected(state, now) ? 1 : 0);
+}
+
+}  // namespace etl::detail
@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Gauge.h"
+
+#include <boost/json/object.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief Picks the ETL source each request is sent to.
+ *
+ * Sources are scored by their average latency, the requests they have in flight, their recent error rate and whether
+ * they have the latest validated ledger; lower is better. Latencies are kept per request class, as fetching a whole
+ * ledger takes much longer than a forwarded request. Each pick is the better of two randomly chosen sources (the
+ * power of two choices), which favours fast and idle sources without sending everything to the single best one.
+ * Sources failing repeatedly or much slower than the others are ejected for a while and only picked when no other
+ * source is left.
+ */
+class SourceScheduler {
+public:
+    static constexpr auto DEFAULT_EJECTION_TIME = std::chrono::seconds{30};
+
+    /**
+     * @brief The kinds of requests whose latencies are compared with each other: ledgers fetched for ETL and forwarded
+     * requests.
+     */
+    enum class RequestClass : std::size_t { Fetch, Forward };
+
+private:
+    // weights of a new sample in the latency average and in the error rate
+    static constexpr double LATENCY_WEIGHT = 0.2;
+    static constexpr double ERROR_WEIGHT = 0.1;
+
+    // sources without latency samples count as this fast; a low success rate multiplies the score by at most 1/min
+    static constexpr double LATENCY_PRIOR_MS = 1.;
+    static constexpr double MIN_SUCCESS_RATE = 0.05;
+    static constexpr double STALE_PENALTY = 4.;
+
+    // a source is ejected after this many failures in a row or if it's this much slower than the median of the others
+    static constexpr std::size_t MAX_CONSECUTIVE_FAILURES = 5;
+    static constexpr double OUTLIER_FACTOR = 5.;
+    static constexpr double MIN_OUTLIER_LATENCY_MS = 100.;
+    static constexpr std::size_t MIN_SOURCES_FOR_OUTLIERS = 3;
+
+    static constexpr std::size_t NUM_REQUEST_CLASSES = 2;
+
+    struct SourceState {
+        std::array<double, NUM_REQUEST_CLASSES> latencyMs{};
+        double errorRate = 0.;
+        std::size_t inFlight = 0;
+        std::size_t consecutiveFailures = 0;
+        bool fresh = true;
+        std::chrono::steady_clock::time_point ejectedUntil{};
+
+        std::array<std::reference_wrapper<util::prometheus::GaugeDouble>, NUM_REQUEST_CLASSES> scoreGauges;
+        std::array<std::reference_wrapper<util::prometheus::GaugeDouble>, NUM_REQUEST_CLASSES> latencyGauges;
+        std::reference_wrapper<util::prometheus::GaugeDouble> errorRateGauge;
+        std::reference_wrapper<util::prometheus::GaugeInt> inFlightGauge;
+        std::reference_wrapper<util::prometheus::GaugeInt> ejectedGauge;
+    };
+
+    std::chrono::steady_clock::duration ejectionTime_;
+
+    mutable std::mutex mtx_;
+    std::vector<SourceState> sources_;
+
+public:
+    /**
+     * @brief Construct a new scheduler without sources.
+     *
+     * @param ejectionTime How long failing or slow sources are avoided
+     */
+    explicit SourceScheduler(std::chrono::steady_clock::duration ejectionTime = DEFAULT_EJECTION_TIME);
+
+    /**
+     * @brief Add a source; sources are referred to by the order they were added in.
+     *
+     * @param name The name of the source in metrics
+     */
+    void
+    add(std::string const& name);
+
+    /**
+     * @brief Set whether a source has the latest ledger validated by the network.
+     *
+     * @param source The index of the source
+     * @param fresh true if the source has the latest validated ledger; false otherwise
+     */
+    void
+    setFresh(std::size_t source, bool fresh);
+
+    /**
+     * @brief Pick the source to try next.
+     *
+     * @param candidates Indexes of the sources to pick from, must not be empty; the picked one is removed
+     * @param requestClass The class of the request the source is picked for
+     * @return The index of the picked source
+     */
+    std::size_t
+    pick(std::vector<std::size_t>& candidates, RequestClass requestClass);
+
+    /**
+     * @brief Record that a request was sent to a source.
+     *
+     * @param source The index of the source
+     */
+    void
+    onStart(std::size_t source);
+
+    /**
+     * @brief Record the outcome of a request started with onStart.
+     *
+     * @param source The index of the source
+     * @param success Whether the request succeeded
+     * @param requestClass The class of the request
+     * @param latency The duration of the request; nullopt for requests not comparable to others (e.g. full downloads)
+     */
+    void
+    onFinish(
+        std::size_t source,
+        bool success,
+        RequestClass requestClass,
+        std::optional<std::chrono::steady_clock::duration> latency
+    );
+
+    /**
+     * @param source The index of the source
+     * @param requestClass The class of the request the source would be picked for
+     * @return The score of the source; lower is better
+     */
+    double
+    score(std::size_t source, RequestClass requestClass) const;
+
+    /**
+     * @param source The index of the source
+     * @return true if the source is ejected; false otherwise
+     */
+    bool
+    isEjected(std::size_t source) const;
+
+    /**
+     * @param source The index of the source
+     * @return JSON representation of the scheduling state of the source
+     */
+    boost::json::object
+    toJson(std::size_t source) const;
+
+private:
+    static double
+    scoreOf(SourceState const& state, RequestClass requestClass);
+
+    static bool
+    ejected(SourceState const& state, std::chrono::steady_clock::time_point now);
+
+    bool
+    isLatencyOutlier(std::size_t source, RequestClass requestClass, std::chrono::steady_clock::time_point now) const;
+
+    void
+    eject(SourceState& state, std::chrono::steady_clock::time_point now);
+
+    static void
+    report(SourceState& state, std::chrono::steady_clock::time_point now);
+};
+
+}  // namespace etl::detail
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/TransactionDecoder.h"
+
+#include "data/DBHelpers.h"
+#include "etl/NFTHelpers.h"
+
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/Serializer.h>
+#include <ripple/protocol/TxMeta.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <latch>
+#include <vector>
+
+namespace etl::detail {
+
+namespace {
+
+DecodedTransaction
+decodeTransaction(std::uint32_t ledgerSequence, TransactionDecoder::RawTransaction const& raw, std::size_t position)
+{
+    ripple::SerialIter txIter{raw.transaction.data(), raw.transaction.size()};
+    ripple::STTx const sttx{txIter};
+    auto const hash = sttx.getTransactionID();
+
+    ripple::SerialIter metaIter{raw.metadata.data(), raw.metadata.size()};
+    ripple::TxMeta txMeta{hash, ledgerSequence, ripple::STObject{metaIter, ripple::sfMetadata}};
+
+    auto [nftTxs, nft] = getNFTDataFromTx(txMeta, sttx);
+    return DecodedTransaction{
+        .position = position,
+        .hash = hash,
+        .accountTx = AccountTransactionsData{txMeta, hash},
+        .nftTxs = std::move(nftTxs),
+        .nft = std::move(nft),
+    };
+}
+
+}  // namespace
+
+TransactionDecoder::TransactionDecoder(std::size_t numThreads) : numThreads_(std::max<std::size_t>(numThreads, 1))
+{
+    if (numThreads_ > 1)
+        pool_.emplace(numThreads_ - 1);
+}
+
+TransactionDecoder::~TransactionDecoder()
+{
+    if (pool_)
+        pool_->join();
+}
+
+std::vector<DecodedTransaction>
+TransactionDecoder::decode(std::uint32_t ledgerSequence, std::vector<RawTransaction> const& transactions)
+{
+    std::vector<DecodedTransaction> decoded(transactions.size());
+
+    auto const numChunks = std::clamp<std::size_t>(transactions.size() / MIN_CHUNK_SIZE, 1, numThreads_);
+    auto const chunkSize = (transactions.size() + numChunks - 1) / numChunks;
+    std::vector<std::exception_ptr> errors(numChunks);
+
+    auto const decodeChunk = [&](std::size_t chunk) {
+        try {
+            auto const end = std::min(transactions.size(), (chunk + 1) * chunkSize);
+            for (auto i = chunk * chunkSize; i < end; ++i)
+                decoded[i] = decodeTransaction(ledgerSequence, transactions[i], i);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    if (numChunks == 1) {
+        decodeChunk(0);
+    } else {
+        std::latch done{static_cast<std::ptrdiff_t>(numChunks - 1)};
+        for (std::size_t chunk = 1; chunk < numChunks; ++chunk) {
+            boost::asio::post(*pool_, [&decodeChunk, &done, chunk]() {
+                decodeChunk(chunk);
+                done.count_down();
+            });
+        }
+
+        decodeChunk(0);
+        done.wait();
+    }
+
+    for (auto const& error : errors) {
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    std::sort(decoded.begin(), decoded.end(), [](auto const& lhs, auto const& rhs) {
+        return lhs.accountTx.transactionIndex < rhs.accountTx.transactionIndex;
+    });
+
+    return decoded;
+}
+
+}  // namespace etl::detail
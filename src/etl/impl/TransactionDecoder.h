@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/DBHelpers.h"
+
+#include <boost/asio/thread_pool.hpp>
+#include <ripple/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace etl::detail {
+
+/**
+ * @brief A transaction of a new ledger with the data extracted from it for the account and NFT indexes.
+ */
+struct DecodedTransaction {
+    std::size_t position = 0;  ///< Position of the transaction in the data it was decoded from
+    ripple::uint256 hash;
+    AccountTransactionsData accountTx;
+    std::vector<NFTTransactionsData> nftTxs;
+    std::optional<NFTsData> nft;
+};
+
+/**
+ * @brief Decodes the transactions of a new ledger on a small pool of threads.
+ *
+ * Transactions are split into contiguous chunks decoded in parallel; the calling thread decodes one of them. Small
+ * ledgers are decoded on the calling thread only.
+ */
+class TransactionDecoder {
+public:
+    static constexpr std::size_t DEFAULT_NUM_THREADS = 4;
+
+    /**
+     * @brief A serialized transaction and its metadata.
+     */
+    struct RawTransaction {
+        std::string_view transaction;
+        std::string_view metadata;
+    };
+
+private:
+    // fewer transactions per chunk are not worth handing over to another thread
+    static constexpr std::size_t MIN_CHUNK_SIZE = 16;
+
+    std::size_t numThreads_;
+    std::optional<boost::asio::thread_pool> pool_;
+
+public:
+    /**
+     * @brief Construct a new decoder.
+     *
+     * @param numThreads The number of threads decoding a ledger, including the calling one; 1 disables the pool
+     */
+    explicit TransactionDecoder(std::size_t numThreads = DEFAULT_NUM_THREADS);
+
+    ~TransactionDecoder();
+
+    TransactionDecoder(TransactionDecoder const&) = delete;
+    TransactionDecoder&
+    operator=(TransactionDecoder const&) = delete;
+
+    /**
+     * @brief Decode the transactions of a ledger.
+     *
+     * @param ledgerSequence The sequence of the ledger
+     * @param transactions The transactions of the ledger in any order
+     * @return The decoded transactions ordered by their index in the ledger
+     * @throws std::exception if a transaction or its metadata is malformed
+     */
+    std::vector<DecodedTransaction>
+    decode(std::uint32_t ledgerSequence, std::vector<RawTransaction> const& transactions);
+};
+
+}  // namespace etl::detail
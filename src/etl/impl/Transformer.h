@@ -22,6 +22,7 @@
 #include "data/BackendInterface.h"
 #include "etl/SystemState.h"
 #include "etl/impl/AmendmentBlock.h"
+#include "etl/impl/LedgerEvent.h"
 #include "etl/impl/LedgerLoader.h"
 #include "util/Assert.h"
 #include "util/LedgerUtils.h"
@@ -32,10 +33,15 @@
 #include <ripple/beast/core/CurrentThreadName.h>
 #include <ripple/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <set>
+#include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 namespace etl::detail {
 
@@ -138,7 +144,8 @@ private:
                 continue;
 
             auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            auto [event, success] = buildNextLedger(*fetchResponse);
+            auto const& lgrInfo = event.header;
 
             if (success) {
                 auto const numTxns = fetchResponse->transactions_list().transactions_size();
@@ -153,7 +160,7 @@ private:
                                  << ". load objs per second = " << numObjects / duration;
 
                 // success is false if the ledger was already written
-                publisher_.get().publish(lgrInfo);
+                publisher_.get().publish(std::move(event));
             } else {
                 LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
             }
@@ -167,9 +174,9 @@ private:
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
      *
      * @param rawData Data extracted from an ETL source
-     * @return The newly built ledger and data to write to the database
+     * @return The newly built ledger with its diff and transactions, and whether it was written to the database
      */
-    std::pair<ripple::LedgerHeader, bool>
+    std::pair<LedgerEvent, bool>
     buildNextLedger(GetLedgerResponseType& rawData)
     {
         LOG(log_.debug()) << "Beginning ledger update";
@@ -180,19 +187,22 @@ private:
         backend_->writeLedger(lgrInfo, std::move(*rawData.mutable_ledger_header()));
 
         writeSuccessors(lgrInfo, rawData);
+        LedgerEvent event{.header = lgrInfo, .diff = {}, .transactions = {}};
         std::optional<FormattedTransactionsData> insertTxResultOp;
         try {
-            updateCache(lgrInfo, rawData);
+            event.diff = updateCache(lgrInfo, rawData);
 
             LOG(log_.debug()) << "Inserted/modified/deleted all objects. Number of objects = "
                               << rawData.ledger_objects().objects_size();
 
+            // copied before insertTransactions moves the blobs into the database writes
+            event.transactions = copyTransactions(lgrInfo, rawData);
             insertTxResultOp.emplace(loader_.get().insertTransactions(lgrInfo, rawData));
         } catch (std::runtime_error const& e) {
             LOG(log_.fatal()) << "Failed to build next ledger: " << e.what();
 
             amendmentBlockHandler_.get().onAmendmentBlock();
-            return {ripple::LedgerHeader{}, false};
+            return {LedgerEvent{}, false};
         }
 
         LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = "
@@ -208,7 +218,7 @@ private:
         LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
         LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
 
-        return {lgrInfo, success};
+        return {std::move(event), success};
     }
 
     /**
@@ -216,8 +226,9 @@ private:
      *
      * @param lgrInfo Ledger info
      * @param rawData Ledger data from GRPC
+     * @return The objects created, modified or deleted in the ledger
      */
-    void
+    std::vector<data::LedgerObject>
     updateCache(ripple::LedgerHeader const& lgrInfo, GetLedgerResponseType& rawData)
     {
         std::vector<data::LedgerObject> cacheUpdates;
@@ -227,6 +238,9 @@ private:
         std::set<ripple::uint256> bookSuccessorsToCalculate;
         std::set<ripple::uint256> modified;
 
+        // book directories created or deleted in this ledger along with whether they were deleted
+        std::vector<std::pair<ripple::uint256, bool>> bookDirs;
+
         for (auto& obj : *(rawData.mutable_ledger_objects()->mutable_objects())) {
             auto key = ripple::uint256::fromVoidChecked(obj.key());
             ASSERT(key.has_value(), "Failed to deserialize key from void");
@@ -254,24 +268,7 @@ private:
 
                 if (checkBookBase) {
                     LOG(log_.debug()) << "Is book dir. Key = " << ripple::strHex(*key);
-
-                    auto const bookBase = getBookBase(*key);
-                    auto const oldFirstDir = backend_->cache().getSuccessor(bookBase, lgrInfo.seq - 1);
-                    ASSERT(
-                        oldFirstDir.has_value(),
-                        "Book base must have a successor for lgrInfo.seq - 1 = {}",
-                        lgrInfo.seq - 1
-                    );
-
-                    // We deleted the first directory, or we added a directory prior to the old first
-                    // directory
-                    if ((isDeleted && key == oldFirstDir->key) || (!isDeleted && key < oldFirstDir->key)) {
-                        LOG(log_.debug())
-                            << "Need to recalculate book base successor. base = " << ripple::strHex(bookBase)
-                            << " - key = " << ripple::strHex(*key) << " - isDeleted = " << isDeleted
-                            << " - seq = " << lgrInfo.seq;
-                        bookSuccessorsToCalculate.insert(bookBase);
-                    }
+                    bookDirs.emplace_back(*key, isDeleted);
                 }
             }
 
@@ -281,6 +278,40 @@ private:
             backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
         }
 
+        if (!bookDirs.empty()) {
+            std::vector<ripple::uint256> bookBases;
+            bookBases.reserve(bookDirs.size());
+            for (auto const& [key, _] : bookDirs)
+                bookBases.push_back(getBookBase(key));
+
+            std::ranges::sort(bookBases);
+            bookBases.erase(std::unique(bookBases.begin(), bookBases.end()), bookBases.end());
+
+            auto const oldNeighbors = backend_->cache().getNeighbors(bookBases, lgrInfo.seq - 1);
+            ASSERT(oldNeighbors.has_value(), "Cache must serve lgrInfo.seq - 1 = {}", lgrInfo.seq - 1);
+
+            for (auto const& [key, isDeleted] : bookDirs) {
+                auto const bookBase = getBookBase(key);
+                auto const pos = std::ranges::lower_bound(bookBases, bookBase) - bookBases.begin();
+                auto const& oldFirstDir = (*oldNeighbors)[pos].successor;
+                ASSERT(
+                    oldFirstDir.has_value(),
+                    "Book base must have a successor for lgrInfo.seq - 1 = {}",
+                    lgrInfo.seq - 1
+                );
+
+                // We deleted the first directory, or we added a directory prior to the old first
+                // directory
+                if ((isDeleted && key == *oldFirstDir) || (!isDeleted && key < *oldFirstDir)) {
+                    LOG(log_.debug()) << "Need to recalculate book base successor. base = "
+                                      << ripple::strHex(bookBase) << " - key = " << ripple::strHex(key)
+                                      << " - isDeleted = " << isDeleted << " - seq = " << lgrInfo.seq;
+                    bookSuccessorsToCalculate.insert(bookBase);
+                }
+            }
+        }
+
+        backend_->trustLineAggregates().update(cacheUpdates, lgrInfo.seq, backend_->cache());
         backend_->cache().update(cacheUpdates, lgrInfo.seq);
 
         // rippled didn't send successor information, so use our cache
@@ -289,47 +320,104 @@ private:
             if (!backend_->cache().isFull() || backend_->cache().latestLedgerSequence() != lgrInfo.seq)
                 throw std::logic_error("Cache is not full, but object neighbors were not included");
 
-            for (auto const& obj : cacheUpdates) {
-                if (modified.contains(obj.key))
-                    continue;
+            writeSuccessorsFromCache(lgrInfo.seq, cacheUpdates, modified, bookSuccessorsToCalculate);
+        }
 
-                auto lb = backend_->cache().getPredecessor(obj.key, lgrInfo.seq);
-                if (!lb)
-                    lb = {data::firstKey, {}};
+        return cacheUpdates;
+    }
 
-                auto ub = backend_->cache().getSuccessor(obj.key, lgrInfo.seq);
-                if (!ub)
-                    ub = {data::lastKey, {}};
+    /**
+     * @brief Write the successors of created and deleted objects and of changed book bases using the cache.
+     *
+     * The neighbors of all these keys are looked up in the cache at once.
+     *
+     * @param seq The sequence of the ledger; the cache must already hold it
+     * @param cacheUpdates The objects created, modified or deleted in the ledger
+     * @param modified The keys of the modified objects
+     * @param bookBases The book bases whose first directory changed
+     */
+    void
+    writeSuccessorsFromCache(
+        uint32_t const seq,
+        std::vector<data::LedgerObject> const& cacheUpdates,
+        std::set<ripple::uint256> const& modified,
+        std::set<ripple::uint256> const& bookBases
+    )
+    {
+        std::vector<ripple::uint256> keys;
+        keys.reserve(cacheUpdates.size() + bookBases.size());
+        for (auto const& obj : cacheUpdates) {
+            if (!modified.contains(obj.key))
+                keys.push_back(obj.key);
+        }
+        keys.insert(keys.end(), bookBases.begin(), bookBases.end());
 
-                if (obj.blob.empty()) {
-                    LOG(log_.debug()) << "writing successor for deleted object " << ripple::strHex(obj.key) << " - "
-                                      << ripple::strHex(lb->key) << " - " << ripple::strHex(ub->key);
+        std::ranges::sort(keys);
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
 
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(ub->key));
-                } else {
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(obj.key));
-                    backend_->writeSuccessor(uint256ToString(obj.key), lgrInfo.seq, uint256ToString(ub->key));
+        auto const neighbors = backend_->cache().getNeighbors(keys, seq);
+        if (!neighbors)
+            throw std::logic_error("Cache is not full, but object neighbors were not included");
 
-                    LOG(log_.debug()) << "writing successor for new object " << ripple::strHex(lb->key) << " - "
-                                      << ripple::strHex(obj.key) << " - " << ripple::strHex(ub->key);
-                }
-            }
+        auto const neighborsOf = [&](ripple::uint256 const& key) -> data::LedgerCache::Neighbors const& {
+            return (*neighbors)[std::ranges::lower_bound(keys, key) - keys.begin()];
+        };
 
-            for (auto const& base : bookSuccessorsToCalculate) {
-                auto succ = backend_->cache().getSuccessor(base, lgrInfo.seq);
-                if (succ) {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(succ->key));
+        for (auto const& obj : cacheUpdates) {
+            if (modified.contains(obj.key))
+                continue;
 
-                    LOG(log_.debug()) << "Updating book successor " << ripple::strHex(base) << " - "
-                                      << ripple::strHex(succ->key);
-                } else {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(data::lastKey));
+            auto const& [predecessor, successor] = neighborsOf(obj.key);
+            auto const lb = predecessor.value_or(data::firstKey);
+            auto const ub = successor.value_or(data::lastKey);
 
-                    LOG(log_.debug()) << "Updating book successor " << ripple::strHex(base) << " - "
-                                      << ripple::strHex(data::lastKey);
-                }
+            if (obj.blob.empty()) {
+                LOG(log_.debug()) << "writing successor for deleted object " << ripple::strHex(obj.key) << " - "
+                                  << ripple::strHex(lb) << " - " << ripple::strHex(ub);
+
+                backend_->writeSuccessor(uint256ToString(lb), seq, uint256ToString(ub));
+            } else {
+                backend_->writeSuccessor(uint256ToString(lb), seq, uint256ToString(obj.key));
+                backend_->writeSuccessor(uint256ToString(obj.key), seq, uint256ToString(ub));
+
+                LOG(log_.debug()) << "writing successor for new object " << ripple::strHex(lb) << " - "
+                                  << ripple::strHex(obj.key) << " - " << ripple::strHex(ub);
             }
         }
+
+        for (auto const& base : bookBases) {
+            auto const succ = neighborsOf(base).successor.value_or(data::lastKey);
+            backend_->writeSuccessor(uint256ToString(base), seq, uint256ToString(succ));
+
+            LOG(log_.debug()) << "Updating book successor " << ripple::strHex(base) << " - " << ripple::strHex(succ);
+        }
+    }
+
+    /**
+     * @brief Copy the transactions of a new ledger.
+     *
+     * @param lgrInfo Ledger info
+     * @param rawData Ledger data from GRPC
+     * @return The transactions with their metadata
+     */
+    static std::vector<data::TransactionAndMetadata>
+    copyTransactions(ripple::LedgerHeader const& lgrInfo, GetLedgerResponseType const& rawData)
+    {
+        std::vector<data::TransactionAndMetadata> transactions;
+        transactions.reserve(rawData.transactions_list().transactions_size());
+
+        for (auto const& txn : rawData.transactions_list().transactions()) {
+            auto const& raw = txn.transaction_blob();
+            auto const& metadata = txn.metadata_blob();
+            transactions.emplace_back(
+                data::Blob(raw.begin(), raw.end()),
+                data::Blob(metadata.begin(), metadata.end()),
+                lgrInfo.seq,
+                static_cast<std::uint32_t>(lgrInfo.closeTime.time_since_epoch().count())
+            );
+        }
+
+        return transactions;
     }
 
     /**
@@ -20,6 +20,7 @@
 #include "feed/SubscriptionManager.h"
 
 #include "data/Types.h"
+#include "feed/TransactionFilter.h"
 #include "feed/Types.h"
 
 #include <boost/asio/spawn.hpp>
@@ -30,7 +31,10 @@
 #include <ripple/protocol/LedgerHeader.h>
 
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace feed {
@@ -145,9 +149,14 @@ SubscriptionManager::forwardValidation(boost::json::object const& validationJson
 }
 
 void
-SubscriptionManager::subTransactions(SubscriberSharedPtr const& subscriber, std::uint32_t const apiVersion)
+SubscriptionManager::subTransactions(
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
+)
 {
-    transactionFeed_.sub(subscriber, apiVersion);
+    transactionFeed_.sub(subscriber, apiVersion, sinceLedger, std::move(filter));
 }
 
 void
@@ -160,10 +169,12 @@ void
 SubscriptionManager::subAccount(
     ripple::AccountID const& account,
     SubscriberSharedPtr const& subscriber,
-    std::uint32_t const apiVersion
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
 )
 {
-    transactionFeed_.sub(account, subscriber, apiVersion);
+    transactionFeed_.sub(account, subscriber, apiVersion, sinceLedger, std::move(filter));
 }
 
 void
@@ -176,10 +187,24 @@ void
 SubscriptionManager::subBook(
     ripple::Book const& book,
     SubscriberSharedPtr const& subscriber,
-    std::uint32_t const apiVersion
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
 )
 {
-    transactionFeed_.sub(book, subscriber, apiVersion);
+    transactionFeed_.sub(book, subscriber, apiVersion, sinceLedger, std::move(filter));
+}
+
+bool
+SubscriptionManager::canReplayTransactions(std::uint32_t const sinceLedger) const
+{
+    return transactionFeed_.canReplay(sinceLedger);
+}
+
+void
+SubscriptionManager::replayTransactions(SubscriberSharedPtr const& subscriber)
+{
+    transactionFeed_.replay(subscriber);
 }
 
 void
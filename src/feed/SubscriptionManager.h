@@ -21,6 +21,7 @@
 
 #include "data/BackendInterface.h"
 #include "data/Types.h"
+#include "feed/TransactionFilter.h"
 #include "feed/Types.h"
 #include "feed/impl/BookChangesFeed.h"
 #include "feed/impl/ForwardFeed.h"
@@ -38,9 +39,11 @@
 #include <ripple/protocol/Fees.h>
 #include <ripple/protocol/LedgerHeader.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -59,9 +62,18 @@ class SubscriptionManager {
     impl::ProposedTransactionFeed proposedTransactionFeed_;
 
 public:
+    /**
+     * @brief Construct a new Subscription Manager object
+     * @param ioContext The io_context the feeds are published on.
+     * @param backend The backend.
+     * @param replayLedgers The number of most recent ledgers kept for resuming transaction subscriptions.
+     * @param replayBytes The maximum total size of the messages kept for resuming transaction subscriptions.
+     */
     SubscriptionManager(
         boost::asio::io_context& ioContext,
-        std::shared_ptr<data::BackendInterface const> const& backend
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        std::size_t replayLedgers = impl::TransactionFeed::DEFAULT_REPLAY_LEDGERS,
+        std::size_t replayBytes = impl::TransactionFeed::DEFAULT_REPLAY_BYTES
     )
         : ioContext_(ioContext)
         , backend_(backend)
@@ -69,7 +81,7 @@ public:
         , validationsFeed_(ioContext, "validations")
         , ledgerFeed_(ioContext)
         , bookChangesFeed_(ioContext)
-        , transactionFeed_(ioContext)
+        , transactionFeed_(ioContext, replayLedgers, replayBytes)
         , proposedTransactionFeed_(ioContext)
     {
     }
@@ -209,9 +221,18 @@ public:
      * @brief Subscribe to the transactions feed.
      * @param subscriber
      * @param apiVersion The api version of feed to subscribe.
+     * @param sinceLedger If set, the subscription is made on the next replayTransactions call, after sending the
+     * buffered transactions of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    subTransactions(SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    subTransactions(
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr
+    );
 
     /**
      * @brief Unsubscribe to the transactions feed.
@@ -225,9 +246,19 @@ public:
      * @param account The account to watch.
      * @param subscriber
      * @param apiVersion The api version of feed to subscribe.
+     * @param sinceLedger If set, the subscription is made on the next replayTransactions call, after sending the
+     * buffered transactions of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    subAccount(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    subAccount(
+        ripple::AccountID const& account,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr
+    );
 
     /**
      * @brief Unsubscribe to the transactions feed for particular account.
@@ -241,9 +272,19 @@ public:
      * @param book The book to watch.
      * @param subscriber
      * @param apiVersion The api version of feed to subscribe.
+     * @param sinceLedger If set, the subscription is made on the next replayTransactions call, after sending the
+     * buffered transactions of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    subBook(ripple::Book const& book, SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    subBook(
+        ripple::Book const& book,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr
+    );
 
     /**
      * @brief Unsubscribe to the transactions feed for particular order book.
@@ -253,6 +294,24 @@ public:
     void
     unsubBook(ripple::Book const& book, SubscriberSharedPtr const& subscriber);
 
+    /**
+     * @brief Check whether transaction subscriptions can be resumed after the given ledger.
+     * @param sinceLedger The last ledger the subscriber has received completely.
+     * @return true if all transactions published after this ledger are still buffered; false otherwise
+     */
+    bool
+    canReplayTransactions(std::uint32_t sinceLedger) const;
+
+    /**
+     * @brief Make the subscriptions the subscriber requested with a sinceLedger and replay the buffered transactions.
+     *
+     * Called once all subscriptions of a request are requested, so that each transaction is sent once and in order.
+     *
+     * @param subscriber
+     */
+    void
+    replayTransactions(SubscriberSharedPtr const& subscriber);
+
     /**
      * @brief Forward the transactions feed.
      * @param txMeta The transaction and metadata.
@@ -293,9 +352,17 @@ class SubscriptionManagerRunner {
         boost::asio::make_work_guard(ioContext_);
     std::vector<std::thread> workers_;
 
+    static constexpr uint64_t DEFAULT_REPLAY_LEDGERS = impl::TransactionFeed::DEFAULT_REPLAY_LEDGERS;
+    static constexpr uint64_t DEFAULT_REPLAY_SIZE_MB = impl::TransactionFeed::DEFAULT_REPLAY_BYTES / (1024 * 1024);
+
 public:
     SubscriptionManagerRunner(util::Config const& config, std::shared_ptr<data::BackendInterface> const& backend)
-        : subscriptionManager_(std::make_shared<SubscriptionManager>(ioContext_, backend))
+        : subscriptionManager_(std::make_shared<SubscriptionManager>(
+              ioContext_,
+              backend,
+              config.valueOr<uint64_t>("subscription_replay.max_ledgers", DEFAULT_REPLAY_LEDGERS),
+              config.valueOr<uint64_t>("subscription_replay.max_size_mb", DEFAULT_REPLAY_SIZE_MB) * 1024 * 1024
+          ))
     {
         auto numThreads = config.valueOr<uint64_t>("subscription_workers", 1);
         LOG(logger_.info()) << "Starting subscription manager with " << numThreads << " workers";
@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/TransactionFilter.h"
+
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <optional>
+#include <unordered_set>
+#include <utility>
+
+namespace feed {
+
+TransactionFilter::TransactionFilter(
+    std::unordered_set<ripple::TxType> types,
+    std::unordered_set<ripple::TERUnderlyingType> results,
+    std::optional<ripple::Currency> currency,
+    std::optional<ripple::AccountID> issuer,
+    std::optional<ripple::STAmount> minDeliveredAmount
+)
+    : types_(std::move(types))
+    , results_(std::move(results))
+    , currency_(std::move(currency))
+    , issuer_(std::move(issuer))
+    , minDeliveredAmount_(std::move(minDeliveredAmount))
+{
+}
+
+bool
+TransactionFilter::matches(Fields const& fields) const
+{
+    if (not types_.empty() and not types_.contains(fields.type))
+        return false;
+
+    if (not results_.empty() and not results_.contains(ripple::TERtoInt(fields.result)))
+        return false;
+
+    if (not currency_ and not issuer_ and not minDeliveredAmount_)
+        return true;
+
+    // the remaining conditions are about the delivered amount, so transactions not delivering anything never match
+    if (not fields.deliveredAmount)
+        return false;
+
+    auto const& delivered = *fields.deliveredAmount;
+    if (currency_ and delivered.getCurrency() != *currency_)
+        return false;
+
+    if (issuer_ and (delivered.native() or delivered.getIssuer() != *issuer_))
+        return false;
+
+    // amounts of different currencies are not comparable
+    if (minDeliveredAmount_ and
+        (delivered.getCurrency() != minDeliveredAmount_->getCurrency() or delivered < *minDeliveredAmount_))
+        return false;
+
+    return true;
+}
+
+}  // namespace feed
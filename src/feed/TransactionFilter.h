@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <optional>
+#include <unordered_set>
+
+namespace feed {
+
+/**
+ * @brief A server side filter for the transaction feeds.
+ *
+ * The filter is built once when a client subscribes and then checked against every published transaction before
+ * anything is sent to that client. Every condition that is set must match; an empty filter matches everything.
+ */
+class TransactionFilter {
+public:
+    /**
+     * @brief The fields of a transaction the filter is evaluated against; extracted once per published transaction.
+     */
+    struct Fields {
+        ripple::TxType type;
+        ripple::TER result;
+        std::optional<ripple::STAmount> deliveredAmount;
+    };
+
+private:
+    std::unordered_set<ripple::TxType> types_;
+    std::unordered_set<ripple::TERUnderlyingType> results_;
+    std::optional<ripple::Currency> currency_;
+    std::optional<ripple::AccountID> issuer_;
+    std::optional<ripple::STAmount> minDeliveredAmount_;
+
+public:
+    /**
+     * @brief Construct a new Transaction Filter object
+     *
+     * @param types The accepted transaction types; empty accepts all
+     * @param results The accepted engine results; empty accepts all
+     * @param currency If set, only transactions delivering this currency are accepted
+     * @param issuer If set, only transactions delivering an amount issued by this account are accepted
+     * @param minDeliveredAmount If set, only transactions delivering at least this amount are accepted. Must be of the
+     * same currency as @p currency
+     */
+    TransactionFilter(
+        std::unordered_set<ripple::TxType> types,
+        std::unordered_set<ripple::TERUnderlyingType> results,
+        std::optional<ripple::Currency> currency,
+        std::optional<ripple::AccountID> issuer,
+        std::optional<ripple::STAmount> minDeliveredAmount
+    );
+
+    /**
+     * @brief Check whether a transaction passes the filter.
+     *
+     * @param fields The fields of the transaction
+     * @return true if the transaction should be sent to the subscriber; false otherwise
+     */
+    [[nodiscard]] bool
+    matches(Fields const& fields) const;
+};
+
+}  // namespace feed
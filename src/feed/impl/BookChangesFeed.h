@@ -24,7 +24,7 @@
 #include "rpc/BookChangesHelper.h"
 
 #include <boost/asio/io_context.hpp>
-#include <boost/json/serialize.hpp>
+#include <boost/json/object.hpp>
 #include <ripple/protocol/LedgerHeader.h>
 
 #include <vector>
@@ -49,7 +49,7 @@ struct BookChangesFeed : public SingleFeedBase {
     void
     pub(ripple::LedgerHeader const& lgrInfo, std::vector<data::TransactionAndMetadata> const& transactions) const
     {
-        SingleFeedBase::pub(boost::json::serialize(rpc::computeBookChanges(lgrInfo, transactions)));
+        SingleFeedBase::pub(rpc::computeBookChanges(lgrInfo, transactions));
     }
 };
 }  // namespace feed::impl
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "feed/Types.h"
+#include "util/MsgPack.h"
+#include "web/interface/ConnectionBase.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace feed::impl {
+
+/**
+ * @brief A feed message shared by all subscribers, serialized at most once per wire format.
+ *
+ * The json text is produced right away; the MessagePack encoding only when the first subscriber asking for it is
+ * notified. Not thread safe, must only be used from the strand of the feed that publishes it.
+ */
+class FeedMessage {
+    std::optional<boost::json::object> json_;
+    std::shared_ptr<std::string> text_;
+    mutable std::shared_ptr<std::string> msgPack_;
+
+public:
+    /**
+     * @brief Construct a message that can be sent in every wire format.
+     * @param json The message.
+     */
+    explicit FeedMessage(boost::json::object json)
+        : json_(std::move(json)), text_(std::make_shared<std::string>(boost::json::serialize(*json_)))
+    {
+    }
+
+    /**
+     * @brief Construct a message that is available as text only; MessagePack subscribers receive the text as well.
+     * @param text The serialized message.
+     */
+    explicit FeedMessage(std::string text) : text_(std::make_shared<std::string>(std::move(text)))
+    {
+    }
+
+    /**
+     * @brief Send the message to the subscriber in the format it negotiated.
+     * @param subscriber The subscriber to send to.
+     */
+    void
+    sendTo(Subscriber& subscriber) const
+    {
+        if (subscriber.feedFormat == web::FeedFormat::MsgPack and json_.has_value()) {
+            if (not msgPack_)
+                msgPack_ = std::make_shared<std::string>(util::toMsgPack(*json_));
+
+            subscriber.sendBinary(msgPack_);
+            return;
+        }
+
+        subscriber.send(text_);
+    }
+};
+
+}  // namespace feed::impl
@@ -22,7 +22,6 @@
 #include "feed/impl/SingleFeedBase.h"
 
 #include <boost/json/object.hpp>
-#include <boost/json/serialize.hpp>
 
 namespace feed::impl {
 
@@ -38,7 +37,7 @@ struct ForwardFeed : public SingleFeedBase {
     void
     pub(boost::json::object const& json) const
     {
-        SingleFeedBase::pub(boost::json::serialize(json));
+        SingleFeedBase::pub(json);
     }
 };
 }  // namespace feed::impl
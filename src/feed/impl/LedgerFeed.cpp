@@ -27,7 +27,6 @@
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
-#include <boost/json/serialize.hpp>
 #include <ripple/basics/base_uint.h>
 #include <ripple/protocol/Fees.h>
 #include <ripple/protocol/LedgerHeader.h>
@@ -96,6 +95,6 @@ LedgerFeed::pub(
     std::uint32_t const txnCount
 ) const
 {
-    SingleFeedBase::pub(boost::json::serialize(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)));
+    SingleFeedBase::pub(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount));
 }
 }  // namespace feed::impl
@@ -20,12 +20,12 @@
 #include "feed/impl/ProposedTransactionFeed.h"
 
 #include "feed/Types.h"
+#include "feed/impl/FeedMessage.h"
 #include "rpc/RPCHelpers.h"
 #include "util/log/Logger.h"
 
 #include <boost/asio/post.hpp>
 #include <boost/json/object.hpp>
-#include <boost/json/serialize.hpp>
 #include <ripple/protocol/AccountID.h>
 
 #include <cstdint>
@@ -40,9 +40,9 @@ void
 ProposedTransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 {
     auto const weakPtr = std::weak_ptr(subscriber);
-    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](std::shared_ptr<std::string> const& msg) {
+    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](FeedMessage const& msg) {
         if (auto connectionPtr = weakPtr.lock()) {
-            connectionPtr->send(msg);
+            msg.sendTo(*connectionPtr);
         }
     });
 
@@ -60,14 +60,14 @@ ProposedTransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedP
     auto const added = accountSignal_.connectTrackableSlot(
         subscriber,
         account,
-        [this, weakPtr](std::shared_ptr<std::string> const& msg) {
+        [this, weakPtr](FeedMessage const& msg) {
             if (auto connectionPtr = weakPtr.lock()) {
                 // Check if this connection already sent
                 if (notified_.contains(connectionPtr.get()))
                     return;
 
                 notified_.insert(connectionPtr.get());
-                connectionPtr->send(msg);
+                msg.sendTo(*connectionPtr);
             }
         }
     );
@@ -95,7 +95,7 @@ ProposedTransactionFeed::unsub(ripple::AccountID const& account, SubscriberShare
 void
 ProposedTransactionFeed::pub(boost::json::object const& receivedTxJson)
 {
-    auto pubMsg = std::make_shared<std::string>(boost::json::serialize(receivedTxJson));
+    auto pubMsg = FeedMessage{receivedTxJson};
 
     auto const transaction = receivedTxJson.at("transaction").as_object();
     auto const accounts = rpc::getAccountsFromTransaction(transaction);
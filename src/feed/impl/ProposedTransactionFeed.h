@@ -20,6 +20,7 @@
 #pragma once
 
 #include "feed/Types.h"
+#include "feed/impl/FeedMessage.h"
 #include "feed/impl/TrackableSignal.h"
 #include "feed/impl/TrackableSignalMap.h"
 #include "feed/impl/Util.h"
@@ -55,8 +56,8 @@ class ProposedTransactionFeed {
     std::reference_wrapper<util::prometheus::GaugeInt> subAllCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAccountCount_;
 
-    TrackableSignalMap<ripple::AccountID, Subscriber, std::shared_ptr<std::string>> accountSignal_;
-    TrackableSignal<Subscriber, std::shared_ptr<std::string>> signal_;
+    TrackableSignalMap<ripple::AccountID, Subscriber, FeedMessage const&> accountSignal_;
+    TrackableSignal<Subscriber, FeedMessage const&> signal_;
 
 public:
     /**
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "feed/impl/Util.h"
+#include "util/prometheus/Counter.h"
+#include "util/prometheus/Gauge.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace feed::impl {
+
+/**
+ * @brief Keeps the already serialized messages of the most recent ledgers, so that a subscriber reconnecting after a
+ * short outage can be sent what it missed straight from memory.
+ *
+ * The buffer is bounded both by number of ledgers and by the total size of the messages; the oldest ledgers are
+ * dropped first. Messages must be added in ledger order.
+ *
+ * @tparam MessageType The type of the buffered message
+ */
+template <typename MessageType>
+class ReplayBuffer {
+    struct LedgerMessages {
+        std::uint32_t sequence;
+        std::vector<MessageType> messages;
+        std::size_t bytes = 0;
+    };
+
+    std::size_t const maxLedgers_;
+    std::size_t const maxBytes_;
+
+    mutable std::mutex mtx_;
+    std::deque<LedgerMessages> ledgers_;
+    std::size_t bytes_ = 0;
+    // all messages of ledgers starting from this one are buffered; ledgers without messages leave no trace
+    std::optional<std::uint32_t> firstCoveredSequence_;
+
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> missCounter_;
+    std::reference_wrapper<util::prometheus::GaugeInt> bytesGauge_;
+
+public:
+    /**
+     * @brief Construct a new Replay Buffer object
+     * @param name The name of the stream this buffer belongs to, used for the prometheus metrics.
+     * @param maxLedgers The maximum number of ledgers to keep; 0 disables the buffer.
+     * @param maxBytes The maximum total size of the buffered messages.
+     */
+    ReplayBuffer(std::string const& name, std::size_t maxLedgers, std::size_t maxBytes)
+        : maxLedgers_(maxLedgers)
+        , maxBytes_(maxBytes)
+        , hitCounter_(getReplayCounterInt(name, "hit"))
+        , missCounter_(getReplayCounterInt(name, "miss"))
+        , bytesGauge_(getReplayBufferBytesGaugeInt(name))
+    {
+    }
+
+    /**
+     * @brief Add a message of the given ledger.
+     * @param ledgerSequence The sequence of the ledger the message belongs to.
+     * @param message The message.
+     * @param bytes The size of the message, accounted against the memory limit.
+     */
+    void
+    add(std::uint32_t ledgerSequence, MessageType message, std::size_t bytes)
+    {
+        if (maxLedgers_ == 0)
+            return;
+
+        std::scoped_lock const lck(mtx_);
+        if (ledgers_.empty() or ledgers_.back().sequence != ledgerSequence) {
+            if (not firstCoveredSequence_)
+                firstCoveredSequence_ = ledgerSequence;
+            ledgers_.push_back(LedgerMessages{.sequence = ledgerSequence, .messages = {}, .bytes = 0});
+        }
+
+        ledgers_.back().messages.push_back(std::move(message));
+        ledgers_.back().bytes += bytes;
+        bytes_ += bytes;
+
+        // the ledger being filled is never dropped, so a single huge ledger can exceed the memory limit on its own
+        while (ledgers_.size() > maxLedgers_ or (bytes_ > maxBytes_ and ledgers_.size() > 1)) {
+            bytes_ -= ledgers_.front().bytes;
+            firstCoveredSequence_ = ledgers_.front().sequence + 1;
+            ledgers_.pop_front();
+        }
+
+        bytesGauge_.get().set(static_cast<std::int64_t>(bytes_));
+    }
+
+    /**
+     * @brief Check whether all messages of the ledgers following the given one are still buffered.
+     * @param sinceLedger The last ledger the subscriber has received completely.
+     * @return true if the subscriber can be caught up from the buffer; false otherwise
+     */
+    bool
+    covers(std::uint32_t sinceLedger) const
+    {
+        std::scoped_lock const lck(mtx_);
+        return coversInternal(sinceLedger);
+    }
+
+    /**
+     * @brief Call the given function for every buffered message of the ledgers following the given one, in order.
+     *
+     * Counts a hit if the buffer covers the requested range and a miss otherwise. On a miss nothing is replayed.
+     *
+     * @param sinceLedger The last ledger the subscriber has received completely.
+     * @param fn The function to call with each message.
+     * @return true if the buffer covered the requested range; false otherwise
+     */
+    template <typename FnType>
+    bool
+    replay(std::uint32_t sinceLedger, FnType&& fn) const
+    {
+        std::scoped_lock const lck(mtx_);
+        if (not coversInternal(sinceLedger)) {
+            ++missCounter_.get();
+            return false;
+        }
+
+        ++hitCounter_.get();
+        for (auto const& ledger : ledgers_) {
+            if (ledger.sequence <= sinceLedger)
+                continue;
+
+            for (auto const& message : ledger.messages)
+                fn(message);
+        }
+        return true;
+    }
+
+private:
+    bool
+    coversInternal(std::uint32_t sinceLedger) const
+    {
+        return firstCoveredSequence_.has_value() and sinceLedger + 1 >= *firstCoveredSequence_;
+    }
+};
+
+}  // namespace feed::impl
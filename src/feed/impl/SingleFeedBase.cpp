@@ -20,6 +20,7 @@
 #include "feed/impl/SingleFeedBase.h"
 
 #include "feed/Types.h"
+#include "feed/impl/FeedMessage.h"
 #include "feed/impl/TrackableSignal.h"
 #include "feed/impl/Util.h"
 #include "util/log/Logger.h"
@@ -27,6 +28,7 @@
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -44,9 +46,9 @@ void
 SingleFeedBase::sub(SubscriberSharedPtr const& subscriber)
 {
     auto const weakPtr = std::weak_ptr(subscriber);
-    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](std::shared_ptr<std::string> const& msg) {
+    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](FeedMessage const& msg) {
         if (auto connectionPtr = weakPtr.lock())
-            connectionPtr->send(msg);
+            msg.sendTo(*connectionPtr);
     });
 
     if (added) {
@@ -68,8 +70,15 @@ void
 SingleFeedBase::pub(std::string msg) const
 {
     boost::asio::post(strand_, [this, msg = std::move(msg)]() mutable {
-        auto const msgPtr = std::make_shared<std::string>(std::move(msg));
-        signal_.emit(msgPtr);
+        signal_.emit(FeedMessage{std::move(msg)});
+    });
+}
+
+void
+SingleFeedBase::pub(boost::json::object msg) const
+{
+    boost::asio::post(strand_, [this, msg = std::move(msg)]() mutable {
+        signal_.emit(FeedMessage{std::move(msg)});
     });
 }
 
@@ -20,12 +20,14 @@
 #pragma once
 
 #include "feed/Types.h"
+#include "feed/impl/FeedMessage.h"
 #include "feed/impl/TrackableSignal.h"
 #include "util/log/Logger.h"
 #include "util/prometheus/Gauge.h"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
+#include <boost/json/object.hpp>
 
 #include <cstdint>
 #include <functional>
@@ -40,7 +42,7 @@ namespace feed::impl {
 class SingleFeedBase {
     boost::asio::strand<boost::asio::io_context::executor_type> strand_;
     std::reference_wrapper<util::prometheus::GaugeInt> subCount_;
-    TrackableSignal<Subscriber, std::shared_ptr<std::string> const&> signal_;
+    TrackableSignal<Subscriber, FeedMessage const&> signal_;
     util::Logger logger_{"Subscriptions"};
     std::string name_;
 
@@ -73,6 +75,13 @@ public:
     void
     pub(std::string msg) const;
 
+    /**
+     * @brief Publishes the feed in strand. The message is serialized once per wire format requested by subscribers.
+     * @param msg The message.
+     */
+    void
+    pub(boost::json::object msg) const;
+
     /**
      * @brief Get the count of subscribers.
      */
@@ -28,6 +28,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 
 namespace feed::impl {
 
@@ -79,6 +80,30 @@ public:
         return true;
     }
 
+    /**
+     * @brief Replace the slot of an existing connection.
+     *
+     * The new slot is connected before the old one is disconnected, so a concurrent emit may call both slots but never
+     * neither of them.
+     *
+     * @param trackable The object whose slot is replaced.
+     * @param slot The new slot.
+     * @return true if the slot was replaced, false if there is no connection for the trackable.
+     */
+    bool
+    replaceTrackableSlot(ConnectionSharedPtr const& trackable, std::function<void(Args...)> slot)
+    {
+        std::scoped_lock const lk(mutex_);
+        auto const it = connections_.find(trackable.get());
+        if (it == connections_.end())
+            return false;
+
+        auto connection = signal_.connect(typename SignalType::slot_type(slot).track_foreign(trackable));
+        it->second.disconnect();
+        it->second = std::move(connection);
+        return true;
+    }
+
     /**
      * @brief Disconnect a slot to the signal.
      *
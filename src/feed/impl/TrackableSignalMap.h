@@ -28,6 +28,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 
 namespace feed::impl {
 
@@ -71,6 +72,22 @@ public:
         return signalsMap_[key].connectTrackableSlot(trackable, slot);
     }
 
+    /**
+     * @brief Replace the slot of an existing connection to the key's associative signal.
+     *
+     * @param trackable The object whose slot is replaced.
+     * @param key The key to the signal.
+     * @param slot The new slot.
+     * @return true if the slot was replaced, false if there is no connection for the trackable and key.
+     */
+    bool
+    replaceTrackableSlot(ConnectionSharedPtr const& trackable, Key const& key, std::function<void(Args...)> slot)
+    {
+        std::scoped_lock const lk(mutex_);
+        auto const it = signalsMap_.find(key);
+        return it != signalsMap_.end() and it->second.replaceTrackableSlot(trackable, std::move(slot));
+    }
+
     /**
      * @brief Disconnect a slot from the key's associative signal.
      *
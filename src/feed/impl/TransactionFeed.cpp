@@ -21,13 +21,18 @@
 
 #include "data/BackendInterface.h"
 #include "data/Types.h"
+#include "feed/TransactionFilter.h"
 #include "feed/Types.h"
+#include "feed/impl/FeedMessage.h"
 #include "rpc/JS.h"
 #include "rpc/RPCHelpers.h"
+#include "util/MsgPack.h"
 #include "util/log/Logger.h"
+#include "web/interface/ConnectionBase.h"
 
 #include <boost/asio/post.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/serialize.hpp>
 #include <ripple/basics/chrono.h>
@@ -42,53 +47,224 @@
 #include <ripple/protocol/TxFormats.h>
 #include <ripple/protocol/jss.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <exception>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace feed::impl {
 
 void
-TransactionFeed::TransactionSlot::operator()(AllVersionTransactionsType const& allVersionMsgs) const
+TransactionFeed::TransactionSlot::operator()(PreparedTransaction const& prepared) const
 {
     if (auto connection = connectionWeakPtr.lock(); connection) {
         // Check if this connection already sent
         if (feed.get().notified_.contains(connection.get()))
             return;
 
+        // Not marked as notified, another unfiltered subscription of the same connection may still want it
+        if (filter and not filter->matches(prepared.filterFields))
+            return;
+
         feed.get().notified_.insert(connection.get());
+        send(*connection, prepared);
+    }
+}
 
-        if (connection->apiSubVersion < 2u) {
-            connection->send(allVersionMsgs[0]);
-            return;
+void
+TransactionFeed::sub(
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
+)
+{
+    subMaybeReplay(
+        subscriber,
+        sinceLedger,
+        [this, apiVersion, filter](SubscriberSharedPtr const& connection) {
+            return subInternal(connection, apiVersion, filter);
+        },
+        [filter](PreparedTransaction const& prepared) {
+            return not filter or filter->matches(prepared.filterFields);
+        }
+    );
+}
+
+void
+TransactionFeed::sub(
+    ripple::AccountID const& account,
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
+)
+{
+    subMaybeReplay(
+        subscriber,
+        sinceLedger,
+        [this, account, apiVersion, filter](SubscriberSharedPtr const& connection) {
+            return subInternal(account, connection, apiVersion, filter);
+        },
+        [account, filter](PreparedTransaction const& prepared) {
+            return prepared.affectedAccounts.contains(account) and
+                (not filter or filter->matches(prepared.filterFields));
+        }
+    );
+}
+
+void
+TransactionFeed::sub(
+    ripple::Book const& book,
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::optional<std::uint32_t> const sinceLedger,
+    std::shared_ptr<TransactionFilter const> filter
+)
+{
+    subMaybeReplay(
+        subscriber,
+        sinceLedger,
+        [this, book, apiVersion, filter](SubscriberSharedPtr const& connection) {
+            return subInternal(book, connection, apiVersion, filter);
+        },
+        [book, filter](PreparedTransaction const& prepared) {
+            return prepared.affectedBooks.contains(book) and (not filter or filter->matches(prepared.filterFields));
         }
-        connection->send(allVersionMsgs[1]);
+    );
+}
+
+bool
+TransactionFeed::canReplay(std::uint32_t const sinceLedger) const
+{
+    return replayBuffer_.covers(sinceLedger);
+}
+
+template <typename SubscribeFnType, typename FilterFnType>
+void
+TransactionFeed::subMaybeReplay(
+    SubscriberSharedPtr const& subscriber,
+    std::optional<std::uint32_t> const sinceLedger,
+    SubscribeFnType&& subscribeFn,
+    FilterFnType&& filterFn
+)
+{
+    if (not sinceLedger) {
+        subscribeFn(subscriber);
+        return;
     }
+
+    // The subscription is made by the replay, in the same strand job that sends the buffered transactions. As
+    // transactions are only emitted from the strand, none can go live in between and be sent twice or out of order
+    boost::asio::post(
+        strand_,
+        [this,
+         subscriber,
+         since = *sinceLedger,
+         subscribeFn = std::forward<SubscribeFnType>(subscribeFn),
+         filterFn = std::forward<FilterFnType>(filterFn)]() mutable {
+            auto& pending = pendingReplays_[subscriber.get()];
+            pending.sinceLedger = pending.subscribeFns.empty() ? since : std::min(pending.sinceLedger, since);
+            pending.subscribeFns.emplace_back(std::move(subscribeFn));
+            pending.filters.emplace_back(std::move(filterFn));
+        }
+    );
 }
 
 void
-TransactionFeed::sub(SubscriberSharedPtr const& subscriber, std::uint32_t const apiVersion)
+TransactionFeed::replay(SubscriberSharedPtr const& subscriber)
 {
-    auto const added = signal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber));
+    boost::asio::post(strand_, [this, subscriber]() {
+        auto const node = pendingReplays_.extract(subscriber.get());
+        if (node.empty())
+            return;
+
+        auto const& [since, subscribeFns, allFilters] = node.mapped();
+
+        // an existing subscription already receives its transactions live
+        std::vector<std::function<bool(PreparedTransaction const&)>> filters;
+        for (std::size_t i = 0; i < subscribeFns.size(); ++i) {
+            if (subscribeFns[i](subscriber))
+                filters.push_back(allFilters[i]);
+        }
+
+        if (filters.empty())
+            return;
+
+        // one pass for all new subscriptions, so a transaction matching several of them is still sent once
+        auto const replayed = replayBuffer_.replay(since, [&](PreparedTransaction const& prepared) {
+            if (std::ranges::any_of(filters, [&](auto const& filter) { return filter(prepared); }))
+                send(*subscriber, prepared);
+        });
+
+        if (not replayed) {
+            // evicted after the subscription was accepted; the client must know it missed transactions
+            LOG(logger_.warn()) << subscriber->tag() << "Ledger " << since << " is no longer buffered";
+            FeedMessage{boost::json::object{
+                            {JS(type), "replayGap"}, {"since_ledger", since}, {JS(error), "sinceLedgerNotBuffered"}
+                        }}
+                .sendTo(*subscriber);
+        }
+    });
+}
+
+void
+TransactionFeed::send(Subscriber& subscriber, PreparedTransaction const& prepared)
+{
+    if (subscriber.feedFormat == web::FeedFormat::MsgPack) {
+        if (not prepared.msgPack)
+            prepared.msgPack = std::make_shared<std::string>(prepared.genMsgPack());
+
+        subscriber.sendBinary(prepared.msgPack);
+        return;
+    }
+
+    auto const& allVersionMsgs = prepared.allVersionsMsgs;
+
+    if (subscriber.apiSubVersion < 2u) {
+        subscriber.send(allVersionMsgs[0]);
+        return;
+    }
+    subscriber.send(allVersionMsgs[1]);
+}
+
+bool
+TransactionFeed::subInternal(
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::shared_ptr<TransactionFilter const> filter
+)
+{
+    auto const added = signal_.connectTrackableSlot(subscriber, TransactionSlot(*this, subscriber, filter));
     if (added) {
         LOG(logger_.debug()) << subscriber->tag() << "Subscribed transactions";
         ++subAllCount_.get();
         subscriber->apiSubVersion = apiVersion;
         subscriber->onDisconnect.connect([this](SubscriberPtr connection) { unsubInternal(connection); });
+    } else if (signal_.replaceTrackableSlot(subscriber, TransactionSlot(*this, subscriber, std::move(filter)))) {
+        LOG(logger_.debug()) << subscriber->tag() << "Replaced filter of transactions subscription";
     }
+    return added;
 }
 
-void
-TransactionFeed::sub(
+bool
+TransactionFeed::subInternal(
     ripple::AccountID const& account,
     SubscriberSharedPtr const& subscriber,
-    std::uint32_t const apiVersion
+    std::uint32_t const apiVersion,
+    std::shared_ptr<TransactionFilter const> filter
 )
 {
-    auto const added = accountSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber));
+    auto const added =
+        accountSignal_.connectTrackableSlot(subscriber, account, TransactionSlot(*this, subscriber, filter));
     if (added) {
         LOG(logger_.debug()) << subscriber->tag() << "Subscribed account " << account;
         ++subAccountCount_.get();
@@ -96,19 +272,34 @@ TransactionFeed::sub(
         subscriber->onDisconnect.connect([this, account](SubscriberPtr connection) {
             unsubInternal(account, connection);
         });
+    } else if (accountSignal_.replaceTrackableSlot(
+                   subscriber, account, TransactionSlot(*this, subscriber, std::move(filter))
+               )) {
+        LOG(logger_.debug()) << subscriber->tag() << "Replaced filter of account " << account;
     }
+    return added;
 }
 
-void
-TransactionFeed::sub(ripple::Book const& book, SubscriberSharedPtr const& subscriber, std::uint32_t const apiVersion)
+bool
+TransactionFeed::subInternal(
+    ripple::Book const& book,
+    SubscriberSharedPtr const& subscriber,
+    std::uint32_t const apiVersion,
+    std::shared_ptr<TransactionFilter const> filter
+)
 {
-    auto const added = bookSignal_.connectTrackableSlot(subscriber, book, TransactionSlot(*this, subscriber));
+    auto const added = bookSignal_.connectTrackableSlot(subscriber, book, TransactionSlot(*this, subscriber, filter));
     if (added) {
         LOG(logger_.debug()) << subscriber->tag() << "Subscribed book " << book;
         ++subBookCount_.get();
         subscriber->apiSubVersion = apiVersion;
         subscriber->onDisconnect.connect([this, book](SubscriberPtr connection) { unsubInternal(book, connection); });
+    } else if (bookSignal_.replaceTrackableSlot(
+                   subscriber, book, TransactionSlot(*this, subscriber, std::move(filter))
+               )) {
+        LOG(logger_.debug()) << subscriber->tag() << "Replaced filter of book " << book;
     }
+    return added;
 }
 
 void
@@ -154,6 +345,37 @@ TransactionFeed::pub(
     std::shared_ptr<data::BackendInterface const> const& backend
 )
 {
+    auto const sequence = nextSequence_++;
+
+    auto txMetaPtr = std::make_shared<data::TransactionAndMetadata const>(txMeta);
+    auto prepareAndEmit = [this, sequence, txMetaPtr = std::move(txMetaPtr), lgrInfo, backend](
+                              boost::asio::yield_context yield
+                          ) {
+        std::optional<PreparedTransaction> prepared;
+        try {
+            prepared = prepare(txMetaPtr, lgrInfo, backend, yield);
+        } catch (std::exception const& e) {
+            // still hand the sequence over to the strand, otherwise all following transactions would be held forever
+            LOG(logger_.error()) << "Failed to prepare transaction of ledger " << lgrInfo.seq << ": " << e.what();
+        }
+
+        boost::asio::post(strand_, [this, sequence, prepared = std::move(prepared)]() mutable {
+            emitInOrder(sequence, std::move(prepared));
+        });
+    };
+
+    boost::asio::spawn(ioContext_.get(), std::move(prepareAndEmit));
+}
+
+TransactionFeed::PreparedTransaction
+TransactionFeed::prepare(
+    std::shared_ptr<data::TransactionAndMetadata const> const& txMetaPtr,
+    ripple::LedgerHeader const& lgrInfo,
+    std::shared_ptr<data::BackendInterface const> const& backend,
+    boost::asio::yield_context yield
+) const
+{
+    auto const& txMeta = *txMetaPtr;
     auto [tx, meta] = rpc::deserializeTxPlusMeta(txMeta, lgrInfo.seq);
 
     std::optional<ripple::STAmount> ownerFunds;
@@ -162,12 +384,18 @@ TransactionFeed::pub(
         auto const account = tx->getAccountID(ripple::sfAccount);
         auto const amount = tx->getFieldAmount(ripple::sfTakerGets);
         if (account != amount.issue().account) {
-            auto fetchFundsSynchronous = [&]() {
-                data::synchronous([&](boost::asio::yield_context yield) {
+            // the coroutine is suspended while reading, so the subscription workers keep serving other messages
+            while (not ownerFunds) {
+                try {
                     ownerFunds = rpc::accountFunds(*backend, lgrInfo.seq, amount, account, yield);
-                });
-            };
-            data::retryOnTimeout(fetchFundsSynchronous);
+                } catch (data::DatabaseTimeout const&) {
+                    LOG(logger_.error()) << "Database request timed out. Waiting and retrying ... ";
+                    boost::asio::steady_timer timer{
+                        yield.get_executor(), std::chrono::milliseconds{data::DEFAULT_WAIT_BETWEEN_RETRY}
+                    };
+                    timer.async_wait(yield);
+                }
+            }
         }
     }
 
@@ -207,6 +435,47 @@ TransactionFeed::pub(
         return pubObj;
     };
 
+    // The binary message carries the stored blobs as they are instead of their json rendering. It is only encoded
+    // once a subscriber asks for it, so only what it needs besides the blobs is kept.
+    auto genMsgPack = [txMetaPtr,
+                       txHash = tx->getTransactionID(),
+                       ledgerSequence = lgrInfo.seq,
+                       ledgerHash = lgrInfo.hash,
+                       closeTime = lgrInfo.closeTime.time_since_epoch().count(),
+                       resultCode = meta->getResult(),
+                       result = ripple::transToken(meta->getResultTER()),
+                       ownerFundsText = ownerFunds ? std::make_optional(ownerFunds->getText()) : std::nullopt]() {
+        static constexpr auto NUM_FIELDS = 10u;
+
+        util::MsgPackWriter writer;
+        writer.writeMapHeader(ownerFundsText ? NUM_FIELDS + 1 : NUM_FIELDS);
+        writer.writeString(JS(type));
+        writer.writeString("transaction");
+        writer.writeString(JS(tx_blob));
+        writer.writeBinary(txMetaPtr->transaction.data(), txMetaPtr->transaction.size());
+        writer.writeString(JS(meta_blob));
+        writer.writeBinary(txMetaPtr->metadata.data(), txMetaPtr->metadata.size());
+        writer.writeString(JS(hash));
+        writer.writeBinary(txHash.data(), txHash.size());
+        writer.writeString(JS(ledger_index));
+        writer.writeUInt(ledgerSequence);
+        writer.writeString(JS(ledger_hash));
+        writer.writeBinary(ledgerHash.data(), ledgerHash.size());
+        writer.writeString(JS(date));
+        writer.writeUInt(closeTime);
+        writer.writeString(JS(validated));
+        writer.writeBool(true);
+        writer.writeString(JS(engine_result_code));
+        writer.writeInt(resultCode);
+        writer.writeString(JS(engine_result));
+        writer.writeString(result);
+        if (ownerFundsText) {
+            writer.writeString(JS(owner_funds));
+            writer.writeString(*ownerFundsText);
+        }
+        return writer.release();
+    };
+
     AllVersionTransactionsType allVersionsMsgs{
         std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(1u))),
         std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(2u)))
@@ -250,28 +519,62 @@ TransactionFeed::pub(
         }
     }
 
-    boost::asio::post(
-        strand_,
-        [this,
-         allVersionsMsgs = std::move(allVersionsMsgs),
-         affectedAccounts = std::move(affectedAccounts),
-         affectedBooks = std::move(affectedBooks)]() {
-            notified_.clear();
-            signal_.emit(allVersionsMsgs);
-            notified_.clear();
-            // check duplicate for accounts, this prevents sending the same message multiple times if it touches
-            // multiple accounts watched by the same connection
-            for (auto const& account : affectedAccounts) {
-                accountSignal_.emit(account, allVersionsMsgs);
-            }
-            notified_.clear();
-            // check duplicate for books, this prevents sending the same message multiple times if it touches multiple
-            // books watched by the same connection
-            for (auto const& book : affectedBooks) {
-                bookSignal_.emit(book, allVersionsMsgs);
-            }
+    auto filterFields = TransactionFilter::Fields{
+        .type = tx->getTxnType(),
+        .result = meta->getResultTER(),
+        .deliveredAmount = rpc::canHaveDeliveredAmount(tx, meta)
+            ? rpc::getDeliveredAmount(tx, meta, meta->getLgrSeq(), txMeta.date)
+            : std::nullopt
+    };
+
+    return {
+        lgrInfo.seq,
+        std::move(allVersionsMsgs),
+        txMetaPtr,
+        std::move(genMsgPack),
+        nullptr,
+        std::move(affectedAccounts),
+        std::move(affectedBooks),
+        std::move(filterFields)
+    };
+}
+
+void
+TransactionFeed::emitInOrder(std::uint64_t const sequence, std::optional<PreparedTransaction> prepared)
+{
+    pending_.emplace(sequence, std::move(prepared));
+
+    for (auto it = pending_.begin(); it != pending_.end() and it->first == nextToEmit_; it = pending_.erase(it)) {
+        if (it->second.has_value()) {
+            emit(*it->second);
+
+            auto const ledgerSequence = it->second->ledgerSequence;
+            auto const& msgs = it->second->allVersionsMsgs;
+            auto const& blobs = *it->second->txMeta;
+            auto const bytes = msgs[0]->size() + msgs[1]->size() + blobs.transaction.size() + blobs.metadata.size();
+            replayBuffer_.add(ledgerSequence, std::move(*it->second), bytes);
         }
-    );
+        ++nextToEmit_;
+    }
+}
+
+void
+TransactionFeed::emit(PreparedTransaction const& prepared)
+{
+    notified_.clear();
+    signal_.emit(prepared);
+    notified_.clear();
+    // check duplicate for accounts, this prevents sending the same message multiple times if it touches
+    // multiple accounts watched by the same connection
+    for (auto const& account : prepared.affectedAccounts) {
+        accountSignal_.emit(account, prepared);
+    }
+    notified_.clear();
+    // check duplicate for books, this prevents sending the same message multiple times if it touches multiple
+    // books watched by the same connection
+    for (auto const& book : prepared.affectedBooks) {
+        bookSignal_.emit(book, prepared);
+    }
 }
 
 void
@@ -21,7 +21,9 @@
 
 #include "data/BackendInterface.h"
 #include "data/Types.h"
+#include "feed/TransactionFilter.h"
 #include "feed/Types.h"
+#include "feed/impl/ReplayBuffer.h"
 #include "feed/impl/TrackableSignal.h"
 #include "feed/impl/TrackableSignalMap.h"
 #include "feed/impl/Util.h"
@@ -29,6 +31,7 @@
 #include "util/prometheus/Gauge.h"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/asio/strand.hpp>
 #include <fmt/core.h>
 #include <ripple/protocol/AccountID.h>
@@ -36,11 +39,18 @@
 #include <ripple/protocol/LedgerHeader.h>
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <map>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace feed::impl {
 
@@ -48,43 +58,91 @@ class TransactionFeed {
     // Hold two versions of transaction messages
     using AllVersionTransactionsType = std::array<std::shared_ptr<std::string>, 2>;
 
+    // Everything the strand needs to notify the subscribers of one transaction
+    struct PreparedTransaction {
+        std::uint32_t ledgerSequence = 0;
+        AllVersionTransactionsType allVersionsMsgs;
+        std::shared_ptr<data::TransactionAndMetadata const> txMeta;
+        // The MessagePack message is encoded when the first subscriber asking for it is notified
+        std::function<std::string()> genMsgPack;
+        mutable std::shared_ptr<std::string> msgPack;  // only accessed from strand_
+        std::unordered_set<ripple::AccountID> affectedAccounts;
+        std::unordered_set<ripple::Book> affectedBooks;
+        TransactionFilter::Fields filterFields;
+    };
+
     struct TransactionSlot {
         std::reference_wrapper<TransactionFeed> feed;
         std::weak_ptr<Subscriber> connectionWeakPtr;
+        std::shared_ptr<TransactionFilter const> filter;
 
-        TransactionSlot(TransactionFeed& feed, SubscriberSharedPtr const& connection)
-            : feed(feed), connectionWeakPtr(connection)
+        TransactionSlot(
+            TransactionFeed& feed,
+            SubscriberSharedPtr const& connection,
+            std::shared_ptr<TransactionFilter const> filter
+        )
+            : feed(feed), connectionWeakPtr(connection), filter(std::move(filter))
         {
         }
 
         void
-        operator()(AllVersionTransactionsType const& allVersionMsgs) const;
+        operator()(PreparedTransaction const& prepared) const;
     };
 
     util::Logger logger_{"Subscriptions"};
 
+    std::reference_wrapper<boost::asio::io_context> ioContext_;
     boost::asio::strand<boost::asio::io_context::executor_type> strand_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAllCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subAccountCount_;
     std::reference_wrapper<util::prometheus::GaugeInt> subBookCount_;
 
-    TrackableSignalMap<ripple::AccountID, Subscriber, AllVersionTransactionsType const&> accountSignal_;
-    TrackableSignalMap<ripple::Book, Subscriber, AllVersionTransactionsType const&> bookSignal_;
-    TrackableSignal<Subscriber, AllVersionTransactionsType const&> signal_;
+    TrackableSignalMap<ripple::AccountID, Subscriber, PreparedTransaction const&> accountSignal_;
+    TrackableSignalMap<ripple::Book, Subscriber, PreparedTransaction const&> bookSignal_;
+    TrackableSignal<Subscriber, PreparedTransaction const&> signal_;
 
     std::unordered_set<SubscriberPtr>
         notified_;  // Used by slots to prevent double notifications if tx contains multiple subscribed accounts
 
+    // Transactions are prepared concurrently on the io_context but must reach subscribers in the order pub was called.
+    // Each pub takes a sequence number; prepared transactions wait in pending_ until all earlier ones were emitted.
+    std::atomic_uint64_t nextSequence_ = 0;
+    std::uint64_t nextToEmit_ = 0;                                           // only accessed from strand_
+    std::map<std::uint64_t, std::optional<PreparedTransaction>> pending_;  // only accessed from strand_
+
+    // The subscriptions of a connection waiting to be made and replayed together, so every transaction is sent once
+    struct PendingReplay {
+        std::uint32_t sinceLedger = 0;
+        std::vector<std::function<bool(SubscriberSharedPtr const&)>> subscribeFns;
+        std::vector<std::function<bool(PreparedTransaction const&)>> filters;
+    };
+    std::unordered_map<SubscriberPtr, PendingReplay> pendingReplays_;  // only accessed from strand_
+
+    // Written after emitting and read when resuming a subscription, both from strand_, so resumed subscribers get
+    // every transaction exactly once and in order
+    ReplayBuffer<PreparedTransaction> replayBuffer_;
+
 public:
+    static constexpr std::size_t DEFAULT_REPLAY_LEDGERS = 10;
+    static constexpr std::size_t DEFAULT_REPLAY_BYTES = 64 * 1024 * 1024;
+
     /**
      * @brief Construct a new Transaction Feed object.
-     * @param ioContext The actual publish will be called in the strand of this.
+     * @param ioContext The transactions are prepared on this context and published in the strand of this.
+     * @param replayLedgers The number of most recent ledgers kept for resuming subscriptions; 0 disables replay.
+     * @param replayBytes The maximum total size of the messages kept for resuming subscriptions.
      */
-    TransactionFeed(boost::asio::io_context& ioContext)
-        : strand_(boost::asio::make_strand(ioContext))
+    TransactionFeed(
+        boost::asio::io_context& ioContext,
+        std::size_t replayLedgers = DEFAULT_REPLAY_LEDGERS,
+        std::size_t replayBytes = DEFAULT_REPLAY_BYTES
+    )
+        : ioContext_(ioContext)
+        , strand_(boost::asio::make_strand(ioContext))
         , subAllCount_(getSubscriptionsGaugeInt("tx"))
         , subAccountCount_(getSubscriptionsGaugeInt("account"))
         , subBookCount_(getSubscriptionsGaugeInt("book"))
+        , replayBuffer_("tx", replayLedgers, replayBytes)
     {
     }
 
@@ -92,27 +150,71 @@ public:
      * @brief Subscribe to the transaction feed.
      * @param subscriber
      * @param apiVersion The api version of feed.
+     * @param sinceLedger If set, the subscription is made on the next replay, after sending the buffered transactions
+     * of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    sub(SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    sub(SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr);
 
     /**
      * @brief Subscribe to the transaction feed, only receive the feed when particular account is affected.
      * @param subscriber
      * @param account The account to watch.
      * @param apiVersion The api version of feed.
+     * @param sinceLedger If set, the subscription is made on the next replay, after sending the buffered transactions
+     * of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    sub(ripple::AccountID const& account, SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    sub(ripple::AccountID const& account,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr);
 
     /**
      * @brief Subscribe to the transaction feed, only receive the feed when particular order book is affected.
      * @param subscriber
      * @param book The order book to watch.
      * @param apiVersion The api version of feed.
+     * @param sinceLedger If set, the subscription is made on the next replay, after sending the buffered transactions
+     * of the ledgers after this one.
+     * @param filter If set, only the transactions passing this filter are sent; replaces the filter of an existing
+     * subscription.
      */
     void
-    sub(ripple::Book const& book, SubscriberSharedPtr const& subscriber, std::uint32_t apiVersion);
+    sub(ripple::Book const& book,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger = std::nullopt,
+        std::shared_ptr<TransactionFilter const> filter = nullptr);
+
+    /**
+     * @brief Make the subscriptions requested with a sinceLedger since the last replay and replay the buffered
+     * transactions to them.
+     *
+     * Must be called once all subscriptions of a request are requested. Each buffered transaction is sent at most once,
+     * no matter how many of these subscriptions it matches, and before any transaction published afterwards. If the
+     * ledgers were evicted from the buffer in the meantime, the subscriber is sent a "replayGap" message instead.
+     *
+     * @param subscriber
+     */
+    void
+    replay(SubscriberSharedPtr const& subscriber);
+
+    /**
+     * @brief Check whether a subscription can be resumed after the given ledger.
+     * @param sinceLedger The last ledger the subscriber has received completely.
+     * @return true if all transactions published after this ledger are still buffered; false otherwise
+     */
+    bool
+    canReplay(std::uint32_t sinceLedger) const;
 
     /**
      * @brief Unsubscribe to the transaction feed.
@@ -139,6 +241,11 @@ public:
 
     /**
      * @brief Publishes the transaction feed.
+     *
+     * Decoding the transaction and generating the messages happens in a coroutine on the io_context, so consecutive
+     * calls are prepared in parallel when the context runs on several threads; database reads suspend the coroutine
+     * instead of blocking the thread. Subscribers still receive the transactions in the order this function was called.
+     *
      * @param txMeta The transaction and metadata.
      * @param lgrInfo The ledger header.
      * @param backend The backend.
@@ -167,6 +274,55 @@ public:
     bookSubCount() const;
 
 private:
+    PreparedTransaction
+    prepare(
+        std::shared_ptr<data::TransactionAndMetadata const> const& txMetaPtr,
+        ripple::LedgerHeader const& lgrInfo,
+        std::shared_ptr<data::BackendInterface const> const& backend,
+        boost::asio::yield_context yield
+    ) const;
+
+    void
+    emitInOrder(std::uint64_t sequence, std::optional<PreparedTransaction> prepared);
+
+    void
+    emit(PreparedTransaction const& prepared);
+
+    template <typename SubscribeFnType, typename FilterFnType>
+    void
+    subMaybeReplay(
+        SubscriberSharedPtr const& subscriber,
+        std::optional<std::uint32_t> sinceLedger,
+        SubscribeFnType&& subscribeFn,
+        FilterFnType&& filterFn
+    );
+
+    static void
+    send(Subscriber& subscriber, PreparedTransaction const& prepared);
+
+    bool
+    subInternal(
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::shared_ptr<TransactionFilter const> filter
+    );
+
+    bool
+    subInternal(
+        ripple::AccountID const& account,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::shared_ptr<TransactionFilter const> filter
+    );
+
+    bool
+    subInternal(
+        ripple::Book const& book,
+        SubscriberSharedPtr const& subscriber,
+        std::uint32_t apiVersion,
+        std::shared_ptr<TransactionFilter const> filter
+    );
+
     void
     unsubInternal(SubscriberPtr subscriber);
 
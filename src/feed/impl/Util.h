@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "util/prometheus/Counter.h"
 #include "util/prometheus/Gauge.h"
 #include "util/prometheus/Label.h"
 #include "util/prometheus/Prometheus.h"
@@ -38,4 +39,26 @@ getSubscriptionsGaugeInt(std::string const& counterName)
         fmt::format("Current subscribers number on the {} stream", counterName)
     );
 }
+
+inline util::prometheus::CounterInt&
+getReplayCounterInt(std::string const& streamName, std::string const& result)
+{
+    return PrometheusService::counterInt(
+        "subscriptions_replay_total_number",
+        util::prometheus::Labels(
+            {util::prometheus::Label{"stream", streamName}, util::prometheus::Label{"result", result}}
+        ),
+        fmt::format("Total number of resumed subscriptions on the {} stream", streamName)
+    );
+}
+
+inline util::prometheus::GaugeInt&
+getReplayBufferBytesGaugeInt(std::string const& streamName)
+{
+    return PrometheusService::gaugeInt(
+        "subscriptions_replay_buffer_bytes",
+        util::prometheus::Labels({util::prometheus::Label{"stream", streamName}}),
+        fmt::format("Current size of the messages buffered for replay on the {} stream", streamName)
+    );
+}
 }  // namespace feed::impl
@@ -132,13 +132,16 @@ public:
         try {
             LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
 
-            auto const context = Context{ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
-            auto const v = (*method).process(ctx.params, context);
+            auto const context = Context{
+                ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion, ctx.rawBinary, ctx.storage
+            };
+            auto v = (*method).process(ctx.params, context);
 
             LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
 
+            // moved, so the result stays in the arena of the request it was built in
             if (v)
-                return v->as_object();
+                return std::move(v->as_object());
 
             notifyErrored(ctx.method);
             return Status{v.error()};
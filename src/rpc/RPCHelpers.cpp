@@ -20,6 +20,7 @@
 #include "rpc/RPCHelpers.h"
 
 #include "data/BackendInterface.h"
+#include "data/TrustLineAggregatesCache.h"
 #include "data/Types.h"
 #include "rpc/Errors.h"
 #include "rpc/JS.h"
@@ -29,6 +30,7 @@
 #include "web/Context.h"
 
 #include <boost/algorithm/string/case_conv.hpp>
+#include <boost/asio/experimental/concurrent_channel.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/format/format_fwd.hpp>
 #include <boost/format/free_funcs.hpp>
@@ -39,6 +41,7 @@
 #include <boost/json/value.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/lexical_cast/bad_lexical_cast.hpp>
+#include <boost/system/detail/error_code.hpp>
 #include <fmt/core.h>
 #include <ripple/basics/Slice.h>
 #include <ripple/basics/StringUtilities.h>
@@ -89,7 +92,9 @@
 #include <map>
 #include <memory>
 #include <optional>
+#include <set>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -359,11 +364,11 @@ toJson(ripple::SLE const& sle)
 }
 
 boost::json::object
-toJson(ripple::LedgerHeader const& lgrInfo, bool const binary, std::uint32_t const apiVersion)
+toJson(ripple::LedgerHeader const& lgrInfo, bool const binary, std::uint32_t const apiVersion, bool const raw)
 {
     boost::json::object header;
     if (binary) {
-        header[JS(ledger_data)] = ripple::strHex(ledgerInfoToBlob(lgrInfo));
+        header[JS(ledger_data)] = toBinaryString(ledgerInfoToBlob(lgrInfo), raw);
     } else {
         header[JS(account_hash)] = ripple::strHex(lgrInfo.accountHash);
         header[JS(close_flags)] = lgrInfo.closeFlags;
@@ -483,6 +488,31 @@ getLedgerInfoFromHashOrSeq(
     return *lgrInfo;
 }
 
+std::map<std::uint32_t, std::optional<ripple::LedgerHeader>>
+fetchLedgerHeadersFor(
+    BackendInterface const& backend,
+    std::vector<data::TransactionAndMetadata> const& txs,
+    std::uint32_t minSeq,
+    std::uint32_t maxSeq,
+    boost::asio::yield_context yield
+)
+{
+    std::set<std::uint32_t> distinct;
+    for (auto const& tx : txs) {
+        if (tx.ledgerSequence >= minSeq && tx.ledgerSequence <= maxSeq)
+            distinct.insert(tx.ledgerSequence);
+    }
+
+    std::vector<std::uint32_t> const sequences{distinct.begin(), distinct.end()};
+    auto headers = backend.fetchLedgerHeaders(sequences, yield);
+
+    std::map<std::uint32_t, std::optional<ripple::LedgerHeader>> result;
+    for (auto i = 0u; i < sequences.size(); ++i)
+        result.emplace(sequences[i], std::move(headers[i]));
+
+    return result;
+}
+
 std::vector<unsigned char>
 ledgerInfoToBlob(ripple::LedgerHeader const& info, bool includeHash)
 {
@@ -626,6 +656,132 @@ traverseOwnedNodes(
     );
 }
 
+namespace {
+
+/**
+ * @brief Fetches the objects of an owner directory while the directory itself is still being walked.
+ *
+ * Directory pages form a linked list and have to be read one after another, but the objects they point to do not.
+ * Whenever a page boundary is reached with at least CHUNK_SIZE keys pending, those keys are fetched by a separate
+ * coroutine, so that reading the objects overlaps with reading the following pages. When the cache is full for the
+ * requested ledger everything is served from memory and all keys are fetched at once.
+ */
+class OwnedObjectsFetcher {
+    static constexpr std::size_t CHUNK_SIZE = 256;
+    static constexpr std::size_t MAX_CHUNKS_IN_FLIGHT = 4;
+
+    struct Chunk {
+        std::vector<ripple::uint256> keys;
+        std::vector<data::Blob> objects;
+        std::exception_ptr error;
+    };
+
+    using ChannelType = boost::asio::experimental::concurrent_channel<void(boost::system::error_code)>;
+
+    BackendInterface const& backend_;
+    std::uint32_t const sequence_;
+    boost::asio::yield_context yield_;
+    bool const overlap_;
+
+    std::vector<std::shared_ptr<Chunk>> chunks_;
+    std::shared_ptr<ChannelType> done_;
+    std::size_t inFlight_ = 0;
+    std::size_t size_ = 0;
+
+public:
+    OwnedObjectsFetcher(BackendInterface const& backend, std::uint32_t sequence, boost::asio::yield_context yield)
+        : backend_(backend)
+        , sequence_(sequence)
+        , yield_(std::move(yield))
+        , overlap_(not(backend.cache().isFull() and backend.cache().latestLedgerSequence() == sequence))
+        , chunks_{std::make_shared<Chunk>()}
+        , done_(std::make_shared<ChannelType>(yield_.get_executor(), MAX_CHUNKS_IN_FLIGHT))
+    {
+    }
+
+    void
+    add(ripple::uint256 const& key)
+    {
+        chunks_.back()->keys.push_back(key);
+        ++size_;
+    }
+
+    [[nodiscard]] ripple::uint256 const&
+    lastKey() const
+    {
+        return chunks_.back()->keys.back();
+    }
+
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @brief Called before moving on to the next directory page; starts fetching the pending keys if there are enough.
+     */
+    void
+    onPageEnd()
+    {
+        if (not overlap_ or chunks_.back()->keys.size() < CHUNK_SIZE)
+            return;
+
+        if (inFlight_ == MAX_CHUNKS_IN_FLIGHT)
+            waitForOne();
+
+        ++inFlight_;
+        boost::asio::spawn(
+            yield_.get_executor(),
+            [chunk = chunks_.back(), done = done_, &backend = backend_, sequence = sequence_](auto yield) {
+                try {
+                    chunk->objects = backend.fetchLedgerObjects(chunk->keys, sequence, yield);
+                } catch (...) {
+                    chunk->error = std::current_exception();
+                }
+                done->try_send(boost::system::error_code{});
+            }
+        );
+
+        chunks_.push_back(std::make_shared<Chunk>());
+    }
+
+    /**
+     * @brief Fetch the remaining keys, wait for the chunks in flight and hand all objects over in directory order.
+     *
+     * @param atOwnedNode The callback to invoke for each object
+     */
+    void
+    finish(std::function<void(ripple::SLE)> const& atOwnedNode)
+    {
+        auto& last = *chunks_.back();
+        last.objects = backend_.fetchLedgerObjects(last.keys, sequence_, yield_);
+
+        while (inFlight_ > 0)
+            waitForOne();
+
+        for (auto const& chunk : chunks_) {
+            if (chunk->error)
+                std::rethrow_exception(chunk->error);
+
+            for (auto i = 0u; i < chunk->objects.size(); ++i) {
+                ripple::SerialIter it{chunk->objects[i].data(), chunk->objects[i].size()};
+                atOwnedNode(ripple::SLE{it, chunk->keys[i]});
+            }
+        }
+    }
+
+private:
+    void
+    waitForOne()
+    {
+        done_->async_receive(yield_);
+        --inFlight_;
+    }
+};
+
+}  // namespace
+
 std::variant<Status, AccountCursor>
 traverseOwnedNodes(
     BackendInterface const& backend,
@@ -645,12 +801,8 @@ traverseOwnedNodes(
     // track the current page we are accessing, will return it as the next hint
     auto currentPage = startHint;
 
-    std::vector<ripple::uint256> keys;
-    // Only reserve 2048 nodes when fetching all owned ledger objects. If there
-    // are more, then keys will allocate more memory, which is suboptimal, but
-    // should only occur occasionally.
-    static std::uint32_t constexpr MIN_NODES = 2048;
-    keys.reserve(std::min(MIN_NODES, limit));
+    // objects are fetched in chunks while the directory pages are still being read
+    OwnedObjectsFetcher fetcher{backend, sequence, yield};
 
     auto start = std::chrono::system_clock::now();
 
@@ -687,7 +839,7 @@ traverseOwnedNodes(
                     if (key == hexMarker)
                         found = true;
                 } else {
-                    keys.push_back(key);
+                    fetcher.add(key);
 
                     if (--limit == 0) {
                         break;
@@ -696,7 +848,7 @@ traverseOwnedNodes(
             }
 
             if (limit == 0) {
-                cursor = AccountCursor({keys.back(), currentPage});
+                cursor = AccountCursor({fetcher.lastKey(), currentPage});
                 break;
             }
             // the next page
@@ -704,6 +856,7 @@ traverseOwnedNodes(
             if (uNodeNext == 0)
                 break;
 
+            fetcher.onPageEnd();
             currentIndex = ripple::keylet::page(rootIndex, uNodeNext);
             currentPage = uNodeNext;
         }
@@ -718,14 +871,14 @@ traverseOwnedNodes(
             ripple::SLE const ownedDirSle{ownedDirIt, currentIndex.key};
 
             for (auto const& key : ownedDirSle.getFieldV256(ripple::sfIndexes)) {
-                keys.push_back(key);
+                fetcher.add(key);
 
                 if (--limit == 0)
                     break;
             }
 
             if (limit == 0) {
-                cursor = AccountCursor({keys.back(), currentPage});
+                cursor = AccountCursor({fetcher.lastKey(), currentPage});
                 break;
             }
 
@@ -733,6 +886,7 @@ traverseOwnedNodes(
             if (uNodeNext == 0)
                 break;
 
+            fetcher.onPageEnd();
             currentIndex = ripple::keylet::page(rootIndex, uNodeNext);
             currentPage = uNodeNext;
         }
@@ -742,24 +896,106 @@ traverseOwnedNodes(
     LOG(gLog.debug()) << fmt::format(
         "Time loading owned directories: {} milliseconds, entries size: {}",
         std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(),
-        keys.size()
+        fetcher.size()
     );
 
-    auto [objects, timeDiff] = util::timed([&]() { return backend.fetchLedgerObjects(keys, sequence, yield); });
+    auto const timeDiff = util::timed([&]() { fetcher.finish(atOwnedNode); });
 
     LOG(gLog.debug()) << "Time loading owned entries: " << timeDiff << " milliseconds";
 
-    for (auto i = 0u; i < objects.size(); ++i) {
-        ripple::SerialIter it{objects[i].data(), objects[i].size()};
-        atOwnedNode(ripple::SLE{it, keys[i]});
-    }
-
     if (limit == 0)
         return cursor;
 
     return AccountCursor({beast::zero, 0});
 }
 
+std::variant<Status, std::shared_ptr<data::TrustLineAggregates const>>
+fetchTrustLineAggregates(
+    BackendInterface const& backend,
+    ripple::AccountID const& accountID,
+    std::uint32_t const sequence,
+    std::set<ripple::AccountID> const& hotWallets,
+    boost::asio::yield_context yield
+)
+{
+    auto& memo = backend.trustLineAggregates();
+    if (hotWallets.empty()) {
+        if (auto cached = memo.get(accountID, sequence); cached)
+            return cached;
+    }
+
+    auto aggregates = std::make_shared<data::TrustLineAggregates>();
+    auto const addTrustLine = [&](ripple::SLE const& sle) {
+        if (sle.getType() != ripple::ltRIPPLE_STATE)
+            return;
+
+        ripple::STAmount balance = sle.getFieldAmount(ripple::sfBalance);
+        auto const lowLimit = sle.getFieldAmount(ripple::sfLowLimit);
+        auto const highLimit = sle.getFieldAmount(ripple::sfHighLimit);
+        auto const viewLowest = (lowLimit.getIssuer() == accountID);
+        auto const& lineLimit = viewLowest ? lowLimit : highLimit;
+        auto const& lineLimitPeer = viewLowest ? highLimit : lowLimit;
+        auto const flags = sle.getFieldU32(ripple::sfFlags);
+        auto const freeze = flags & (viewLowest ? ripple::lsfLowFreeze : ripple::lsfHighFreeze);
+
+        if (!viewLowest)
+            balance.negate();
+
+        if (balance < lineLimit)
+            aggregates->receiveCurrencies.insert(ripple::to_string(balance.getCurrency()));
+
+        if ((-balance) < lineLimitPeer)
+            aggregates->sendCurrencies.insert(ripple::to_string(balance.getCurrency()));
+
+        auto const balSign = balance.signum();
+        if (balSign == 0)
+            return;
+
+        auto const& peer = lineLimitPeer.getIssuer();
+
+        // Here, a negative balance means the cold wallet owes (normal)
+        // A positive balance means the cold wallet has an asset (unusual)
+
+        if (hotWallets.contains(peer)) {
+            // This is a specified hot wallet
+            aggregates->hotBalances[peer].push_back(-balance);
+        } else if (balSign > 0) {
+            // This is a gateway asset
+            aggregates->assets[peer].push_back(balance);
+        } else if (freeze != 0u) {
+            // An obligation the gateway has frozen
+            aggregates->frozenBalances[peer].push_back(-balance);
+        } else {
+            // normal negative balance, obligation to customer
+            auto& bal = aggregates->obligations[balance.getCurrency()];
+            if (bal == beast::zero) {
+                // This is needed to set the currency code correctly
+                bal = -balance;
+            } else {
+                try {
+                    bal -= balance;
+                } catch (std::runtime_error const& e) {
+                    bal = ripple::STAmount(bal.issue(), ripple::STAmount::cMaxValue, ripple::STAmount::cMaxOffset);
+                }
+            }
+        }
+    };
+
+    // traverse all owned nodes, limit->max, marker->empty
+    auto const ret = traverseOwnedNodes(
+        backend, accountID, sequence, std::numeric_limits<std::uint32_t>::max(), {}, yield, addTrustLine
+    );
+
+    if (auto const status = std::get_if<Status>(&ret))
+        return *status;
+
+    std::shared_ptr<data::TrustLineAggregates const> result = std::move(aggregates);
+    if (hotWallets.empty())
+        memo.put(accountID, sequence, result);
+
+    return result;
+}
+
 std::shared_ptr<ripple::SLE const>
 read(
     std::shared_ptr<data::BackendInterface const> const& backend,
@@ -1399,13 +1635,22 @@ isAmendmentEnabled(
 }
 
 boost::json::object
-toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_t const apiVersion)
+toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_t const apiVersion, bool const raw)
 {
     boost::json::object obj{};
     auto const metaKey = apiVersion > 1 ? JS(meta_blob) : JS(meta);
-    obj[metaKey] = ripple::strHex(txnPlusMeta.metadata);
-    obj[JS(tx_blob)] = ripple::strHex(txnPlusMeta.transaction);
+    obj[metaKey] = toBinaryString(txnPlusMeta.metadata, raw);
+    obj[JS(tx_blob)] = toBinaryString(txnPlusMeta.transaction, raw);
     return obj;
 }
 
+std::string
+toBinaryString(data::Blob const& blob, bool const raw)
+{
+    if (raw)
+        return std::string{blob.begin(), blob.end()};
+
+    return ripple::strHex(blob);
+}
+
 }  // namespace rpc
@@ -25,6 +25,7 @@
  */
 
 #include "data/BackendInterface.h"
+#include "data/TrustLineAggregatesCache.h"
 #include "rpc/Amendments.h"
 #include "rpc/JS.h"
 #include "rpc/common/Types.h"
@@ -82,10 +83,20 @@ toExpandedJson(
  * the apiVersion, the key is "tx_blob" and "meta" or "meta_blob".
  * @param txnPlusMeta The TransactionAndMetadata to convert.
  * @param apiVersion The api version
+ * @param raw Whether to keep the raw bytes instead of hex, for responses sent as MessagePack.
  * @return The JSON object containing tx and metadata data in hex format.
  */
 boost::json::object
-toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_t apiVersion);
+toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_t apiVersion, bool raw = false);
+
+/**
+ * @brief Encode a blob for a response to a request with "binary": true.
+ * @param blob The blob to encode.
+ * @param raw Whether to keep the raw bytes instead of hex, for responses sent as MessagePack.
+ * @return The raw bytes if raw is set; the blob in hex format otherwise.
+ */
+std::string
+toBinaryString(data::Blob const& blob, bool raw);
 
 /**
  * @brief Add "DeliverMax" which is the alias of "Amount" for "Payment" transaction to transaction json. Remove the
@@ -96,6 +107,20 @@ toJsonWithBinaryTx(data::TransactionAndMetadata const& txnPlusMeta, std::uint32_
 void
 insertDeliverMaxAlias(boost::json::object& txJson, std::uint32_t apiVersion);
 
+std::optional<ripple::STAmount>
+getDeliveredAmount(
+    std::shared_ptr<ripple::STTx const> const& txn,
+    std::shared_ptr<ripple::TxMeta const> const& meta,
+    std::uint32_t ledgerSequence,
+    uint32_t date
+);
+
+bool
+canHaveDeliveredAmount(
+    std::shared_ptr<ripple::STTx const> const& txn,
+    std::shared_ptr<ripple::TxMeta const> const& meta
+);
+
 bool
 insertDeliveredAmount(
     boost::json::object& metaJson,
@@ -116,10 +141,11 @@ toJson(ripple::SLE const& sle);
  * @param entry The LedgerHeader to convert.
  * @param binary Whether to convert in hex format.
  * @param apiVersion The api version
+ * @param raw Whether to keep the raw bytes of a binary header instead of hex, for responses sent as MessagePack.
  * @return The JSON object.
  */
 boost::json::object
-toJson(ripple::LedgerHeader const& info, bool binary, std::uint32_t apiVersion);
+toJson(ripple::LedgerHeader const& info, bool binary, std::uint32_t apiVersion, bool raw = false);
 
 boost::json::object
 toJson(ripple::TxMeta const& meta);
@@ -148,6 +174,27 @@ getLedgerInfoFromHashOrSeq(
     uint32_t maxSeq
 );
 
+/**
+ * @brief Fetch the headers of the distinct ledgers that the given transactions belong to in a single batch.
+ *
+ * Only ledgers within [minSeq, maxSeq] are fetched; ledgers that could not be found map to std::nullopt.
+ *
+ * @param backend The backend to fetch from
+ * @param txs The transactions whose ledgers are needed
+ * @param minSeq The lowest ledger sequence of interest
+ * @param maxSeq The highest ledger sequence of interest
+ * @param yield The coroutine context
+ * @return The headers keyed by ledger sequence
+ */
+std::map<std::uint32_t, std::optional<ripple::LedgerHeader>>
+fetchLedgerHeadersFor(
+    BackendInterface const& backend,
+    std::vector<data::TransactionAndMetadata> const& txs,
+    std::uint32_t minSeq,
+    std::uint32_t maxSeq,
+    boost::asio::yield_context yield
+);
+
 std::variant<Status, AccountCursor>
 traverseOwnedNodes(
     BackendInterface const& backend,
@@ -174,6 +221,28 @@ traverseOwnedNodes(
     bool nftIncluded = false
 );
 
+/**
+ * @brief Summarize the trust lines of an account for gateway_balances and account_currencies.
+ *
+ * Summaries without hot wallets are memoized in the backend and reused for as long as none of the trust lines of the
+ * account change; otherwise all trust lines of the account are walked.
+ *
+ * @param backend The backend to use
+ * @param accountID The account to summarize
+ * @param sequence The ledger sequence
+ * @param hotWallets Accounts whose balances are reported separately instead of being added to the obligations
+ * @param yield The coroutine context
+ * @return The summary or an error status
+ */
+std::variant<Status, std::shared_ptr<data::TrustLineAggregates const>>
+fetchTrustLineAggregates(
+    BackendInterface const& backend,
+    ripple::AccountID const& accountID,
+    std::uint32_t sequence,
+    std::set<ripple::AccountID> const& hotWallets,
+    boost::asio::yield_context yield
+);
+
 std::shared_ptr<ripple::SLE const>
 read(
     std::shared_ptr<data::BackendInterface const> const& backend,
@@ -23,6 +23,7 @@
 #include "util/Expected.h"
 
 #include <boost/asio/spawn.hpp>
+#include <boost/json/storage_ptr.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
 #include <ripple/basics/base_uint.h>
@@ -85,6 +86,8 @@ struct Context {
     bool isAdmin = false;
     std::string clientIp = {};
     uint32_t apiVersion = 0u;  // invalid by default
+    bool rawBinary = false;    // blobs are returned as raw bytes instead of hex for responses sent as MessagePack
+    boost::json::storage_ptr storage = {};  // the arena of the request, the result is built in it
 };
 
 /**
@@ -39,7 +39,7 @@ struct DefaultProcessor final {
         using boost::json::value_to;
         if constexpr (SomeHandlerWithInput<HandlerType>) {
             // first we run validation against specified API version
-            auto const spec = handler.spec(ctx.apiVersion);
+            auto const& spec = handler.spec(ctx.apiVersion);
             auto input = value;  // copy here, spec require mutable data
 
             if (auto const ret = spec.process(input); not ret)
@@ -52,14 +52,14 @@ struct DefaultProcessor final {
             if (!ret) {
                 return Error{ret.error()};  // forward Status
             }
-            return value_from(ret.value());
+            return value_from(ret.value(), ctx.storage);
         } else if constexpr (SomeHandlerWithoutInput<HandlerType>) {
             // no input to pass, ignore the value
             auto const ret = handler.process(ctx);
             if (not ret) {
                 return Error{ret.error()};  // forward Status
             }
-            return value_from(ret.value());
+            return value_from(ret.value(), ctx.storage);
         } else {
             // when concept SomeHandlerWithInput and SomeHandlerWithoutInput not cover all Handler case
             static_assert(unsupported_handler_v<HandlerType>);
@@ -167,25 +167,24 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountChannelsH
 {
     using boost::json::value_from;
 
-    auto obj = boost::json::object{
+    jv = {
         {JS(account), output.account},
         {JS(ledger_hash), output.ledgerHash},
         {JS(ledger_index), output.ledgerIndex},
         {JS(validated), output.validated},
         {JS(limit), output.limit},
-        {JS(channels), value_from(output.channels)},
+        {JS(channels), value_from(output.channels, jv.storage())},
     };
+    auto& obj = jv.as_object();
 
     if (output.marker)
         obj[JS(marker)] = output.marker.value();
-
-    jv = std::move(obj);
 }
 
 void
 tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountChannelsHandler::ChannelResponse const& channel)
 {
-    auto obj = boost::json::object{
+    jv = {
         {JS(channel_id), channel.channelID},
         {JS(account), channel.account},
         {JS(destination_account), channel.accountDestination},
@@ -193,6 +192,7 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountChannelsH
         {JS(balance), channel.balance},
         {JS(settle_delay), channel.settleDelay},
     };
+    auto& obj = jv.as_object();
 
     if (channel.publicKey)
         obj[JS(public_key)] = *(channel.publicKey);
@@ -211,7 +211,5 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountChannelsH
 
     if (channel.destinationTag)
         obj[JS(destination_tag)] = *(channel.destinationTag);
-
-    jv = std::move(obj);
 }
 }  // namespace rpc
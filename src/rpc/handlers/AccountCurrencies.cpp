@@ -19,6 +19,7 @@
 
 #include "rpc/handlers/AccountCurrencies.h"
 
+#include "data/TrustLineAggregatesCache.h"
 #include "rpc/Errors.h"
 #include "rpc/JS.h"
 #include "rpc/RPCHelpers.h"
@@ -29,15 +30,10 @@
 #include <ripple/basics/strHex.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/Indexes.h>
-#include <ripple/protocol/LedgerFormats.h>
 #include <ripple/protocol/LedgerHeader.h>
-#include <ripple/protocol/SField.h>
-#include <ripple/protocol/STLedgerEntry.h>
-#include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 
-#include <cstdint>
-#include <limits>
+#include <memory>
 #include <string>
 #include <variant>
 
@@ -61,40 +57,14 @@ AccountCurrenciesHandler::process(AccountCurrenciesHandler::Input input, Context
     if (!accountLedgerObject)
         return Error{Status{RippledError::rpcACT_NOT_FOUND, "accountNotFound"}};
 
-    Output response;
-    auto const addToResponse = [&](ripple::SLE const sle) {
-        if (sle.getType() == ripple::ltRIPPLE_STATE) {
-            auto balance = sle.getFieldAmount(ripple::sfBalance);
-            auto const lowLimit = sle.getFieldAmount(ripple::sfLowLimit);
-            auto const highLimit = sle.getFieldAmount(ripple::sfHighLimit);
-            bool const viewLowest = (lowLimit.getIssuer() == accountID);
-            auto const lineLimit = viewLowest ? lowLimit : highLimit;
-            auto const lineLimitPeer = !viewLowest ? lowLimit : highLimit;
-
-            if (!viewLowest)
-                balance.negate();
-
-            if (balance < lineLimit)
-                response.receiveCurrencies.insert(ripple::to_string(balance.getCurrency()));
-
-            if ((-balance) < lineLimitPeer)
-                response.sendCurrencies.insert(ripple::to_string(balance.getCurrency()));
-        }
-
-        return true;
-    };
-
-    // traverse all owned nodes, limit->max, marker->empty
-    traverseOwnedNodes(
-        *sharedPtrBackend_,
-        *accountID,
-        lgrInfo.seq,
-        std::numeric_limits<std::uint32_t>::max(),
-        {},
-        ctx.yield,
-        addToResponse
-    );
+    auto const aggregates = fetchTrustLineAggregates(*sharedPtrBackend_, *accountID, lgrInfo.seq, {}, ctx.yield);
+    if (auto const status = std::get_if<Status>(&aggregates))
+        return Error{*status};
 
+    auto const& summary = *std::get<std::shared_ptr<data::TrustLineAggregates const>>(aggregates);
+    Output response;
+    response.receiveCurrencies = summary.receiveCurrencies;
+    response.sendCurrencies = summary.sendCurrencies;
     response.ledgerHash = ripple::strHex(lgrInfo.hash);
     response.ledgerIndex = lgrInfo.seq;
 
@@ -215,19 +215,18 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountLinesHand
 {
     using boost::json::value_from;
 
-    auto obj = boost::json::object{
+    jv = {
         {JS(account), output.account},
         {JS(ledger_hash), output.ledgerHash},
         {JS(ledger_index), output.ledgerIndex},
         {JS(validated), output.validated},
         {JS(limit), output.limit},
-        {JS(lines), value_from(output.lines)},
+        {JS(lines), value_from(output.lines, jv.storage())},
     };
+    auto& obj = jv.as_object();
 
     if (output.marker)
         obj[JS(marker)] = output.marker.value();
-
-    jv = std::move(obj);
 }
 
 void
@@ -237,7 +236,7 @@ tag_invoke(
     [[maybe_unused]] AccountLinesHandler::LineResponse const& line
 )
 {
-    auto obj = boost::json::object{
+    jv = {
         {JS(account), line.account},
         {JS(balance), line.balance},
         {JS(currency), line.currency},
@@ -246,6 +245,7 @@ tag_invoke(
         {JS(quality_in), line.qualityIn},
         {JS(quality_out), line.qualityOut},
     };
+    auto& obj = jv.as_object();
 
     obj[JS(no_ripple)] = line.noRipple;
     obj[JS(no_ripple_peer)] = line.noRipplePeer;
@@ -261,8 +261,6 @@ tag_invoke(
 
     if (line.freezePeer)
         obj[JS(freeze_peer)] = *(line.freezePeer);
-
-    jv = std::move(obj);
 }
 
 }  // namespace rpc
@@ -43,6 +43,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <map>
 #include <optional>
 #include <string>
 #include <utility>
@@ -120,8 +121,10 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 
     auto const limit = input.limit.value_or(LIMIT_DEFAULT);
     auto const accountID = accountFromStringStrict(input.account);
-    auto const [txnsAndCursor, timeDiff] = util::timed([&]() {
-        return sharedPtrBackend_->fetchAccountTransactions(*accountID, limit, input.forward, cursor, ctx.yield);
+    auto const [txnsAndCursor, timeDiff] = util::timed([&, minSequence = minIndex, maxSequence = maxIndex]() {
+        return sharedPtrBackend_->fetchAccountTransactionsInRange(
+            *accountID, limit, input.forward, cursor, minSequence, maxSequence, ctx.yield
+        );
     });
 
     LOG(log_.info()) << "db fetch took " << timeDiff << " milliseconds - num blobs = " << txnsAndCursor.txns.size();
@@ -132,6 +135,18 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
     if (retCursor)
         response.marker = {retCursor->ledgerSequence, retCursor->transactionIndex};
 
+    // ledger headers are only needed for the expanded api v2 output; fetch each distinct ledger once
+    std::map<std::uint32_t, std::optional<ripple::LedgerHeader>> ledgerHeaders;
+    if (ctx.apiVersion > 1u and not input.binary and not input.transactionTypeInLowercase)
+        ledgerHeaders = fetchLedgerHeadersFor(*sharedPtrBackend_, blobs, minIndex, maxIndex, ctx.yield);
+
+    auto const ledgerHeaderFor = [&](std::uint32_t seq) {
+        auto it = ledgerHeaders.find(seq);
+        if (it == ledgerHeaders.end())
+            it = ledgerHeaders.emplace(seq, sharedPtrBackend_->fetchLedgerBySequence(seq, ctx.yield)).first;
+        return it->second;
+    };
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -169,9 +184,7 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
                         obj[JS(hash)] = obj[txKey].as_object()[JS(hash)];
                         obj[txKey].as_object().erase(JS(hash));
                     }
-                    if (auto const ledgerInfo =
-                            sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                        ledgerInfo) {
+                    if (auto const ledgerInfo = ledgerHeaderFor(txnPlusMeta.ledgerSequence); ledgerInfo) {
                         obj[JS(ledger_hash)] = ripple::strHex(ledgerInfo->hash);
                         obj[JS(close_time_iso)] = ripple::to_string_iso(ledgerInfo->closeTime);
                     }
@@ -182,7 +195,7 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
             }
         }
         // binary is true
-        obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion);
+        obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion, ctx.rawBinary);
         obj[JS(validated)] = true;
         obj[JS(ledger_index)] = txnPlusMeta.ledgerSequence;
         response.transactions.push_back(std::move(obj));
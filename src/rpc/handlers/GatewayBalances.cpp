@@ -19,6 +19,7 @@
 
 #include "rpc/handlers/GatewayBalances.h"
 
+#include "data/TrustLineAggregatesCache.h"
 #include "rpc/Errors.h"
 #include "rpc/JS.h"
 #include "rpc/RPCHelpers.h"
@@ -29,24 +30,18 @@
 #include <boost/json/object.hpp>
 #include <boost/json/value.hpp>
 #include <ripple/basics/strHex.h>
-#include <ripple/beast/utility/Zero.h>
 #include <ripple/protocol/AccountID.h>
 #include <ripple/protocol/ErrorCodes.h>
 #include <ripple/protocol/Indexes.h>
-#include <ripple/protocol/LedgerFormats.h>
 #include <ripple/protocol/LedgerHeader.h>
-#include <ripple/protocol/SField.h>
 #include <ripple/protocol/STAmount.h>
-#include <ripple/protocol/STLedgerEntry.h>
 #include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 
 #include <algorithm>
-#include <cstdint>
 #include <iterator>
-#include <limits>
 #include <map>
-#include <stdexcept>
+#include <memory>
 #include <string>
 #include <utility>
 #include <variant>
@@ -75,73 +70,19 @@ GatewayBalancesHandler::process(GatewayBalancesHandler::Input input, Context con
     if (!accountLedgerObject)
         return Error{Status{RippledError::rpcACT_NOT_FOUND, "accountNotFound"}};
 
-    auto output = GatewayBalancesHandler::Output{};
-
-    auto const addToResponse = [&](ripple::SLE const sle) {
-        if (sle.getType() == ripple::ltRIPPLE_STATE) {
-            ripple::STAmount balance = sle.getFieldAmount(ripple::sfBalance);
-            auto const lowLimit = sle.getFieldAmount(ripple::sfLowLimit);
-            auto const highLimit = sle.getFieldAmount(ripple::sfHighLimit);
-            auto const lowID = lowLimit.getIssuer();
-            auto const highID = highLimit.getIssuer();
-            auto const viewLowest = (lowLimit.getIssuer() == accountID);
-            auto const flags = sle.getFieldU32(ripple::sfFlags);
-            auto const freeze = flags & (viewLowest ? ripple::lsfLowFreeze : ripple::lsfHighFreeze);
-
-            if (!viewLowest)
-                balance.negate();
-
-            auto const balSign = balance.signum();
-            if (balSign == 0)
-                return true;
-
-            auto const& peer = !viewLowest ? lowID : highID;
-
-            // Here, a negative balance means the cold wallet owes (normal)
-            // A positive balance means the cold wallet has an asset (unusual)
-
-            if (input.hotWallets.contains(peer)) {
-                // This is a specified hot wallet
-                output.hotBalances[peer].push_back(-balance);
-            } else if (balSign > 0) {
-                // This is a gateway asset
-                output.assets[peer].push_back(balance);
-            } else if (freeze != 0u) {
-                // An obligation the gateway has frozen
-                output.frozenBalances[peer].push_back(-balance);
-            } else {
-                // normal negative balance, obligation to customer
-                auto& bal = output.sums[balance.getCurrency()];
-                if (bal == beast::zero) {
-                    // This is needed to set the currency code correctly
-                    bal = -balance;
-                } else {
-                    try {
-                        bal -= balance;
-                    } catch (std::runtime_error const& e) {
-                        bal = ripple::STAmount(bal.issue(), ripple::STAmount::cMaxValue, ripple::STAmount::cMaxOffset);
-                    }
-                }
-            }
-        }
+    auto const aggregates =
+        fetchTrustLineAggregates(*sharedPtrBackend_, *accountID, lgrInfo.seq, input.hotWallets, ctx.yield);
 
-        return true;
-    };
-
-    // traverse all owned nodes, limit->max, marker->empty
-    auto const ret = traverseOwnedNodes(
-        *sharedPtrBackend_,
-        *accountID,
-        lgrInfo.seq,
-        std::numeric_limits<std::uint32_t>::max(),
-        {},
-        ctx.yield,
-        addToResponse
-    );
-
-    if (auto status = std::get_if<Status>(&ret))
+    if (auto const status = std::get_if<Status>(&aggregates))
         return Error{*status};
 
+    auto const& summary = *std::get<std::shared_ptr<data::TrustLineAggregates const>>(aggregates);
+    auto output = GatewayBalancesHandler::Output{};
+    output.sums = summary.obligations;
+    output.hotBalances = summary.hotBalances;
+    output.assets = summary.assets;
+    output.frozenBalances = summary.frozenBalances;
+
     auto inHotbalances = [&](auto const& hw) { return output.hotBalances.contains(hw); };
     if (not std::all_of(input.hotWallets.begin(), input.hotWallets.end(), inHotbalances))
         return Error{Status{ClioError::rpcINVALID_HOT_WALLET}};
@@ -156,7 +97,7 @@ GatewayBalancesHandler::process(GatewayBalancesHandler::Input input, Context con
 void
 tag_invoke(boost::json::value_from_tag, boost::json::value& jv, GatewayBalancesHandler::Output const& output)
 {
-    boost::json::object obj;
+    boost::json::object obj(jv.storage());
     if (!output.sums.empty()) {
         boost::json::object obligations;
         for (auto const& [k, v] : output.sums)
@@ -61,7 +61,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
     auto const lgrInfo = std::get<ripple::LedgerHeader>(lgrInfoOrStatus);
     Output output;
 
-    output.header = toJson(lgrInfo, input.binary, ctx.apiVersion);
+    output.header = toJson(lgrInfo, input.binary, ctx.apiVersion, ctx.rawBinary);
 
     if (input.transactions) {
         output.header[JS(transactions)] = boost::json::value(boost::json::array_kind);
@@ -76,7 +76,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
                     txn[JS(metaData)] = std::move(meta);
                     return txn;
                 }
-                return toJsonWithBinaryTx(tx, ctx.apiVersion);
+                return toJsonWithBinaryTx(tx, ctx.apiVersion, ctx.rawBinary);
             };
 
             auto const isoTimeStr = ripple::to_string_iso(lgrInfo.closeTime);
@@ -104,7 +104,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
                     return entry;
                 }
 
-                auto entry = toJsonWithBinaryTx(tx, ctx.apiVersion);
+                auto entry = toJsonWithBinaryTx(tx, ctx.apiVersion, ctx.rawBinary);
                 if (txn.contains(JS(hash)))
                     entry[JS(hash)] = txn.at(JS(hash));
                 return entry;
@@ -166,7 +166,7 @@ LedgerHandler::process(LedgerHandler::Input input, Context const& ctx) const
             entry["object_id"] = ripple::strHex(obj.key);
 
             if (input.binary) {
-                entry["object"] = ripple::strHex(obj.blob);
+                entry["object"] = toBinaryString(obj.blob, ctx.rawBinary);
             } else if (!obj.blob.empty()) {
                 ripple::STLedgerEntry const sle{ripple::SerialIter{obj.blob.data(), obj.blob.size()}, obj.key};
                 entry["object"] = toJson(sle);
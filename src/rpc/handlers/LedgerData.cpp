@@ -42,6 +42,7 @@
 #include <algorithm>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <string>
 #include <unordered_map>
@@ -52,6 +53,13 @@
 
 namespace rpc {
 
+namespace {
+
+// field header of sfLedgerEntryType: type STI_UINT16 (1) and field code 1
+constexpr unsigned char LEDGER_ENTRY_TYPE_FIELD = 0x11;
+
+}  // namespace
+
 std::unordered_map<std::string, ripple::LedgerEntryType> const LedgerDataHandler::TYPES_MAP{
     {JS(account), ripple::ltACCOUNT_ROOT},
     {JS(did), ripple::ltDID},
@@ -91,6 +99,15 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     if (!input.outOfOrder && input.diffMarker)
         return Error{Status{RippledError::rpcINVALID_PARAMS, "markerNotString"}};
 
+    if (input.bulk && input.outOfOrder)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "bulkWithOutOfOrder"}};
+
+    if (!input.bulk && input.endMarker)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "endMarkerWithoutBulk"}};
+
+    if (input.endMarker && input.marker && *input.endMarker <= *input.marker)
+        return Error{Status{RippledError::rpcINVALID_PARAMS, "endMarkerNotAfterMarker"}};
+
     auto const range = sharedPtrBackend_->fetchLedgerRange();
     auto const lgrInfoOrStatus = getLedgerInfoFromHashOrSeq(
         *sharedPtrBackend_, ctx.yield, input.ledgerHash, input.ledgerIndex, range->maxSequence
@@ -105,7 +122,7 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
 
     // no marker -> first call, return header information
     if ((!input.marker) && (!input.diffMarker)) {
-        output.header = toJson(lgrInfo, input.binary, ctx.apiVersion);
+        output.header = toJson(lgrInfo, input.binary, ctx.apiVersion, ctx.rawBinary);
     } else {
         if (input.marker && !sharedPtrBackend_->fetchLedgerObject(*(input.marker), lgrInfo.seq, ctx.yield))
             return Error{Status{RippledError::rpcINVALID_PARAMS, "markerDoesNotExist"}};
@@ -114,6 +131,9 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     output.ledgerHash = ripple::strHex(lgrInfo.hash);
     output.ledgerIndex = lgrInfo.seq;
 
+    if (input.bulk)
+        return processBulk(input, lgrInfo, std::move(output));
+
     auto const start = std::chrono::system_clock::now();
     std::vector<data::LedgerObject> results;
 
@@ -165,7 +185,7 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
         if (input.type == ripple::LedgerEntryType::ltANY || sle.getType() == input.type) {
             if (input.binary) {
                 boost::json::object entry;
-                entry[JS(data)] = ripple::serializeHex(sle);
+                entry[JS(data)] = toBinaryString(object, ctx.rawBinary);
                 entry[JS(index)] = ripple::to_string(sle.key());
                 output.states.push_back(std::move(entry));
             } else {
@@ -184,15 +204,64 @@ LedgerDataHandler::process(Input input, Context const& ctx) const
     return output;
 }
 
+LedgerDataHandler::Result
+LedgerDataHandler::processBulk(Input const& input, ripple::LedgerHeader const& lgrInfo, Output output) const
+{
+    auto const limit =
+        std::min(input.limit, input.binary ? LedgerDataHandler::LIMITBULKBINARY : LedgerDataHandler::LIMITBULKJSON);
+
+    // sfLedgerEntryType sorts first in a serialized ledger entry, so the type can be checked without parsing
+    auto const filter = [type = input.type](data::Blob const& blob) {
+        if (type == ripple::LedgerEntryType::ltANY)
+            return true;
+
+        return blob.size() >= 3 and blob[0] == LEDGER_ENTRY_TYPE_FIELD and
+            static_cast<std::uint16_t>((blob[1] << 8) | blob[2]) == type;
+    };
+
+    auto const start = std::chrono::system_clock::now();
+    auto page = sharedPtrBackend_->cache().getPage(input.marker, input.endMarker, lgrInfo.seq, limit, filter);
+    if (!page)
+        return Error{Status{RippledError::rpcNOT_SUPPORTED, "bulkRequiresFullCacheOfLatestLedger"}};
+
+    auto const end = std::chrono::system_clock::now();
+
+    if (page->cursor)
+        output.marker = ripple::strHex(*(page->cursor));
+
+    output.states.reserve(page->objects.size());
+    for (auto const& [key, object] : page->objects) {
+        if (input.binary) {
+            // the stored blob is the canonical serialization already, no need to parse it
+            boost::json::object entry;
+            entry[JS(data)] = toBinaryString(object, ctx.rawBinary);
+            entry[JS(index)] = ripple::to_string(key);
+            output.states.push_back(std::move(entry));
+        } else {
+            ripple::STLedgerEntry const sle{ripple::SerialIter{object.data(), object.size()}, key};
+            output.states.push_back(toJson(sle));
+        }
+    }
+
+    auto const end2 = std::chrono::system_clock::now();
+    LOG(log_.debug()) << "Bulk: number of results = " << page->objects.size() << " read from cache in "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()
+                      << " microseconds, serialized in "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(end2 - end).count() << " microseconds";
+
+    return output;
+}
+
 void
 tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerDataHandler::Output const& output)
 {
-    auto obj = boost::json::object{
+    jv = {
         {JS(ledger_hash), output.ledgerHash},
         {JS(ledger_index), output.ledgerIndex},
         {JS(validated), output.validated},
         {JS(state), output.states},
     };
+    auto& obj = jv.as_object();
 
     if (output.header)
         obj[JS(ledger)] = *(output.header);
@@ -205,8 +274,6 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerDataHandle
     } else if (output.marker) {
         obj[JS(marker)] = *(output.marker);
     }
-
-    jv = std::move(obj);
 }
 
 LedgerDataHandler::Input
@@ -226,6 +293,15 @@ tag_invoke(boost::json::value_to_tag<LedgerDataHandler::Input>, boost::json::val
     if (jsonObject.contains("out_of_order"))
         input.outOfOrder = jsonObject.at("out_of_order").as_bool();
 
+    if (jsonObject.contains("bulk"))
+        input.bulk = jsonObject.at("bulk").as_bool();
+
+    if (jsonObject.contains("end_marker"))
+        input.endMarker = ripple::uint256{jsonObject.at("end_marker").as_string().c_str()};
+
+    if (input.bulk && !jsonObject.contains(JS(limit)))
+        input.limit = input.binary ? LedgerDataHandler::LIMITBULKBINARY : LedgerDataHandler::LIMITBULKJSON;
+
     if (jsonObject.contains("marker")) {
         if (jsonObject.at("marker").is_string()) {
             input.marker = ripple::uint256{jsonObject.at("marker").as_string().c_str()};
@@ -49,6 +49,8 @@ public:
     // constants
     static uint32_t constexpr LIMITBINARY = 2048;
     static uint32_t constexpr LIMITJSON = 256;
+    static uint32_t constexpr LIMITBULKBINARY = 65536;
+    static uint32_t constexpr LIMITBULKJSON = 16384;
 
     struct Output {
         uint32_t ledgerIndex{};
@@ -64,6 +66,8 @@ public:
     // TODO: Clio does not implement "type" filter
     // outOfOrder only for clio, there is no document, traverse via seq diff
     // outOfOrder implementation is copied from old rpc handler
+    // bulk only for clio, pages are read directly from the full cache for the latest ledger; the type filter is applied
+    // before the limit and endMarker bounds the key range so that a client can export disjoint ranges in parallel
     struct Input {
         std::optional<std::string> ledgerHash;
         std::optional<uint32_t> ledgerIndex;
@@ -72,6 +76,8 @@ public:
         std::optional<ripple::uint256> marker;
         std::optional<uint32_t> diffMarker;
         bool outOfOrder = false;
+        bool bulk = false;
+        std::optional<ripple::uint256> endMarker;
         ripple::LedgerEntryType type = ripple::LedgerEntryType::ltANY;
     };
 
@@ -87,6 +93,8 @@ public:
         static auto const rpcSpec = RpcSpec{
             {JS(binary), validation::Type<bool>{}},
             {"out_of_order", validation::Type<bool>{}},
+            {"bulk", validation::Type<bool>{}},
+            {"end_marker", validation::Uint256HexStringValidator},
             {JS(ledger_hash), validation::Uint256HexStringValidator},
             {JS(ledger_index), validation::LedgerIndexValidator},
             {JS(limit), validation::Type<uint32_t>{}, validation::Min(1u)},
@@ -107,6 +115,9 @@ public:
     process(Input input, Context const& ctx) const;
 
 private:
+    Result
+    processBulk(Input const& input, ripple::LedgerHeader const& lgrInfo, Output output) const;
+
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
 
@@ -144,7 +144,7 @@ LedgerEntryHandler::process(LedgerEntryHandler::Input input, Context const& ctx)
     output.ledgerHash = ripple::strHex(lgrInfo.hash);
 
     if (input.binary) {
-        output.nodeBinary = ripple::strHex(*ledgerObject);
+        output.nodeBinary = toBinaryString(*ledgerObject, ctx.rawBinary);
     } else {
         output.node = toJson(sle);
     }
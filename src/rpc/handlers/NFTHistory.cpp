@@ -40,6 +40,7 @@
 
 #include <cstdint>
 #include <limits>
+#include <map>
 #include <optional>
 #include <string>
 #include <utility>
@@ -114,6 +115,18 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
     if (retCursor)
         response.marker = {retCursor->ledgerSequence, retCursor->transactionIndex};
 
+    // ledger headers are only needed for the expanded api v2 output; fetch each distinct ledger once
+    std::map<std::uint32_t, std::optional<ripple::LedgerHeader>> ledgerHeaders;
+    if (ctx.apiVersion > 1u and not input.binary)
+        ledgerHeaders = fetchLedgerHeadersFor(*sharedPtrBackend_, blobs, minIndex, maxIndex, ctx.yield);
+
+    auto const ledgerHeaderFor = [&](std::uint32_t seq) {
+        auto it = ledgerHeaders.find(seq);
+        if (it == ledgerHeaders.end())
+            it = ledgerHeaders.emplace(seq, sharedPtrBackend_->fetchLedgerBySequence(seq, ctx.yield)).first;
+        return it->second;
+    };
+
     for (auto const& txnPlusMeta : blobs) {
         // over the range
         if ((txnPlusMeta.ledgerSequence < minIndex && !input.forward) ||
@@ -141,15 +154,13 @@ NFTHistoryHandler::process(NFTHistoryHandler::Input input, Context const& ctx) c
                     obj[JS(hash)] = obj[txKey].at(JS(hash));
                     obj[txKey].as_object().erase(JS(hash));
                 }
-                if (auto const lgrInfo =
-                        sharedPtrBackend_->fetchLedgerBySequence(txnPlusMeta.ledgerSequence, ctx.yield);
-                    lgrInfo) {
+                if (auto const lgrInfo = ledgerHeaderFor(txnPlusMeta.ledgerSequence); lgrInfo) {
                     obj[JS(close_time_iso)] = ripple::to_string_iso(lgrInfo->closeTime);
                     obj[JS(ledger_hash)] = ripple::strHex(lgrInfo->hash);
                 }
             }
         } else {
-            obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion);
+            obj = toJsonWithBinaryTx(txnPlusMeta, ctx.apiVersion, ctx.rawBinary);
             obj[JS(ledger_index)] = txnPlusMeta.ledgerSequence;
             obj[JS(date)] = txnPlusMeta.date;
         }
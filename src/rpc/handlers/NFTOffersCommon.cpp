@@ -61,20 +61,19 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, SLE const& offer
 {
     auto amount = ::toBoostJson(offer.getFieldAmount(sfAmount).getJson(JsonOptions::none));
 
-    boost::json::object obj = {
+    jv = {
         {JS(nft_offer_index), to_string(offer.key())},
         {JS(flags), offer[sfFlags]},
         {JS(owner), toBase58(offer.getAccountID(sfOwner))},
         {JS(amount), std::move(amount)},
     };
+    auto& obj = jv.as_object();
 
     if (offer.isFieldPresent(sfDestination))
         obj.insert_or_assign(JS(destination), toBase58(offer.getAccountID(sfDestination)));
 
     if (offer.isFieldPresent(sfExpiration))
         obj.insert_or_assign(JS(expiration), offer.getFieldU32(sfExpiration));
-
-    jv = std::move(obj);
 }
 
 }  // namespace ripple
@@ -210,17 +210,16 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, NoRippleCheckHan
 {
     using boost::json::value_from;
 
-    auto obj = boost::json::object{
+    jv = {
         {JS(ledger_hash), output.ledgerHash},
         {JS(ledger_index), output.ledgerIndex},
-        {"problems", value_from(output.problems)},
+        {"problems", value_from(output.problems, jv.storage())},
         {JS(validated), output.validated},
     };
+    auto& obj = jv.as_object();
 
     if (output.transactions)
         obj.emplace(JS(transactions), *(output.transactions));
-
-    jv = std::move(obj);
 }
 
 }  // namespace rpc
@@ -21,12 +21,16 @@
 
 #include "data/BackendInterface.h"
 #include "data/Types.h"
+#include "feed/TransactionFilter.h"
 #include "rpc/Errors.h"
 #include "rpc/JS.h"
 #include "rpc/RPCHelpers.h"
 #include "rpc/common/MetaProcessors.h"
 #include "rpc/common/Types.h"
 #include "rpc/common/Validators.h"
+#include "util/JsonUtils.h"
+#include "util/TxUtil.h"
+#include "web/interface/ConnectionBase.h"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/array.hpp>
@@ -36,13 +40,21 @@
 #include <ripple/beast/utility/Zero.h>
 #include <ripple/protocol/Book.h>
 #include <ripple/protocol/ErrorCodes.h>
+#include <ripple/protocol/Issue.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
 #include <ripple/protocol/jss.h>
 
 #include <cstdint>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -82,6 +94,9 @@ public:
         std::optional<std::vector<std::string>> streams;
         std::optional<std::vector<std::string>> accountsProposed;
         std::optional<std::vector<OrderBook>> books;
+        std::optional<std::string> format;
+        std::optional<std::uint32_t> sinceLedger;
+        std::shared_ptr<feed::TransactionFilter const> filter;
     };
 
     using Result = HandlerReturnType<Output>;
@@ -130,11 +145,72 @@ public:
                 return MaybeError{};
             }};
 
+        static auto const filterValidator =
+            validation::CustomValidator{[](boost::json::value const& value, std::string_view key) -> MaybeError {
+                if (!value.is_object())
+                    return Error{Status{RippledError::rpcINVALID_PARAMS, std::string(key) + "NotObject"}};
+
+                auto const& filter = value.as_object();
+                if (filter.contains("transaction_types")) {
+                    if (!filter.at("transaction_types").is_array())
+                        return Error{Status{RippledError::rpcINVALID_PARAMS, "transactionTypesNotArray"}};
+
+                    for (auto const& type : filter.at("transaction_types").as_array()) {
+                        if (!type.is_string() ||
+                            !util::getTxTypesInLowercase().contains(util::toLower(type.as_string().c_str())))
+                            return Error{Status{RippledError::rpcINVALID_PARAMS, "transactionTypeMalformed"}};
+                    }
+                }
+
+                if (filter.contains("engine_results")) {
+                    if (!filter.at("engine_results").is_array())
+                        return Error{Status{RippledError::rpcINVALID_PARAMS, "engineResultsNotArray"}};
+
+                    for (auto const& result : filter.at("engine_results").as_array()) {
+                        if (!result.is_string() || !ripple::transCode(result.as_string().c_str()))
+                            return Error{Status{RippledError::rpcINVALID_PARAMS, "engineResultMalformed"}};
+                    }
+                }
+
+                ripple::Currency currency;
+                if (filter.contains(JS(currency))) {
+                    if (!filter.at(JS(currency)).is_string() ||
+                        !ripple::to_currency(currency, filter.at(JS(currency)).as_string().c_str()))
+                        return Error{Status{ClioError::rpcMALFORMED_CURRENCY}};
+                }
+
+                if (filter.contains(JS(issuer))) {
+                    if (auto err = meta::WithCustomError(
+                                       validation::AccountValidator,
+                                       Status{RippledError::rpcBAD_ISSUER, "Issuer account malformed."}
+                        )
+                                       .verify(filter, JS(issuer));
+                        !err)
+                        return err;
+
+                    if (filter.contains(JS(currency)) && ripple::isXRP(currency))
+                        return Error{Status{RippledError::rpcBAD_ISSUER, "Issuer set for XRP."}};
+                }
+
+                if (filter.contains("min_delivered_amount")) {
+                    if (!filter.contains(JS(currency)))
+                        return Error{Status{RippledError::rpcINVALID_PARAMS, "minDeliveredAmountWithoutCurrency"}};
+
+                    if (!filter.at("min_delivered_amount").is_string() || !parseMinDeliveredAmount(filter))
+                        return Error{Status{RippledError::rpcINVALID_PARAMS, "minDeliveredAmountMalformed"}};
+                }
+
+                return MaybeError{};
+            }};
+
         static auto const rpcSpec = RpcSpec{
             {JS(streams), validation::SubscribeStreamValidator},
             {JS(accounts), validation::SubscribeAccountsValidator},
             {JS(accounts_proposed), validation::SubscribeAccountsValidator},
             {JS(books), booksValidator},
+            {"format", validation::Type<std::string>{}, validation::OneOf{"json", "msgpack"}},
+            {"since_ledger", validation::Type<uint32_t>{}},
+            {"filter", filterValidator},
         };
 
         return rpcSpec;
@@ -145,20 +221,36 @@ public:
     {
         auto output = Output{};
 
+        // resuming only makes sense if nothing was missed, so fail before subscribing to anything
+        if (input.sinceLedger and not subscriptions_->canReplayTransactions(*input.sinceLedger))
+            return Error{Status{RippledError::rpcLGR_NOT_FOUND, "sinceLedgerNotBuffered"}};
+
+        // the response itself stays json, only the messages published afterwards use the requested format
+        if (input.format)
+            ctx.session->feedFormat = *input.format == "msgpack" ? web::FeedFormat::MsgPack : web::FeedFormat::Json;
+
         if (input.streams) {
-            auto const ledger = subscribeToStreams(ctx.yield, *(input.streams), ctx.session, ctx.apiVersion);
+            auto const ledger = subscribeToStreams(
+                ctx.yield, *(input.streams), ctx.session, ctx.apiVersion, input.sinceLedger, input.filter
+            );
             if (!ledger.empty())
                 output.ledger = ledger;
         }
 
         if (input.accounts)
-            subscribeToAccounts(*(input.accounts), ctx.session, ctx.apiVersion);
+            subscribeToAccounts(*(input.accounts), ctx.session, ctx.apiVersion, input.sinceLedger, input.filter);
 
         if (input.accountsProposed)
             subscribeToAccountsProposed(*(input.accountsProposed), ctx.session);
 
         if (input.books)
-            subscribeToBooks(*(input.books), ctx.session, ctx.yield, ctx.apiVersion, output);
+            subscribeToBooks(
+                *(input.books), ctx.session, ctx.yield, ctx.apiVersion, input.sinceLedger, input.filter, output
+            );
+
+        // replayed once for all subscriptions of the request, so a transaction matching several is sent once
+        if (input.sinceLedger)
+            subscriptions_->replayTransactions(ctx.session);
 
         return output;
     }
@@ -169,7 +261,9 @@ private:
         boost::asio::yield_context yield,
         std::vector<std::string> const& streams,
         std::shared_ptr<web::ConnectionBase> const& session,
-        std::uint32_t apiVersion
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger,
+        std::shared_ptr<feed::TransactionFilter const> const& filter
     ) const
     {
         auto response = boost::json::object{};
@@ -178,7 +272,7 @@ private:
             if (stream == "ledger") {
                 response = subscriptions_->subLedger(yield, session);
             } else if (stream == "transactions") {
-                subscriptions_->subTransactions(session, apiVersion);
+                subscriptions_->subTransactions(session, apiVersion, sinceLedger, filter);
             } else if (stream == "transactions_proposed") {
                 subscriptions_->subProposedTransactions(session);
             } else if (stream == "validations") {
@@ -197,12 +291,14 @@ private:
     subscribeToAccounts(
         std::vector<std::string> const& accounts,
         std::shared_ptr<web::ConnectionBase> const& session,
-        std::uint32_t apiVersion
+        std::uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger,
+        std::shared_ptr<feed::TransactionFilter const> const& filter
     ) const
     {
         for (auto const& account : accounts) {
             auto const accountID = accountFromStringStrict(account);
-            subscriptions_->subAccount(*accountID, session, apiVersion);
+            subscriptions_->subAccount(*accountID, session, apiVersion, sinceLedger, filter);
         }
     }
 
@@ -224,6 +320,8 @@ private:
         std::shared_ptr<web::ConnectionBase> const& session,
         boost::asio::yield_context yield,
         uint32_t apiVersion,
+        std::optional<std::uint32_t> sinceLedger,
+        std::shared_ptr<feed::TransactionFilter const> const& filter,
         Output& output
     ) const
     {
@@ -265,11 +363,67 @@ private:
                 }
             }
 
-            subscriptions_->subBook(internalBook.book, session, apiVersion);
+            subscriptions_->subBook(internalBook.book, session, apiVersion, sinceLedger, filter);
 
             if (internalBook.both)
-                subscriptions_->subBook(ripple::reversed(internalBook.book), session, apiVersion);
+                subscriptions_->subBook(ripple::reversed(internalBook.book), session, apiVersion, sinceLedger, filter);
+        }
+    }
+
+    static std::optional<ripple::STAmount>
+    parseMinDeliveredAmount(boost::json::object const& filter)
+    {
+        auto const currency = ripple::to_currency(filter.at(JS(currency)).as_string().c_str());
+        auto const issue = ripple::isXRP(currency)
+            ? ripple::xrpIssue()
+            : ripple::Issue{
+                  currency,
+                  filter.contains(JS(issuer)) ? *accountFromStringStrict(filter.at(JS(issuer)).as_string().c_str())
+                                              : ripple::noAccount()
+              };
+
+        try {
+            return ripple::amountFromString(issue, filter.at("min_delivered_amount").as_string().c_str());
+        } catch (std::exception const&) {
+            return std::nullopt;
+        }
+    }
+
+    static std::shared_ptr<feed::TransactionFilter const>
+    parseFilter(boost::json::object const& filter)
+    {
+        std::unordered_set<ripple::TxType> types;
+        if (filter.contains("transaction_types")) {
+            for (auto const& type : filter.at("transaction_types").as_array()) {
+                auto const typeInLowercase = util::toLower(type.as_string().c_str());
+                for (auto const& item : ripple::TxFormats::getInstance()) {
+                    if (util::toLower(item.getName()) == typeInLowercase)
+                        types.insert(item.getType());
+                }
+            }
+        }
+
+        std::unordered_set<ripple::TERUnderlyingType> results;
+        if (filter.contains("engine_results")) {
+            for (auto const& result : filter.at("engine_results").as_array())
+                results.insert(ripple::TERtoInt(*ripple::transCode(result.as_string().c_str())));
         }
+
+        std::optional<ripple::Currency> currency;
+        if (filter.contains(JS(currency)))
+            currency = ripple::to_currency(filter.at(JS(currency)).as_string().c_str());
+
+        std::optional<ripple::AccountID> issuer;
+        if (filter.contains(JS(issuer)))
+            issuer = accountFromStringStrict(filter.at(JS(issuer)).as_string().c_str());
+
+        std::optional<ripple::STAmount> minDeliveredAmount;
+        if (filter.contains("min_delivered_amount"))
+            minDeliveredAmount = parseMinDeliveredAmount(filter);
+
+        return std::make_shared<feed::TransactionFilter const>(
+            std::move(types), std::move(results), currency, issuer, std::move(minDeliveredAmount)
+        );
     }
 
     friend void
@@ -310,6 +464,15 @@ private:
                 input.accountsProposed->push_back(account.as_string().c_str());
         }
 
+        if (auto const& format = jsonObject.find("format"); format != jsonObject.end())
+            input.format = format->value().as_string().c_str();
+
+        if (auto const& sinceLedger = jsonObject.find("since_ledger"); sinceLedger != jsonObject.end())
+            input.sinceLedger = sinceLedger->value().as_int64();
+
+        if (auto const& filter = jsonObject.find("filter"); filter != jsonObject.end())
+            input.filter = parseFilter(filter->value().as_object());
+
         if (auto const& books = jsonObject.find(JS(books)); books != jsonObject.end()) {
             input.books = std::vector<OrderBook>();
             for (auto const& book : books->value().as_array()) {
@@ -152,8 +152,8 @@ public:
             output.tx = txn;
             output.meta = meta;
         } else {
-            output.txStr = ripple::strHex(dbResponse->transaction);
-            output.metaStr = ripple::strHex(dbResponse->metadata);
+            output.txStr = toBinaryString(dbResponse->transaction, ctx.rawBinary);
+            output.metaStr = toBinaryString(dbResponse->metadata, ctx.rawBinary);
 
             // input.transaction might be not available, get hash via tx object
             if (txn.contains(JS(hash)))
@@ -201,7 +201,7 @@ private:
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output)
     {
         auto const getJsonV1 = [&]() {
-            auto obj = boost::json::object{};
+            auto obj = boost::json::object(jv.storage());
 
             if (output.tx) {
                 obj = *output.tx;
@@ -220,7 +220,7 @@ private:
         };
 
         auto const getJsonV2 = [&]() {
-            auto obj = boost::json::object{};
+            auto obj = boost::json::object(jv.storage());
 
             if (output.tx) {
                 obj[JS(tx_json)] = *output.tx;
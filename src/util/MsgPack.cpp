@@ -0,0 +1,251 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MsgPack.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace util {
+
+namespace {
+
+constexpr std::uint8_t NIL = 0xc0;
+constexpr std::uint8_t FALSE = 0xc2;
+constexpr std::uint8_t TRUE = 0xc3;
+constexpr std::uint8_t BIN8 = 0xc4;
+constexpr std::uint8_t BIN16 = 0xc5;
+constexpr std::uint8_t BIN32 = 0xc6;
+constexpr std::uint8_t FLOAT64 = 0xcb;
+constexpr std::uint8_t UINT8 = 0xcc;
+constexpr std::uint8_t UINT16 = 0xcd;
+constexpr std::uint8_t UINT32 = 0xce;
+constexpr std::uint8_t UINT64 = 0xcf;
+constexpr std::uint8_t INT8 = 0xd0;
+constexpr std::uint8_t INT16 = 0xd1;
+constexpr std::uint8_t INT32 = 0xd2;
+constexpr std::uint8_t INT64 = 0xd3;
+constexpr std::uint8_t STR8 = 0xd9;
+constexpr std::uint8_t STR16 = 0xda;
+constexpr std::uint8_t STR32 = 0xdb;
+constexpr std::uint8_t ARRAY16 = 0xdc;
+constexpr std::uint8_t ARRAY32 = 0xdd;
+constexpr std::uint8_t MAP16 = 0xde;
+constexpr std::uint8_t MAP32 = 0xdf;
+
+constexpr std::uint8_t FIXMAP = 0x80;
+constexpr std::uint8_t FIXARRAY = 0x90;
+constexpr std::uint8_t FIXSTR = 0xa0;
+
+constexpr std::size_t FIXMAP_MAX = 15;
+constexpr std::size_t FIXARRAY_MAX = 15;
+constexpr std::size_t FIXSTR_MAX = 31;
+constexpr std::uint64_t POSITIVE_FIXINT_MAX = 127;
+constexpr std::int64_t NEGATIVE_FIXINT_MIN = -32;
+
+}  // namespace
+
+template <typename T>
+void
+MsgPackWriter::writeBigEndian(T const value)
+{
+    static_assert(std::is_unsigned_v<T>);
+
+    for (auto shift = static_cast<int>(sizeof(T) * 8) - 8; shift >= 0; shift -= 8)
+        buffer_.push_back(static_cast<char>((value >> shift) & 0xff));
+}
+
+void
+MsgPackWriter::writeNil()
+{
+    buffer_.push_back(static_cast<char>(NIL));
+}
+
+void
+MsgPackWriter::writeBool(bool const value)
+{
+    buffer_.push_back(static_cast<char>(value ? TRUE : FALSE));
+}
+
+void
+MsgPackWriter::writeUInt(std::uint64_t const value)
+{
+    if (value <= POSITIVE_FIXINT_MAX) {
+        buffer_.push_back(static_cast<char>(value));
+    } else if (value <= std::numeric_limits<std::uint8_t>::max()) {
+        buffer_.push_back(static_cast<char>(UINT8));
+        writeBigEndian(static_cast<std::uint8_t>(value));
+    } else if (value <= std::numeric_limits<std::uint16_t>::max()) {
+        buffer_.push_back(static_cast<char>(UINT16));
+        writeBigEndian(static_cast<std::uint16_t>(value));
+    } else if (value <= std::numeric_limits<std::uint32_t>::max()) {
+        buffer_.push_back(static_cast<char>(UINT32));
+        writeBigEndian(static_cast<std::uint32_t>(value));
+    } else {
+        buffer_.push_back(static_cast<char>(UINT64));
+        writeBigEndian(value);
+    }
+}
+
+void
+MsgPackWriter::writeInt(std::int64_t const value)
+{
+    if (value >= 0) {
+        writeUInt(static_cast<std::uint64_t>(value));
+    } else if (value >= NEGATIVE_FIXINT_MIN) {
+        buffer_.push_back(static_cast<char>(value));
+    } else if (value >= std::numeric_limits<std::int8_t>::min()) {
+        buffer_.push_back(static_cast<char>(INT8));
+        writeBigEndian(static_cast<std::uint8_t>(value));
+    } else if (value >= std::numeric_limits<std::int16_t>::min()) {
+        buffer_.push_back(static_cast<char>(INT16));
+        writeBigEndian(static_cast<std::uint16_t>(value));
+    } else if (value >= std::numeric_limits<std::int32_t>::min()) {
+        buffer_.push_back(static_cast<char>(INT32));
+        writeBigEndian(static_cast<std::uint32_t>(value));
+    } else {
+        buffer_.push_back(static_cast<char>(INT64));
+        writeBigEndian(static_cast<std::uint64_t>(value));
+    }
+}
+
+void
+MsgPackWriter::writeDouble(double const value)
+{
+    buffer_.push_back(static_cast<char>(FLOAT64));
+    writeBigEndian(std::bit_cast<std::uint64_t>(value));
+}
+
+void
+MsgPackWriter::writeString(std::string_view const value)
+{
+    auto const size = value.size();
+    if (size <= FIXSTR_MAX) {
+        buffer_.push_back(static_cast<char>(FIXSTR | size));
+    } else if (size <= std::numeric_limits<std::uint8_t>::max()) {
+        buffer_.push_back(static_cast<char>(STR8));
+        writeBigEndian(static_cast<std::uint8_t>(size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+        buffer_.push_back(static_cast<char>(STR16));
+        writeBigEndian(static_cast<std::uint16_t>(size));
+    } else {
+        buffer_.push_back(static_cast<char>(STR32));
+        writeBigEndian(static_cast<std::uint32_t>(size));
+    }
+    buffer_.append(value);
+}
+
+void
+MsgPackWriter::writeBinary(void const* data, std::size_t const size)
+{
+    if (size <= std::numeric_limits<std::uint8_t>::max()) {
+        buffer_.push_back(static_cast<char>(BIN8));
+        writeBigEndian(static_cast<std::uint8_t>(size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+        buffer_.push_back(static_cast<char>(BIN16));
+        writeBigEndian(static_cast<std::uint16_t>(size));
+    } else {
+        buffer_.push_back(static_cast<char>(BIN32));
+        writeBigEndian(static_cast<std::uint32_t>(size));
+    }
+    buffer_.append(static_cast<char const*>(data), size);
+}
+
+void
+MsgPackWriter::writeArrayHeader(std::size_t const size)
+{
+    if (size <= FIXARRAY_MAX) {
+        buffer_.push_back(static_cast<char>(FIXARRAY | size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+        buffer_.push_back(static_cast<char>(ARRAY16));
+        writeBigEndian(static_cast<std::uint16_t>(size));
+    } else {
+        buffer_.push_back(static_cast<char>(ARRAY32));
+        writeBigEndian(static_cast<std::uint32_t>(size));
+    }
+}
+
+void
+MsgPackWriter::writeMapHeader(std::size_t const size)
+{
+    if (size <= FIXMAP_MAX) {
+        buffer_.push_back(static_cast<char>(FIXMAP | size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+        buffer_.push_back(static_cast<char>(MAP16));
+        writeBigEndian(static_cast<std::uint16_t>(size));
+    } else {
+        buffer_.push_back(static_cast<char>(MAP32));
+        writeBigEndian(static_cast<std::uint32_t>(size));
+    }
+}
+
+void
+MsgPackWriter::writeJson(boost::json::value const& value)
+{
+    switch (value.kind()) {
+        case boost::json::kind::null:
+            writeNil();
+            break;
+        case boost::json::kind::bool_:
+            writeBool(value.get_bool());
+            break;
+        case boost::json::kind::int64:
+            writeInt(value.get_int64());
+            break;
+        case boost::json::kind::uint64:
+            writeUInt(value.get_uint64());
+            break;
+        case boost::json::kind::double_:
+            writeDouble(value.get_double());
+            break;
+        case boost::json::kind::string:
+            writeString(value.get_string());
+            break;
+        case boost::json::kind::array:
+            writeArrayHeader(value.get_array().size());
+            for (auto const& element : value.get_array())
+                writeJson(element);
+            break;
+        case boost::json::kind::object:
+            writeMapHeader(value.get_object().size());
+            for (auto const& [key, element] : value.get_object()) {
+                writeString(key);
+                writeJson(element);
+            }
+            break;
+    }
+}
+
+std::string
+toMsgPack(boost::json::value const& value)
+{
+    MsgPackWriter writer;
+    writer.writeJson(value);
+    return writer.release();
+}
+
+}  // namespace util
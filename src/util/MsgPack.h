@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/value.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace util {
+
+/**
+ * @brief Minimal MessagePack encoder writing into a string buffer.
+ *
+ * Only the subset needed to publish subscription messages is supported. Integers and lengths always use the smallest
+ * representation allowed by the specification: https://github.com/msgpack/msgpack/blob/master/spec.md
+ */
+class MsgPackWriter {
+    std::string buffer_;
+
+public:
+    /**
+     * @brief Write nil
+     */
+    void
+    writeNil();
+
+    /**
+     * @brief Write a boolean
+     *
+     * @param value The value to write
+     */
+    void
+    writeBool(bool value);
+
+    /**
+     * @brief Write an unsigned integer
+     *
+     * @param value The value to write
+     */
+    void
+    writeUInt(std::uint64_t value);
+
+    /**
+     * @brief Write a signed integer; non-negative values are written as unsigned integers
+     *
+     * @param value The value to write
+     */
+    void
+    writeInt(std::int64_t value);
+
+    /**
+     * @brief Write a 64 bit floating point number
+     *
+     * @param value The value to write
+     */
+    void
+    writeDouble(double value);
+
+    /**
+     * @brief Write an UTF-8 string
+     *
+     * @param value The value to write
+     */
+    void
+    writeString(std::string_view value);
+
+    /**
+     * @brief Write raw bytes as a binary object
+     *
+     * @param data Pointer to the bytes
+     * @param size Number of bytes
+     */
+    void
+    writeBinary(void const* data, std::size_t size);
+
+    /**
+     * @brief Write the header of an array; must be followed by the given number of values
+     *
+     * @param size Number of elements in the array
+     */
+    void
+    writeArrayHeader(std::size_t size);
+
+    /**
+     * @brief Write the header of a map; must be followed by the given number of key and value pairs
+     *
+     * @param size Number of key and value pairs in the map
+     */
+    void
+    writeMapHeader(std::size_t size);
+
+    /**
+     * @brief Write a json value, objects become maps with string keys
+     *
+     * @param value The value to write
+     */
+    void
+    writeJson(boost::json::value const& value);
+
+    /**
+     * @return The bytes written so far
+     */
+    std::string const&
+    data() const
+    {
+        return buffer_;
+    }
+
+    /**
+     * @brief Move the bytes written so far out of the writer
+     *
+     * @return The encoded bytes
+     */
+    std::string
+    release()
+    {
+        return std::move(buffer_);
+    }
+
+private:
+    template <typename T>
+    void
+    writeBigEndian(T value);
+};
+
+/**
+ * @brief Encode a json value as MessagePack.
+ *
+ * @param value The value to encode
+ * @return The encoded bytes
+ */
+std::string
+toMsgPack(boost::json::value const& value);
+
+}  // namespace util
@@ -45,6 +45,8 @@ struct Context : util::Taggable {
     data::LedgerRange range;
     std::string clientIp;
     bool isAdmin;
+    bool rawBinary = false;  // set when the response is sent as MessagePack, so blobs need no hex encoding
+    boost::json::storage_ptr storage = {};  // the arena of the request, handlers build their result in it
 
     /**
      * @brief Create a new Context instance.
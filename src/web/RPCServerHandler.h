@@ -31,25 +31,28 @@
 #include "util/Taggable.h"
 #include "util/config/Config.h"
 #include "util/log/Logger.h"
+#include "web/ResponseStream.h"
 #include "web/impl/ErrorHandling.h"
+#include "web/impl/RequestParser.h"
 #include "web/interface/ConnectionBase.h"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/json/array.hpp>
 #include <boost/json/object.hpp>
-#include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/system/system_error.hpp>
 #include <ripple/protocol/jss.h>
 
 #include <chrono>
+#include <cstddef>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <ratio>
 #include <stdexcept>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 namespace web {
@@ -66,6 +69,8 @@ class RPCServerHandler {
     std::shared_ptr<ETLType const> const etl_;
     util::TagDecoratorFactory const tagFactory_;
     rpc::detail::ProductionAPIVersionParser apiVersionParser_;  // can be injected if needed
+    std::unordered_set<std::string> const streamedMethods_;
+    std::size_t const streamChunkSize_;
 
     util::Logger log_{"RPC"};
     util::Logger perfLog_{"Performance"};
@@ -91,6 +96,10 @@ public:
         , etl_(etl)
         , tagFactory_(config)
         , apiVersionParser_(config.sectionOr("api_version", {}))
+        , streamedMethods_(getStreamedMethods(config))
+        , streamChunkSize_(
+              config.valueOr<std::size_t>("response_streaming.chunk_size_kb", DEFAULT_STREAM_CHUNK_SIZE_KB) * 1024
+          )
     {
     }
 
@@ -104,7 +113,8 @@ public:
     operator()(std::string const& request, std::shared_ptr<web::ConnectionBase> const& connection)
     {
         try {
-            auto req = boost::json::parse(request).as_object();
+            auto parsed = web::detail::parseRequest(request);
+            auto req = std::move(parsed.as_object());
             LOG(perfLog_.debug()) << connection->tag() << "Adding to work queue";
 
             if (not connection->upgraded and shouldReplaceParams(req))
@@ -137,6 +147,26 @@ public:
     }
 
 private:
+    static constexpr std::size_t DEFAULT_STREAM_CHUNK_SIZE_KB = 64;
+
+    static std::unordered_set<std::string>
+    getStreamedMethods(util::Config const& config)
+    {
+        std::unordered_set<std::string> methods;
+        for (auto const& method : config.arrayOr("response_streaming.methods", {}))
+            methods.insert(method.template value<std::string>());
+
+        return methods;
+    }
+
+    // Websocket clients ask for a MessagePack response per request, http clients may use the Accept header instead
+    static bool
+    requestsMsgPack(boost::json::object const& request)
+    {
+        return request.contains("response_format") and request.at("response_format").is_string() and
+            request.at("response_format").as_string() == "msgpack";
+    }
+
     void
     handleRequest(
         boost::asio::yield_context yield,
@@ -156,7 +186,7 @@ private:
                 return web::detail::ErrorHelper(connection, std::move(request)).sendNotReadyError();
             }
 
-            auto const context = [&] {
+            auto context = [&] {
                 if (connection->upgraded) {
                     return rpc::make_WsContext(
                         yield,
@@ -190,12 +220,19 @@ private:
                 return web::detail::ErrorHelper(connection, std::move(request)).sendError(err);
             }
 
+            // errors found before this point are sent as json; the response of the handler, error or not, is encoded
+            // as requested
+            auto const asMsgPack = connection->acceptsMsgPack or requestsMsgPack(request);
+            context->rawBinary = asMsgPack;
+            context->storage = request.storage();
+
             auto [result, timeDiff] = util::timed([&]() { return rpcEngine_->buildResponse(*context); });
 
             auto us = std::chrono::duration<int, std::milli>(timeDiff);
             rpc::logDuration(*context, us);
 
-            boost::json::object response;
+            // allocated from the arena of the request, released together with it
+            boost::json::object response{request.storage()};
             if (auto const status = std::get_if<rpc::Status>(&result)) {
                 // note: error statuses are counted/notified in buildResponse itself
                 response = web::detail::ErrorHelper(connection, request).composeError(*status);
@@ -218,10 +255,11 @@ private:
                 // if forwarded request has error, for http, error should be in "result"; for ws, error should
                 // be at top
                 if (isForwarded && (json.contains(JS(result)) || connection->upgraded)) {
-                    for (auto const& [k, v] : json)
-                        response.insert_or_assign(k, v);
+                    for (auto& [k, v] : json)
+                        response.insert_or_assign(k, std::move(v));
                 } else {
-                    response[JS(result)] = json;
+                    // built in the arena of the request by the handler, so this moves rather than copies
+                    response[JS(result)] = std::move(json);
                 }
 
                 if (isForwarded)
@@ -255,7 +293,16 @@ private:
                 warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_OUTDATED));
 
             response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+
+            if (asMsgPack) {
+                // forwarded responses carry their binary data hex encoded
+                auto const hexBinary = response.contains("forwarded");
+                connection->sendMsgPack(std::move(response), context->method, hexBinary);
+            } else if (streamedMethods_.contains(context->method)) {
+                connection->sendStream(std::make_shared<ResponseStream>(std::move(response), streamChunkSize_));
+            } else {
+                connection->send(boost::json::serialize(response));
+            }
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
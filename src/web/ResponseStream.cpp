@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/ResponseStream.h"
+
+#include "util/Assert.h"
+
+#include <boost/json/object.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace web {
+
+ResponseStream::ResponseStream(boost::json::object response, std::size_t chunkSize)
+    : response_(std::move(response)), buffer_(chunkSize, '\0')
+{
+    ASSERT(chunkSize > 0, "Chunk size must be greater than 0");
+}
+
+boost::json::object&
+ResponseStream::response()
+{
+    ASSERT(not started_, "Response can't be changed once serialization started");
+    return response_;
+}
+
+std::string_view
+ResponseStream::next()
+{
+    if (not started_) {
+        serializer_.reset(&response_);
+        started_ = true;
+    }
+
+    if (serializer_.done())
+        return {};
+
+    return serializer_.read(buffer_.data(), buffer_.size());
+}
+
+bool
+ResponseStream::done() const
+{
+    return started_ and serializer_.done();
+}
+
+std::string
+ResponseStream::drain()
+{
+    std::string result;
+    for (auto chunk = next(); not chunk.empty(); chunk = next())
+        result.append(chunk);
+
+    return result;
+}
+
+}  // namespace web
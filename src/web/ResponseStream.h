@@ -0,0 +1,89 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/object.hpp>
+#include <boost/json/serializer.hpp>
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace web {
+
+/**
+ * @brief A response that is serialized piece by piece while it is being sent.
+ *
+ * The connection pulls the next chunk only once the previous one was written to the socket, so at most one chunk of
+ * serialized text exists at any time and a slow client slows down serialization rather than growing a buffer.
+ */
+class ResponseStream {
+    boost::json::object response_;
+    boost::json::serializer serializer_;
+    std::string buffer_;
+    bool started_ = false;
+
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Construct a new Response Stream object
+     *
+     * @param response The response to serialize
+     * @param chunkSize The maximum size of a single chunk
+     */
+    explicit ResponseStream(boost::json::object response, std::size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    ResponseStream(ResponseStream const&) = delete;
+    ResponseStream&
+    operator=(ResponseStream const&) = delete;
+
+    /**
+     * @brief Access the response before serialization starts, e.g. to add a warning to it.
+     *
+     * @return The response
+     */
+    boost::json::object&
+    response();
+
+    /**
+     * @brief Serialize the next chunk.
+     *
+     * @return The chunk; it stays valid until the next call. Empty once the whole response was returned.
+     */
+    std::string_view
+    next();
+
+    /**
+     * @return true if the whole response was returned by @ref next(); false otherwise
+     */
+    [[nodiscard]] bool
+    done() const;
+
+    /**
+     * @brief Serialize whatever is left of the response at once.
+     *
+     * @return The remaining serialized text
+     */
+    std::string
+    drain();
+};
+
+}  // namespace web
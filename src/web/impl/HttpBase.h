@@ -25,27 +25,35 @@
 #include "util/log/Logger.h"
 #include "util/prometheus/Http.h"
 #include "web/DOSGuard.h"
+#include "web/ResponseStream.h"
 #include "web/impl/AdminVerificationStrategy.h"
+#include "web/impl/LoadWarning.h"
+#include "web/impl/MsgPackResponse.h"
 #include "web/interface/Concepts.h"
 #include "web/interface/ConnectionBase.h"
 
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ssl/error.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http.hpp>
+#include <boost/beast/http/chunk_encode.hpp>
+#include <boost/beast/http/empty_body.hpp>
 #include <boost/beast/http/error.hpp>
 #include <boost/beast/http/field.hpp>
 #include <boost/beast/http/message.hpp>
+#include <boost/beast/http/serializer.hpp>
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/http/verb.hpp>
+#include <boost/beast/http/write.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/json.hpp>
-#include <boost/json/array.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <ripple/protocol/ErrorCodes.h>
@@ -55,6 +63,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace web::detail {
@@ -206,6 +215,9 @@ public:
 
         // Update isAdmin property of the connection
         ConnectionBase::isAdmin_ = adminVerification_->isAdmin(req_, this->clientIp);
+        auto const accept = req_[http::field::accept];
+        acceptsMsgPack =
+            std::string_view{accept.data(), accept.size()}.find(MSGPACK_CONTENT_TYPE) != std::string_view::npos;
 
         if (boost::beast::websocket::is_upgrade(req_)) {
             if (dosGuard_.get().isOk(this->clientIp)) {
@@ -259,21 +271,67 @@ public:
     void
     send(std::string&& msg, http::status status = http::status::ok) override
     {
-        if (!dosGuard_.get().add(clientIp, msg.size())) {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+        if (!dosGuard_.get().add(clientIp, msg.size()))
+            addLoadWarning(msg);
 
-            // Reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
-        }
         sender_(httpResponse(status, "application/json", std::move(msg)));
     }
 
+    /**
+     * @brief Send a response encoded as MessagePack
+     * The encoded length will be added to the DOSGuard. Since the response can't be modified once encoded, the load
+     * warning is added when the client is already over its limit.
+     */
+    void
+    sendMsgPack(boost::json::object&& response, std::string_view method, bool hexBinary) override
+    {
+        if (!dosGuard_.get().isOk(clientIp))
+            addLoadWarning(response);
+
+        auto msg = toMsgPackResponse(response, method, hexBinary);
+        dosGuard_.get().add(clientIp, msg.size());
+
+        sender_(httpResponse(http::status::ok, std::string{MSGPACK_CONTENT_TYPE}, std::move(msg)));
+    }
+
+    /**
+     * @brief Send a response using chunked transfer encoding
+     * Each chunk is serialized only after the previous one was written. Since the size of the response is not known
+     * upfront, the load warning is added when the client is already over its limit and the chunks are added to the
+     * DOSGuard as they are written.
+     */
+    void
+    sendStream(std::shared_ptr<ResponseStream> stream) override
+    {
+        if (dead())
+            return;
+
+        if (!dosGuard_.get().isOk(clientIp))
+            addLoadWarning(stream->response());
+
+        auto header = std::make_shared<http::response<http::empty_body>>(http::status::ok, req_.version());
+        header->set(http::field::server, "clio-server-" + Build::getClioVersionString());
+        header->set(http::field::content_type, "application/json");
+        header->keep_alive(req_.keep_alive());
+        header->chunked(true);
+
+        auto serializer = std::make_shared<http::response_serializer<http::empty_body>>(*header);
+        res_ = header;
+
+        http::async_write_header(
+            derived().stream(),
+            *serializer,
+            [self = derived().shared_from_this(), header, serializer, stream = std::move(stream)](
+                boost::beast::error_code ec, std::size_t
+            ) mutable {
+                if (ec)
+                    return self->httpFail(ec, "write");
+
+                self->writeChunk(std::move(stream), header->need_eof());
+            }
+        );
+    }
+
     void
     onWrite(bool close, boost::beast::error_code ec, std::size_t bytes_transferred)
     {
@@ -292,6 +350,36 @@ public:
     }
 
 private:
+    void
+    writeChunk(std::shared_ptr<ResponseStream> stream, bool close)
+    {
+        auto const chunk = stream->next();
+        if (chunk.empty()) {
+            boost::asio::async_write(
+                derived().stream(),
+                http::make_chunk_last(),
+                boost::beast::bind_front_handler(&HttpBase::onWrite, derived().shared_from_this(), close)
+            );
+            return;
+        }
+
+        dosGuard_.get().add(clientIp, chunk.size());
+
+        // the chunk points into the stream's buffer which is kept alive by the handler
+        boost::asio::async_write(
+            derived().stream(),
+            http::make_chunk(boost::asio::buffer(chunk.data(), chunk.size())),
+            [self = derived().shared_from_this(), stream = std::move(stream), close](
+                boost::beast::error_code ec, std::size_t
+            ) mutable {
+                if (ec)
+                    return self->httpFail(ec, "write");
+
+                self->writeChunk(std::move(stream), close);
+            }
+        );
+    }
+
     http::response<http::string_body>
     httpResponse(http::status status, std::string content_type, std::string message) const
     {
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/LoadWarning.h"
+
+#include "rpc/Errors.h"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace web::detail {
+
+namespace {
+
+constexpr std::string_view WHITESPACE = " \t\n\r";
+constexpr std::string_view WARNING_KEY = R"("warning")";
+constexpr std::string_view WARNINGS_KEY = R"("warnings")";
+constexpr std::string_view WARNING_MEMBER = R"("warning":"load")";
+
+std::optional<std::size_t>
+findLastNotWhitespace(std::string_view text, std::size_t before)
+{
+    if (before == 0)
+        return std::nullopt;
+
+    auto const pos = text.find_last_not_of(WHITESPACE, before - 1);
+    if (pos == std::string_view::npos)
+        return std::nullopt;
+    return pos;
+}
+
+// Walking backwards, a quote outside of a string always closes one; it is opened by the previous unescaped quote
+std::optional<std::size_t>
+findStringStart(std::string_view text, std::size_t closingQuote)
+{
+    auto pos = closingQuote;
+    while (pos > 0) {
+        pos = text.rfind('"', pos - 1);
+        if (pos == std::string_view::npos)
+            return std::nullopt;
+
+        std::size_t backslashes = 0;
+        while (pos > backslashes and text[pos - backslashes - 1] == '\\')
+            ++backslashes;
+
+        if (backslashes % 2 == 0)
+            return pos;
+    }
+    return std::nullopt;
+}
+
+std::optional<std::size_t>
+findArrayStart(std::string_view text, std::size_t closingBracket)
+{
+    std::size_t depth = 0;
+    for (auto pos = closingBracket + 1; pos-- > 0;) {
+        switch (text[pos]) {
+            case '"': {
+                auto const start = findStringStart(text, pos);
+                if (not start)
+                    return std::nullopt;
+                pos = *start;
+                break;
+            }
+            case ']':
+            case '}':
+                ++depth;
+                break;
+            case '[':
+            case '{':
+                if (--depth == 0)
+                    return pos;
+                break;
+            default:
+                break;
+        }
+    }
+    return std::nullopt;
+}
+
+// Position of the opening quote of the "warnings" key if it is the last member of the object ending at objectEnd
+std::optional<std::size_t>
+findTrailingWarnings(std::string_view text, std::size_t objectEnd)
+{
+    auto const arrayEnd = findLastNotWhitespace(text, objectEnd);
+    if (not arrayEnd or text[*arrayEnd] != ']')
+        return std::nullopt;
+
+    auto const arrayStart = findArrayStart(text, *arrayEnd);
+    if (not arrayStart)
+        return std::nullopt;
+
+    auto const colon = findLastNotWhitespace(text, *arrayStart);
+    if (not colon or text[*colon] != ':')
+        return std::nullopt;
+
+    auto const keyEnd = findLastNotWhitespace(text, *colon);
+    if (not keyEnd or text[*keyEnd] != '"')
+        return std::nullopt;
+
+    auto const keyStart = findStringStart(text, *keyEnd);
+    if (not keyStart or text.substr(*keyStart, *keyEnd - *keyStart + 1) != WARNINGS_KEY)
+        return std::nullopt;
+
+    return keyStart;
+}
+
+bool
+spliceLoadWarning(std::string& response, std::string const& warning)
+{
+    std::string_view const text = response;
+
+    // an existing "warning" would have to be replaced, that needs the full parse
+    if (text.find(WARNING_KEY) != std::string_view::npos)
+        return false;
+
+    auto const objectEnd = text.find_last_not_of(WHITESPACE);
+    if (objectEnd == std::string_view::npos or text[objectEnd] != '}')
+        return false;
+
+    if (auto const warningsKey = findTrailingWarnings(text, objectEnd); warningsKey) {
+        auto const arrayEnd = *findLastNotWhitespace(text, objectEnd);
+        auto const arrayIsEmpty = text[*findLastNotWhitespace(text, arrayEnd)] == '[';
+
+        response.reserve(response.size() + warning.size() + WARNING_MEMBER.size() + 2);
+        response.insert(arrayEnd, arrayIsEmpty ? warning : "," + warning);
+        response.insert(*warningsKey, std::string{WARNING_MEMBER} + ",");
+        return true;
+    }
+
+    // without a trailing "warnings" there must be none at all, otherwise it would be duplicated
+    if (text.find(WARNINGS_KEY) != std::string_view::npos)
+        return false;
+
+    auto const lastChar = findLastNotWhitespace(text, objectEnd);
+    if (not lastChar)
+        return false;
+
+    auto const objectIsEmpty = text[*lastChar] == '{';
+    auto members = std::string{objectIsEmpty ? "" : ","};
+    members.append(WARNING_MEMBER).append(",").append(WARNINGS_KEY).append(":[").append(warning).append("]");
+    response.insert(objectEnd, members);
+    return true;
+}
+
+}  // namespace
+
+void
+addLoadWarning(std::string& response)
+{
+    static auto const warning = boost::json::serialize(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
+
+    if (spliceLoadWarning(response, warning))
+        return;
+
+    auto jsonResponse = boost::json::parse(response).as_object();
+    addLoadWarning(jsonResponse);
+    response = boost::json::serialize(jsonResponse);
+}
+
+void
+addLoadWarning(boost::json::object& response)
+{
+    response["warning"] = "load";
+    if (response.contains("warnings") && response["warnings"].is_array()) {
+        response["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
+    } else {
+        response["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
+    }
+}
+
+}  // namespace web::detail
@@ -0,0 +1,48 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/object.hpp>
+
+#include <string>
+
+namespace web::detail {
+
+/**
+ * @brief Add the rate limit warning to an already serialized response.
+ *
+ * Sets "warning" to "load" and appends the rate limit entry to "warnings". Responses produced by Clio end with their
+ * "warnings" array or have none at all, so in the common case the warning is spliced into the tail of the text. Any
+ * other shape falls back to parsing and serializing the response again.
+ *
+ * @param response The serialized json object to modify
+ */
+void
+addLoadWarning(std::string& response);
+
+/**
+ * @brief Add the rate limit warning to a response that is not serialized yet.
+ *
+ * @param response The json object to modify
+ */
+void
+addLoadWarning(boost::json::object& response);
+
+}  // namespace web::detail
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/MsgPackResponse.h"
+
+#include "util/MsgPack.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/string.hpp>
+#include <boost/json/value.hpp>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace web::detail {
+
+namespace {
+
+// A member holding hex encoded ledger data, as the member names leading to it from the response. Arrays on the way
+// are walked element by element.
+using BinaryPath = std::vector<std::string_view>;
+
+// The members each method fills with binary data when "binary" is requested. Only strings are converted, so the same
+// member holding json in a non binary response stays as it is; a forwarded one is only converted if it is valid hex.
+std::vector<BinaryPath> const&
+binaryPaths(std::string_view method)
+{
+    static std::unordered_map<std::string_view, std::vector<BinaryPath>> const PATHS = {
+        {"ledger_entry", {{"result", "node_binary"}}},
+        {"ledger_data", {{"result", "state", "data"}, {"result", "ledger", "ledger_data"}}},
+        {"ledger",
+         {{"result", "ledger", "ledger_data"},
+          {"result", "ledger", "transactions", "tx_blob"},
+          {"result", "ledger", "transactions", "meta"},
+          {"result", "ledger", "transactions", "meta_blob"},
+          {"result", "ledger", "diff", "object"}}},
+        {"tx", {{"result", "tx"}, {"result", "meta"}, {"result", "tx_blob"}, {"result", "meta_blob"}}},
+        {"account_tx",
+         {{"result", "transactions", "tx_blob"},
+          {"result", "transactions", "meta"},
+          {"result", "transactions", "meta_blob"}}},
+        {"nft_history",
+         {{"result", "transactions", "tx_blob"},
+          {"result", "transactions", "meta"},
+          {"result", "transactions", "meta_blob"}}},
+    };
+    static std::vector<BinaryPath> const NONE;
+
+    auto const it = PATHS.find(method);
+    return it == PATHS.end() ? NONE : it->second;
+}
+
+std::optional<unsigned char>
+hexDigit(char c)
+{
+    if (c >= '0' and c <= '9')
+        return static_cast<unsigned char>(c - '0');
+    if (c >= 'A' and c <= 'F')
+        return static_cast<unsigned char>(c - 'A' + 10);
+    if (c >= 'a' and c <= 'f')
+        return static_cast<unsigned char>(c - 'a' + 10);
+    return std::nullopt;
+}
+
+std::optional<std::string>
+unhex(std::string_view hex)
+{
+    if (hex.size() % 2 != 0)
+        return std::nullopt;
+
+    std::string bytes;
+    bytes.reserve(hex.size() / 2);
+    for (std::size_t i = 0; i < hex.size(); i += 2) {
+        auto const high = hexDigit(hex[i]);
+        auto const low = hexDigit(hex[i + 1]);
+        if (not high or not low)
+            return std::nullopt;
+
+        bytes.push_back(static_cast<char>((*high << 4) | *low));
+    }
+    return bytes;
+}
+
+void
+writeValue(
+    util::MsgPackWriter& writer,
+    boost::json::value const& value,
+    std::vector<BinaryPath const*> const& paths,
+    std::size_t depth,
+    bool hexBinary
+);
+
+void
+writeMember(
+    util::MsgPackWriter& writer,
+    std::string_view key,
+    boost::json::value const& value,
+    std::vector<BinaryPath const*> const& paths,
+    std::size_t depth,
+    bool hexBinary
+)
+{
+    writer.writeString(key);
+
+    std::vector<BinaryPath const*> matching;
+    bool isBinary = false;
+    for (auto const* path : paths) {
+        if ((*path)[depth] != key)
+            continue;
+
+        if (path->size() == depth + 1) {
+            isBinary = true;
+        } else {
+            matching.push_back(path);
+        }
+    }
+
+    if (isBinary and value.is_string()) {
+        auto const& str = value.get_string();
+        if (not hexBinary) {
+            writer.writeBinary(str.data(), str.size());
+            return;
+        }
+
+        if (auto const bytes = unhex(str); bytes) {
+            writer.writeBinary(bytes->data(), bytes->size());
+            return;
+        }
+    }
+
+    writeValue(writer, value, matching, depth + 1, hexBinary);
+}
+
+void
+writeValue(
+    util::MsgPackWriter& writer,
+    boost::json::value const& value,
+    std::vector<BinaryPath const*> const& paths,
+    std::size_t depth,
+    bool hexBinary
+)
+{
+    // nothing left to convert below this value
+    if (paths.empty()) {
+        writer.writeJson(value);
+        return;
+    }
+
+    if (value.is_array()) {
+        writer.writeArrayHeader(value.get_array().size());
+        for (auto const& element : value.get_array())
+            writeValue(writer, element, paths, depth, hexBinary);
+        return;
+    }
+
+    if (value.is_object()) {
+        writer.writeMapHeader(value.get_object().size());
+        for (auto const& [key, element] : value.get_object())
+            writeMember(writer, key, element, paths, depth, hexBinary);
+        return;
+    }
+
+    writer.writeJson(value);
+}
+
+}  // namespace
+
+std::string
+toMsgPackResponse(boost::json::object const& response, std::string_view method, bool hexBinary)
+{
+    std::vector<BinaryPath const*> paths;
+    for (auto const& path : binaryPaths(method))
+        paths.push_back(&path);
+
+    util::MsgPackWriter writer;
+    writer.writeMapHeader(response.size());
+    for (auto const& [key, value] : response)
+        writeMember(writer, key, value, paths, 0, hexBinary);
+
+    return writer.release();
+}
+
+}  // namespace web::detail
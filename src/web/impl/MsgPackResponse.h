@@ -0,0 +1,51 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/object.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace web::detail {
+
+/**
+ * @brief The content type of MessagePack encoded responses, clients ask for it in the Accept header.
+ */
+static constexpr std::string_view MSGPACK_CONTENT_TYPE = "application/msgpack";
+
+/**
+ * @brief Encode a response as MessagePack for clients that negotiated the binary response format.
+ *
+ * Ledger objects, transactions and metadata requested with "binary": true become MessagePack binary objects carrying
+ * the raw bytes, halving their size and sparing the client the hex decoding. Handlers put the raw bytes in these
+ * members already when the response is sent as MessagePack; only forwarded responses carry them hex encoded and are
+ * decoded here. Only the members the method is known to fill with binary data are converted, everything else is
+ * encoded like @ref util::toMsgPack does.
+ *
+ * @param response The response to encode
+ * @param method The method the response is for
+ * @param hexBinary Whether the binary members are hex encoded; they hold the raw bytes otherwise
+ * @return The encoded bytes
+ */
+std::string
+toMsgPackResponse(boost::json::object const& response, std::string_view method, bool hexBinary);
+
+}  // namespace web::detail
@@ -0,0 +1,55 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/RequestParser.h"
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parser.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/value.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+namespace web::detail {
+
+namespace {
+
+constexpr std::size_t MIN_ARENA_SIZE = 4096;
+constexpr std::size_t ARENA_SIZE_PER_REQUEST_BYTE = 4;  // the DOM takes a few times the size of the text
+
+}  // namespace
+
+boost::json::value
+parseRequest(std::string_view request)
+{
+    thread_local boost::json::parser parser;
+
+    parser.reset(boost::json::make_shared_resource<boost::json::monotonic_resource>(
+        std::max(MIN_ARENA_SIZE, request.size() * ARENA_SIZE_PER_REQUEST_BYTE)
+    ));
+    parser.write(request);
+
+    auto value = parser.release();
+    parser.reset();  // drop the parser's reference to the arena, it belongs to the request now
+    return value;
+}
+
+}  // namespace web::detail
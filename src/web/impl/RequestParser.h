@@ -0,0 +1,43 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json/value.hpp>
+
+#include <string_view>
+
+namespace web::detail {
+
+/**
+ * @brief Parse an incoming request into an arena of its own.
+ *
+ * The DOM is allocated from a monotonic resource sized after the request text instead of from the global heap one
+ * node at a time. The resource is owned by the storage of the returned value, so the request and everything else
+ * built with the same storage is released in one go when the last of them is destroyed. Values built with another
+ * storage are copied when assigned, as usual. The parser is reused per thread to keep its temporary buffers.
+ *
+ * @param request The request text
+ * @return The parsed request
+ * @throws boost::system::system_error if the text is not valid json
+ */
+boost::json::value
+parseRequest(std::string_view request);
+
+}  // namespace web::detail
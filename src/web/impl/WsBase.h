@@ -24,6 +24,9 @@
 #include "util/Taggable.h"
 #include "util/log/Logger.h"
 #include "web/DOSGuard.h"
+#include "web/ResponseStream.h"
+#include "web/impl/LoadWarning.h"
+#include "web/impl/MsgPackResponse.h"
 #include "web/interface/Concepts.h"
 #include "web/interface/ConnectionBase.h"
 
@@ -41,7 +44,7 @@
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/core/ignore_unused.hpp>
-#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <ripple/protocol/ErrorCodes.h>
@@ -52,6 +55,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace web::detail {
@@ -72,7 +76,13 @@ class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<web::DOSGuard> dosGuard_;
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+
+    struct OutgoingMessage {
+        std::shared_ptr<std::string> payload;
+        bool binary = false;
+        std::shared_ptr<ResponseStream> stream;  // written as fragments of one message if set
+    };
+    std::queue<OutgoingMessage> messages_;
     std::shared_ptr<HandlerType> const handler_;
 
 protected:
@@ -119,8 +129,24 @@ public:
     doWrite()
     {
         sending_ = true;
+        auto const& [payload, binary, stream] = messages_.front();
+        derived().ws().binary(binary);
+
+        if (stream) {
+            auto const chunk = stream->next();
+            dosGuard_.get().add(clientIp, chunk.size());
+
+            // the chunk points into the stream's buffer which is kept alive in the queue until the last fragment
+            derived().ws().async_write_some(
+                stream->done(),
+                boost::asio::buffer(chunk.data(), chunk.size()),
+                boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
+            );
+            return;
+        }
+
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(payload->data(), payload->size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
@@ -128,6 +154,12 @@ public:
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
+        // a streamed message stays at the front until its last fragment was written
+        if (auto const& stream = messages_.front().stream; not ec and stream and not stream->done()) {
+            doWrite();
+            return;
+        }
+
         messages_.pop();
         sending_ = false;
         if (ec) {
@@ -158,7 +190,61 @@ public:
         boost::asio::dispatch(
             derived().ws().get_executor(),
             [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                messages_.push(msg);
+                messages_.push({msg, false, nullptr});
+                maybeSendNext();
+            }
+        );
+    }
+
+    /**
+     * @brief Send a message to the client as a binary frame
+     * @param msg The message to send, it will keep the string alive until it is sent.
+     * Be aware that the message length will not be added to the DOSGuard from this function.
+     */
+    void
+    sendBinary(std::shared_ptr<std::string> msg) override
+    {
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
+                messages_.push({msg, true, nullptr});
+                maybeSendNext();
+            }
+        );
+    }
+
+    /**
+     * @brief Send a response to the client as a binary MessagePack message
+     * The encoded length will be added to the DOSGuard. If the client is already over its limit, the response will be
+     * modified to include a warning
+     */
+    void
+    sendMsgPack(boost::json::object&& response, std::string_view method, bool hexBinary) override
+    {
+        if (!dosGuard_.get().isOk(clientIp))
+            addLoadWarning(response);
+
+        auto msg = std::make_shared<std::string>(toMsgPackResponse(response, method, hexBinary));
+        dosGuard_.get().add(clientIp, msg->size());
+        sendBinary(std::move(msg));
+    }
+
+    /**
+     * @brief Send a response to the client as a fragmented message
+     * @param stream The response, it is serialized one fragment at a time as the previous fragment gets written.
+     * The fragments are added to the DOSGuard as they are written. If the client is already over its limit, the
+     * response will be modified to include a warning
+     */
+    void
+    sendStream(std::shared_ptr<ResponseStream> stream) override
+    {
+        if (!dosGuard_.get().isOk(clientIp))
+            addLoadWarning(stream->response());
+
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), stream = std::move(stream)]() {
+                messages_.push({nullptr, false, stream});
                 maybeSendNext();
             }
         );
@@ -173,19 +259,9 @@ public:
     void
     send(std::string&& msg, http::status) override
     {
-        if (!dosGuard_.get().add(clientIp, msg.size())) {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+        if (!dosGuard_.get().add(clientIp, msg.size()))
+            addLoadWarning(msg);
 
-            // Reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
-        }
         auto sharedMsg = std::make_shared<std::string>(std::move(msg));
         send(std::move(sharedMsg));
     }
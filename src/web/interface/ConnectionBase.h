@@ -20,16 +20,30 @@
 #pragma once
 
 #include "util/Taggable.h"
+#include "web/ResponseStream.h"
 
 #include <boost/beast/http.hpp>
+#include <boost/json/object.hpp>
 #include <boost/signals2.hpp>
 
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace web {
 
 namespace http = boost::beast::http;
 
+/**
+ * @brief The wire format a connection receives subscription messages in.
+ */
+enum class FeedFormat {
+    Json,    ///< Text messages, the default
+    MsgPack  ///< Binary MessagePack messages
+};
+
 /**
  * @brief Base class for all connections.
  *
@@ -45,6 +59,8 @@ public:
     bool isAdmin_ = false;
     boost::signals2::signal<void(ConnectionBase*)> onDisconnect;
     std::uint32_t apiSubVersion = 0;
+    FeedFormat feedFormat = FeedFormat::Json;
+    bool acceptsMsgPack = false;  // set by http sessions from the Accept header of the current request
 
     /**
      * @brief Create a new connection base.
@@ -83,6 +99,45 @@ public:
         throw std::logic_error("web server can not send the shared payload");
     }
 
+    /**
+     * @brief Send a response that is serialized while it is being written.
+     *
+     * Connections that can't write a response in parts serialize it at once and send it as a whole.
+     *
+     * @param stream The response to send
+     */
+    virtual void
+    sendStream(std::shared_ptr<ResponseStream> stream)
+    {
+        send(stream->drain());
+    }
+
+    /**
+     * @brief Send a response encoded as MessagePack, for clients that negotiated the binary response format.
+     *
+     * @param response The response to send
+     * @param method The method the response is for, it tells which members hold binary data
+     * @param hexBinary Whether the binary data is hex encoded, as in forwarded responses, instead of raw bytes
+     * @throws Not supported unless implemented in child classes. Will always throw std::logic_error.
+     */
+    virtual void
+    sendMsgPack(boost::json::object&& /* response */, std::string_view /* method */, bool /* hexBinary */)
+    {
+        throw std::logic_error("web server can not send a MessagePack response");
+    }
+
+    /**
+     * @brief Send a binary message via shared_ptr of string, used to publish MessagePack encoded feeds.
+     *
+     * @param msg The binary message to send
+     * @throws Not supported unless implemented in child classes. Will always throw std::logic_error.
+     */
+    virtual void
+    sendBinary(std::shared_ptr<std::string> /* msg */)
+    {
+        throw std::logic_error("web server can not send the binary payload");
+    }
+
     /**
      * @brief Indicates whether the connection had an error and is considered dead.
      *
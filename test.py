@@ -823,6 +823,39 @@ async def ledger_diff(ip, port, base, desired, includeBlobs):
         print(e)
     
 
+def forwardCacheCounters(ip, port):
+    import urllib.request
+    counters = {}
+    with urllib.request.urlopen('http://' + str(ip) + ':' + str(port) + '/metrics') as res:
+        for line in res.read().decode().splitlines():
+            if line.startswith("forward_cache_counter_total_number"):
+                result = line.split('result="')[1].split('"')[0]
+                counters[result] = counters.get(result, 0) + float(line.split()[-1])
+    return counters
+
+async def forward_load(ip, port, request, numCalls, numRunners):
+    address = 'ws://' + str(ip) + ':' + str(port)
+    before = forwardCacheCounters(ip, port)
+
+    async def runner(calls):
+        async with websockets.connect(address) as ws:
+            for x in range(0, calls):
+                await ws.send(request)
+                json.loads(await ws.recv())
+
+    start = datetime.datetime.now().timestamp()
+    await asyncio.gather(*[runner(numCalls // numRunners) for x in range(0, numRunners)])
+    seconds = datetime.datetime.now().timestamp() - start
+
+    after = forwardCacheCounters(ip, port)
+    delta = {k: after.get(k, 0) - before.get(k, 0) for k in after}
+    toRippled = delta.get("miss", 0) + delta.get("bypass", 0)
+    total = toRippled + delta.get("hit", 0) + delta.get("coalesced", 0)
+    print("Forwarded requests = " + str(total) + " in " + str(seconds) + " seconds")
+    print("Sent to rippled = " + str(toRippled) + " (" + str(toRippled / seconds) + " per second)")
+    if total > 0:
+        print("Rippled QPS reduction = " + str(100 * (1 - toRippled / total)) + "%")
+
 async def perf(ip, port):
     res = await ledger_range(ip,port)
     time.sleep(10)
@@ -982,7 +1015,7 @@ async def verifySubscribe(ip,clioPort,ripdPort):
     
 
 parser = argparse.ArgumentParser(description='test script for xrpl-reporting')
-parser.add_argument('action', choices=["account_info", "tx", "txs","account_tx", "account_tx_full","ledger_data", "ledger_data_full", "book_offers","ledger","ledger_range","ledger_entry", "ledgers", "ledger_entries","account_txs","account_infos","account_txs_full","book_changes","book_offerses","ledger_diff","perf","fee","server_info", "gaps","subscribe","verify_subscribe","call"])
+parser.add_argument('action', choices=["account_info", "tx", "txs","account_tx", "account_tx_full","ledger_data", "ledger_data_full", "book_offers","ledger","ledger_range","ledger_entry", "ledgers", "ledger_entries","account_txs","account_infos","account_txs_full","book_changes","book_offerses","ledger_diff","perf","fee","server_info","forward_load", "gaps","subscribe","verify_subscribe","call"])
 
 parser.add_argument('--ip', default='127.0.0.1')
 parser.add_argument('--port', default='8080')
@@ -1034,6 +1067,11 @@ def run(args):
     elif args.action == "server_info":
         asyncio.get_event_loop().run_until_complete(server_info(args.ip, args.port))
         return
+    elif args.action == "forward_load":
+        request = args.request if args.request is not None else json.dumps({"command":"fee"})
+        asyncio.get_event_loop().run_until_complete(
+                forward_load(args.ip, args.port, request, int(args.numCalls), int(args.numRunners)))
+        return
 
     rng =asyncio.get_event_loop().run_until_complete(ledger_range(args.ip, args.port))
     if args.ledger is None:
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.h"
+#include "data/Types.h"
+#include "util/MockPrometheus.h"
+
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr std::uint32_t SEQ = 30;
+
+ripple::uint256
+keyOf(std::uint64_t n)
+{
+    return ripple::uint256{n};
+}
+
+}  // namespace
+
+struct LedgerCacheTest : util::prometheus::WithPrometheus {
+    LedgerCache cache;
+
+    LedgerCacheTest()
+    {
+        // objects at keys 10, 20, ..., 1000
+        std::vector<LedgerObject> objects;
+        for (std::uint64_t i = 1; i <= 100; ++i)
+            objects.push_back({keyOf(i * 10), Blob{1}});
+
+        cache.update(objects, SEQ);
+        cache.setFull();
+    }
+};
+
+TEST_F(LedgerCacheTest, NeighborsMatchPredecessorAndSuccessor)
+{
+    std::vector<ripple::uint256> keys;
+    for (std::uint64_t i = 0; i <= 1010; i += 5)
+        keys.push_back(keyOf(i));
+    keys.push_back(keyOf(5000));
+
+    auto const neighbors = cache.getNeighbors(keys, SEQ);
+    ASSERT_TRUE(neighbors.has_value());
+    ASSERT_EQ(neighbors->size(), keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        auto const predecessor = cache.getPredecessor(keys[i], SEQ);
+        auto const successor = cache.getSuccessor(keys[i], SEQ);
+
+        ASSERT_EQ((*neighbors)[i].predecessor.has_value(), predecessor.has_value()) << i;
+        if (predecessor)
+            EXPECT_EQ(*(*neighbors)[i].predecessor, predecessor->key) << i;
+
+        ASSERT_EQ((*neighbors)[i].successor.has_value(), successor.has_value()) << i;
+        if (successor)
+            EXPECT_EQ(*(*neighbors)[i].successor, successor->key) << i;
+    }
+}
+
+TEST_F(LedgerCacheTest, NeighborsOfFarApartKeys)
+{
+    auto const neighbors = cache.getNeighbors({keyOf(15), keyOf(990), keyOf(995)}, SEQ);
+    ASSERT_TRUE(neighbors.has_value());
+    ASSERT_EQ(neighbors->size(), 3);
+
+    EXPECT_EQ((*neighbors)[0].predecessor, keyOf(10));
+    EXPECT_EQ((*neighbors)[0].successor, keyOf(20));
+    EXPECT_EQ((*neighbors)[1].predecessor, keyOf(980));
+    EXPECT_EQ((*neighbors)[1].successor, keyOf(1000));
+    EXPECT_EQ((*neighbors)[2].predecessor, keyOf(990));
+    EXPECT_EQ((*neighbors)[2].successor, keyOf(1000));
+}
+
+TEST_F(LedgerCacheTest, NoNeighborsForOtherSequence)
+{
+    EXPECT_FALSE(cache.getNeighbors({keyOf(15)}, SEQ - 1).has_value());
+}
+
+TEST_F(LedgerCacheTest, NoNeighborsIfNotFull)
+{
+    LedgerCache notFull;
+    notFull.update({{keyOf(10), Blob{1}}}, SEQ);
+
+    EXPECT_FALSE(notFull.getNeighbors({keyOf(15)}, SEQ).has_value());
+}
+
+TEST_F(LedgerCacheTest, PageStopsBeforeEnd)
+{
+    auto const page = cache.getPage(keyOf(100), keyOf(150), SEQ, 100, [](Blob const&) { return true; });
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 4);
+    EXPECT_EQ(page->objects.front().key, keyOf(110));
+    EXPECT_EQ(page->objects.back().key, keyOf(140));
+    EXPECT_FALSE(page->cursor.has_value());
+}
+
+TEST_F(LedgerCacheTest, PageIsEmptyIfEndIsNotAfterCursor)
+{
+    auto const all = [](Blob const&) { return true; };
+    for (auto const& [cursor, end] : std::vector<std::pair<std::uint64_t, std::uint64_t>>{
+             {500, 500}, {500, 200}, {995, 10}, {1000, 10}
+         }) {
+        auto const page = cache.getPage(keyOf(cursor), keyOf(end), SEQ, 100, all);
+        ASSERT_TRUE(page.has_value());
+        EXPECT_TRUE(page->objects.empty()) << cursor << " " << end;
+        EXPECT_FALSE(page->cursor.has_value()) << cursor << " " << end;
+    }
+}
+
+TEST_F(LedgerCacheTest, PageContinuesAcrossScanSlices)
+{
+    auto const numObjects = LedgerCache::PAGE_SCAN_SLICE * 2 + 1;
+
+    LedgerCache large;
+    std::vector<LedgerObject> objects;
+    for (std::uint64_t i = 1; i <= numObjects; ++i)
+        objects.push_back({keyOf(i), Blob{i == numObjects ? std::uint8_t{2} : std::uint8_t{1}}});
+    large.update(objects, SEQ);
+    large.setFull();
+
+    auto const page = large.getPage(std::nullopt, std::nullopt, SEQ, 100, [](Blob const& blob) {
+        return blob.front() == 2;
+    });
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 1);
+    EXPECT_EQ(page->objects.front().key, keyOf(numObjects));
+    EXPECT_FALSE(page->cursor.has_value());
+}
@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.h"
+#include "util/MockPrometheus.h"
+#include "util/TestObject.h"
+
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+
+using namespace data;
+
+namespace {
+
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto LEDGERHASH2 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+}  // namespace
+
+struct LedgerHeaderCacheTest : util::prometheus::WithPrometheus {};
+
+TEST_F(LedgerHeaderCacheTest, EmptyByDefault)
+{
+    LedgerHeaderCache const cache;
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.getBySequence(10));
+    EXPECT_FALSE(cache.getByHash(ripple::uint256{LEDGERHASH}));
+}
+
+TEST_F(LedgerHeaderCacheTest, LookupBySequenceAndHash)
+{
+    LedgerHeaderCache cache;
+    cache.put(CreateLedgerInfo(LEDGERHASH, 10));
+
+    auto const bySeq = cache.getBySequence(10);
+    ASSERT_TRUE(bySeq);
+    EXPECT_EQ(bySeq->hash, ripple::uint256{LEDGERHASH});
+
+    auto const byHash = cache.getByHash(ripple::uint256{LEDGERHASH});
+    ASSERT_TRUE(byHash);
+    EXPECT_EQ(byHash->seq, 10);
+
+    EXPECT_FALSE(cache.getBySequence(11));
+    EXPECT_FALSE(cache.getByHash(ripple::uint256{LEDGERHASH2}));
+}
+
+TEST_F(LedgerHeaderCacheTest, EvictsOldestLedger)
+{
+    LedgerHeaderCache cache{2};
+    cache.put(CreateLedgerInfo(LEDGERHASH, 10));
+    cache.put(CreateLedgerInfo(LEDGERHASH2, 12));
+    cache.put(CreateLedgerInfo(LEDGERHASH, 11));
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_FALSE(cache.getBySequence(10));
+    EXPECT_TRUE(cache.getBySequence(11));
+    EXPECT_TRUE(cache.getBySequence(12));
+
+    auto const byHash = cache.getByHash(ripple::uint256{LEDGERHASH});
+    ASSERT_TRUE(byHash);
+    EXPECT_EQ(byHash->seq, 11);
+}
+
+TEST_F(LedgerHeaderCacheTest, DisabledWhenSizeIsZero)
+{
+    LedgerHeaderCache cache{0};
+    cache.put(CreateLedgerInfo(LEDGERHASH, 10));
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.getBySequence(10));
+}
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/TransactionsBundle.h"
+#include "data/Types.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr std::uint32_t SEQ = 30;
+constexpr std::uint32_t DATE = 1234;
+
+std::vector<TransactionAndMetadata>
+makeTransactions(std::size_t count, std::size_t blobSize)
+{
+    std::vector<TransactionAndMetadata> transactions;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto const byte = static_cast<unsigned char>(i);
+        transactions.emplace_back(Blob(blobSize, byte), Blob(blobSize / 2, byte + 1), SEQ, DATE);
+    }
+    return transactions;
+}
+
+}  // namespace
+
+TEST(TransactionsBundleTest, EmptyLedgerHasOneEmptyChunk)
+{
+    auto const chunks = makeTransactionsBundle({});
+    ASSERT_EQ(chunks.size(), 1);
+    EXPECT_TRUE(chunks.front().empty());
+
+    auto const transactions = readTransactionsBundle(chunks, SEQ, DATE);
+    ASSERT_TRUE(transactions);
+    EXPECT_TRUE(transactions->empty());
+}
+
+TEST(TransactionsBundleTest, RoundTripKeepsOrder)
+{
+    auto const transactions = makeTransactions(10, 100);
+    auto const chunks = makeTransactionsBundle(transactions);
+    EXPECT_EQ(chunks.size(), 1);
+
+    EXPECT_EQ(readTransactionsBundle(chunks, SEQ, DATE), transactions);
+}
+
+TEST(TransactionsBundleTest, SplitsIntoChunksOfWholeTransactions)
+{
+    auto const transactions = makeTransactions(10, 100);
+    auto const chunks = makeTransactionsBundle(transactions, 300);
+    EXPECT_EQ(chunks.size(), 5);
+
+    EXPECT_EQ(readTransactionsBundle(chunks, SEQ, DATE), transactions);
+}
+
+TEST(TransactionsBundleTest, LargeTransactionGetsOwnChunk)
+{
+    auto const transactions = makeTransactions(2, 1000);
+    EXPECT_EQ(makeTransactionsBundle(transactions, 100).size(), 2);
+}
+
+TEST(TransactionsBundleTest, TruncatedBundleIsRejected)
+{
+    auto chunks = makeTransactionsBundle(makeTransactions(3, 100));
+    chunks.front().pop_back();
+    EXPECT_FALSE(readTransactionsBundle(chunks, SEQ, DATE));
+
+    chunks.front().resize(2);
+    EXPECT_FALSE(readTransactionsBundle(chunks, SEQ, DATE));
+}
@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.h"
+#include "data/TrustLineAggregatesCache.h"
+#include "data/Types.h"
+#include "util/MockPrometheus.h"
+#include "util/TestObject.h"
+
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/STObject.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto ACCOUNT3 = "raHGBERMka3KZsfpTQUAtumxmvpqhFLyrk";
+constexpr auto LINE_KEY = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr auto OFFER_KEY = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+constexpr auto TXNID = "E3FE6EA3D48F0C2B639448020EA4F03D4F4F8FFDB243A852A0F59177921B4879";
+constexpr std::uint32_t SEQ = 30;
+
+Blob
+toBlob(ripple::STObject const& obj)
+{
+    return obj.getSerializer().peekData();
+}
+
+LedgerObject
+trustLine()
+{
+    auto const line = CreateRippleStateLedgerObject("USD", ACCOUNT, 10, ACCOUNT, 100, ACCOUNT2, 200, TXNID, 1);
+    return {ripple::uint256{LINE_KEY}, toBlob(line)};
+}
+
+LedgerObject
+offer()
+{
+    auto const offer = CreateOfferLedgerObject(
+        ACCOUNT3,
+        10,
+        20,
+        ripple::to_string(ripple::to_currency("USD")),
+        ripple::to_string(ripple::xrpCurrency()),
+        ACCOUNT2,
+        toBase58(ripple::xrpAccount()),
+        OFFER_KEY
+    );
+    return {ripple::uint256{OFFER_KEY}, toBlob(offer)};
+}
+
+}  // namespace
+
+struct TrustLineAggregatesCacheTest : util::prometheus::WithPrometheus {
+    LedgerCache ledgerCache;
+    TrustLineAggregatesCache aggregatesCache;
+    std::shared_ptr<TrustLineAggregates const> aggregates = std::make_shared<TrustLineAggregates>();
+
+    ripple::AccountID const account = GetAccountIDWithString(ACCOUNT);
+    ripple::AccountID const account2 = GetAccountIDWithString(ACCOUNT2);
+    ripple::AccountID const account3 = GetAccountIDWithString(ACCOUNT3);
+
+    // applies a ledger diff the way ETL does
+    void
+    update(std::vector<LedgerObject> const& diff, std::uint32_t seq)
+    {
+        aggregatesCache.update(diff, seq, ledgerCache);
+        ledgerCache.update(diff, seq);
+    }
+};
+
+TEST_F(TrustLineAggregatesCacheTest, NothingIsMemoizedBeforeFirstLedger)
+{
+    aggregatesCache.put(account, 0, aggregates);
+    EXPECT_EQ(aggregatesCache.size(), 0);
+    EXPECT_EQ(aggregatesCache.get(account, 0), nullptr);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, ValidFromComputedLedgerToLatest)
+{
+    update({trustLine()}, SEQ);
+    aggregatesCache.put(account3, SEQ, aggregates);
+
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ), aggregates);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ - 1), nullptr);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ + 1), nullptr);
+
+    update({offer()}, SEQ + 1);
+    EXPECT_EQ(aggregatesCache.latestSequence(), SEQ + 1);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ), aggregates);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ + 1), aggregates);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, OnlyLatestLedgerIsMemoized)
+{
+    update({}, SEQ);
+    update({}, SEQ + 1);
+
+    aggregatesCache.put(account, SEQ, aggregates);
+    EXPECT_EQ(aggregatesCache.get(account, SEQ), nullptr);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, ChangedTrustLineDropsBothAccounts)
+{
+    update({}, SEQ);
+    aggregatesCache.put(account, SEQ, aggregates);
+    aggregatesCache.put(account2, SEQ, aggregates);
+    aggregatesCache.put(account3, SEQ, aggregates);
+
+    update({trustLine()}, SEQ + 1);
+    EXPECT_EQ(aggregatesCache.get(account, SEQ + 1), nullptr);
+    EXPECT_EQ(aggregatesCache.get(account2, SEQ + 1), nullptr);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ + 1), aggregates);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, DeletedTrustLineIsLookedUpInLedgerCache)
+{
+    update({trustLine(), offer()}, SEQ);
+    aggregatesCache.put(account, SEQ, aggregates);
+    aggregatesCache.put(account3, SEQ, aggregates);
+
+    update({{ripple::uint256{OFFER_KEY}, {}}}, SEQ + 1);
+    EXPECT_EQ(aggregatesCache.get(account, SEQ + 1), aggregates);
+
+    update({{ripple::uint256{LINE_KEY}, {}}}, SEQ + 2);
+    EXPECT_EQ(aggregatesCache.get(account, SEQ + 2), nullptr);
+    EXPECT_EQ(aggregatesCache.get(account3, SEQ + 2), aggregates);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, UnknownDeletedObjectDropsAll)
+{
+    update({}, SEQ);
+    aggregatesCache.put(account3, SEQ, aggregates);
+
+    update({{ripple::uint256{OFFER_KEY}, {}}}, SEQ + 1);
+    EXPECT_EQ(aggregatesCache.size(), 0);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, MissedLedgerDropsAll)
+{
+    update({}, SEQ);
+    aggregatesCache.put(account3, SEQ, aggregates);
+
+    update({}, SEQ + 2);
+    EXPECT_EQ(aggregatesCache.size(), 0);
+}
+
+TEST_F(TrustLineAggregatesCacheTest, OldestEntryIsDroppedWhenFull)
+{
+    TrustLineAggregatesCache smallCache{2};
+    smallCache.update({}, SEQ, ledgerCache);
+    smallCache.put(account, SEQ, aggregates);
+    smallCache.update({}, SEQ + 1, ledgerCache);
+    smallCache.put(account2, SEQ + 1, aggregates);
+    smallCache.put(account3, SEQ + 1, aggregates);
+
+    EXPECT_EQ(smallCache.size(), 2);
+    EXPECT_EQ(smallCache.get(account, SEQ + 1), nullptr);
+    EXPECT_EQ(smallCache.get(account2, SEQ + 1), aggregates);
+    EXPECT_EQ(smallCache.get(account3, SEQ + 1), aggregates);
+}
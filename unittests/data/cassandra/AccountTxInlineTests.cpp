@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.h"
+#include "data/cassandra/impl/AccountTxInline.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using namespace data;
+using namespace data::cassandra::detail;
+using namespace testing;
+
+namespace {
+
+std::vector<std::string_view>
+columns()
+{
+    std::vector<std::string_view> result;
+    auto rest = ACCOUNT_TX_INLINE_COLUMNS;
+    for (auto pos = rest.find(", "); pos != std::string_view::npos; pos = rest.find(", ")) {
+        result.push_back(rest.substr(0, pos));
+        rest.remove_prefix(pos + 2);
+    }
+    result.push_back(rest);
+    return result;
+}
+
+AccountTxInlineRow
+row(std::uint32_t seq, std::uint32_t idx)
+{
+    return {{seq, idx}, Blob{static_cast<unsigned char>(idx)}, Blob{static_cast<unsigned char>(idx + 1)}, seq + 100};
+}
+
+}  // namespace
+
+TEST(BackendCassandraAccountTxInlineTest, ColumnsMatchRow)
+{
+    EXPECT_THAT(columns(), ElementsAre("seq_idx", "transaction", "metadata", "date"));
+    EXPECT_EQ(columns().size(), std::tuple_size_v<AccountTxInlineRow>);
+}
+
+TEST(BackendCassandraAccountTxInlineTest, RowsBecomeTransactions)
+{
+    auto const page = toInlineAccountTransactions(std::vector{row(30, 2), row(30, 1), row(29, 5)}, 10, false);
+
+    ASSERT_EQ(page.txns.size(), 3);
+    EXPECT_EQ(page.txns[0].ledgerSequence, 30);
+    EXPECT_EQ(page.txns[0].transaction, Blob{2});
+    EXPECT_EQ(page.txns[0].metadata, Blob{3});
+    EXPECT_EQ(page.txns[0].date, 130);
+    EXPECT_EQ(page.txns[2].ledgerSequence, 29);
+    EXPECT_EQ(page.txns[2].transaction, Blob{5});
+    EXPECT_FALSE(page.cursor.has_value());
+}
+
+TEST(BackendCassandraAccountTxInlineTest, FullPageHasCursorAtLastRow)
+{
+    auto const page = toInlineAccountTransactions(std::vector{row(30, 2), row(29, 5)}, 2, false);
+
+    ASSERT_EQ(page.txns.size(), 2);
+    ASSERT_TRUE(page.cursor.has_value());
+    EXPECT_EQ(*page.cursor, TransactionsCursor(29, 5));
+}
+
+TEST(BackendCassandraAccountTxInlineTest, FullForwardPageHasCursorPastLastRow)
+{
+    auto const page = toInlineAccountTransactions(std::vector{row(29, 5), row(30, 2)}, 2, true);
+
+    ASSERT_EQ(page.txns.size(), 2);
+    ASSERT_TRUE(page.cursor.has_value());
+    EXPECT_EQ(*page.cursor, TransactionsCursor(30, 3));
+}
+
+TEST(BackendCassandraAccountTxInlineTest, NoRows)
+{
+    auto const page = toInlineAccountTransactions(std::vector<AccountTxInlineRow>{}, 2, true);
+    EXPECT_TRUE(page.txns.empty());
+    EXPECT_FALSE(page.cursor.has_value());
+}
+
+TEST(BackendCassandraAccountTxInlineTest, RangeFromStartAndLatest)
+{
+    auto const range = toInlineAccountTransactionsRange(std::vector{std::tuple{true, 40u}, std::tuple{false, 30u}});
+
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->minSequence, 30);
+    EXPECT_EQ(range->maxSequence, 40);
+}
+
+TEST(BackendCassandraAccountTxInlineTest, NoRangeWithoutLatest)
+{
+    EXPECT_FALSE(toInlineAccountTransactionsRange(std::vector{std::tuple{false, 30u}}).has_value());
+}
+
+TEST(BackendCassandraAccountTxInlineTest, NoRangeWhileStartingOver)
+{
+    auto const range = toInlineAccountTransactionsRange(std::vector{std::tuple{true, 0u}, std::tuple{false, 30u}});
+    EXPECT_FALSE(range.has_value());
+}
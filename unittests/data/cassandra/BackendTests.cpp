@@ -52,6 +52,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -1261,3 +1262,227 @@ TEST_F(BackendCassandraTest, CacheIntegration)
     ctx.run();
     ASSERT_EQ(done, true);
 }
+
+TEST_F(BackendCassandraTest, InlineAccountTransactions)
+{
+    std::atomic_bool done = false;
+    std::optional<boost::asio::io_context::work> work;
+    work.emplace(ctx);
+
+    boost::asio::spawn(ctx, [this, &done, &work](boost::asio::yield_context yield) {
+        static constexpr std::uint32_t FIRST_SEQ = 100;
+        static constexpr std::uint32_t INLINE_START_SEQ = 103;
+        static constexpr std::uint32_t LAST_SEQ = 106;
+        static constexpr std::uint32_t RESTART_SEQ = 109;
+        static constexpr std::uint32_t RESTART_LAST_SEQ = 110;
+        static constexpr std::uint32_t TXNS_PER_LEDGER = 2;
+
+        Config const inlineCfg{json::parse(fmt::format(
+            R"JSON({{
+                "contact_points": "{}",
+                "keyspace": "{}",
+                "replication_factor": 1,
+                "account_tx_inline": true
+            }})JSON",
+            TestGlobals::instance().backendHost,
+            TestGlobals::instance().backendKeyspace
+        ))};
+        SettingsProvider const inlineSettingsProvider{inlineCfg, 0};
+
+        ripple::AccountID account;
+        account = 998765ul;
+
+        auto const txnBlob = [](std::uint32_t seq, std::uint32_t idx) {
+            return "tx" + std::to_string(seq) + "_" + std::to_string(idx);
+        };
+
+        auto const writeLedger = [&](BackendInterface& writer, std::uint32_t seq) {
+            ripple::LedgerHeader lgrInfo;
+            lgrInfo.seq = seq;
+
+            writer.startWrites();
+            writer.writeLedger(lgrInfo, ledgerInfoToBinaryString(lgrInfo));
+
+            std::vector<AccountTransactionsData> accountTx;
+            for (std::uint32_t idx = 0; idx < TXNS_PER_LEDGER; ++idx) {
+                ripple::uint256 hash;
+                hash = seq * 100ul + idx;
+                std::string const hashStr{reinterpret_cast<char const*>(hash.data()), ripple::uint256::size()};
+                writer.writeTransaction(std::string{hashStr}, seq, 0, txnBlob(seq, idx), "meta");
+
+                AccountTransactionsData data;
+                data.accounts.insert(account);
+                data.ledgerSequence = seq;
+                data.transactionIndex = idx;
+                data.txHash = hash;
+                if (writer.storesAccountTransactionsInline()) {
+                    data.transaction = txnBlob(seq, idx);
+                    data.metadata = "meta";
+                }
+                accountTx.push_back(std::move(data));
+            }
+
+            writer.writeAccountTransactions(std::move(accountTx));
+            EXPECT_TRUE(writer.finishWrites(seq));
+        };
+
+        // ledgers written before account_tx_inline was enabled are only in account_tx
+        EXPECT_FALSE(backend->storesAccountTransactionsInline());
+        for (auto seq = FIRST_SEQ; seq < INLINE_START_SEQ; ++seq)
+            writeLedger(*backend, seq);
+
+        auto inlineBackend = std::make_unique<CassandraBackend>(inlineSettingsProvider, false);
+        EXPECT_TRUE(inlineBackend->storesAccountTransactionsInline());
+        inlineBackend->setRange(FIRST_SEQ, INLINE_START_SEQ - 1);
+        for (auto seq = INLINE_START_SEQ; seq <= LAST_SEQ; ++seq)
+            writeLedger(*inlineBackend, seq);
+
+        auto const fetchAll = [&](bool forward, data::TransactionsCursor cursor, std::uint32_t min, std::uint32_t max) {
+            std::vector<data::TransactionAndMetadata> result;
+            std::optional<data::TransactionsCursor> next = cursor;
+            do {
+                std::uint32_t const limit = 3;
+                auto [txns, retCursor] =
+                    inlineBackend->fetchAccountTransactionsInRange(account, limit, forward, next, min, max, yield);
+                if (retCursor)
+                    EXPECT_EQ(txns.size(), limit);
+                result.insert(result.end(), txns.begin(), txns.end());
+                next = retCursor;
+            } while (next);
+            return result;
+        };
+
+        // backwards pages cross from account_tx_inline into account_tx
+        auto const all = fetchAll(false, {LAST_SEQ, std::numeric_limits<std::uint32_t>::max()}, FIRST_SEQ, LAST_SEQ);
+        ASSERT_EQ(all.size(), (LAST_SEQ - FIRST_SEQ + 1) * TXNS_PER_LEDGER);
+        for (std::size_t i = 0; i < all.size(); ++i) {
+            auto const seq = LAST_SEQ - static_cast<std::uint32_t>(i / TXNS_PER_LEDGER);
+            auto const idx = TXNS_PER_LEDGER - 1 - static_cast<std::uint32_t>(i % TXNS_PER_LEDGER);
+            auto const expected = txnBlob(seq, idx);
+            EXPECT_EQ(std::string(all[i].transaction.begin(), all[i].transaction.end()), expected);
+            EXPECT_EQ(all[i].ledgerSequence, seq);
+        }
+
+        // the lower bound is applied in the query
+        auto const recent =
+            fetchAll(false, {LAST_SEQ, std::numeric_limits<std::uint32_t>::max()}, INLINE_START_SEQ + 1, LAST_SEQ);
+        ASSERT_EQ(recent.size(), (LAST_SEQ - INLINE_START_SEQ) * TXNS_PER_LEDGER);
+        EXPECT_EQ(recent.back().ledgerSequence, INLINE_START_SEQ + 1);
+
+        // and so is the upper bound going forward
+        auto const forwardTxns = fetchAll(true, {INLINE_START_SEQ, 0}, FIRST_SEQ, LAST_SEQ - 1);
+        ASSERT_EQ(forwardTxns.size(), (LAST_SEQ - 1 - INLINE_START_SEQ) * TXNS_PER_LEDGER + 1);
+        EXPECT_EQ(forwardTxns.front().ledgerSequence, INLINE_START_SEQ);
+        EXPECT_EQ(forwardTxns.back().ledgerSequence, LAST_SEQ - 1);
+
+        // inline writes that don't carry on from the latest inline ledger start over, the ledgers in between are read
+        // from account_tx
+        inlineBackend.reset();
+        for (auto seq = LAST_SEQ + 1; seq < RESTART_SEQ; ++seq)
+            writeLedger(*backend, seq);
+
+        inlineBackend = std::make_unique<CassandraBackend>(inlineSettingsProvider, false);
+        inlineBackend->setRange(FIRST_SEQ, RESTART_SEQ - 1);
+        for (auto seq = RESTART_SEQ; seq <= RESTART_LAST_SEQ; ++seq)
+            writeLedger(*inlineBackend, seq);
+
+        auto const afterRestart = fetchAll(
+            false, {RESTART_LAST_SEQ, std::numeric_limits<std::uint32_t>::max()}, FIRST_SEQ, RESTART_LAST_SEQ
+        );
+        ASSERT_EQ(afterRestart.size(), (RESTART_LAST_SEQ - FIRST_SEQ + 1) * TXNS_PER_LEDGER);
+        for (std::size_t i = 0; i < afterRestart.size(); ++i) {
+            auto const seq = RESTART_LAST_SEQ - static_cast<std::uint32_t>(i / TXNS_PER_LEDGER);
+            EXPECT_EQ(afterRestart[i].ledgerSequence, seq);
+        }
+
+        auto const forwardAfterRestart = fetchAll(true, {INLINE_START_SEQ, 0}, FIRST_SEQ, RESTART_LAST_SEQ);
+        ASSERT_EQ(forwardAfterRestart.size(), (RESTART_LAST_SEQ - INLINE_START_SEQ) * TXNS_PER_LEDGER + 1);
+        EXPECT_EQ(forwardAfterRestart.back().ledgerSequence, RESTART_LAST_SEQ);
+
+        inlineBackend.reset();
+        done = true;
+        work.reset();
+    });
+
+    ctx.run();
+    ASSERT_EQ(done, true);
+}
+
+TEST_F(BackendCassandraTest, LedgerTransactionsBundle)
+{
+    std::atomic_bool done = false;
+    std::optional<boost::asio::io_context::work> work;
+    work.emplace(ctx);
+
+    boost::asio::spawn(ctx, [this, &done, &work](boost::asio::yield_context yield) {
+        static constexpr std::uint32_t UNBUNDLED_SEQ = 100;
+        static constexpr std::uint32_t BUNDLED_SEQ = 101;
+        static constexpr std::uint32_t EMPTY_SEQ = 102;
+        static constexpr std::uint32_t CLOSE_TIME = 1234;
+
+        Config const bundleCfg{json::parse(fmt::format(
+            R"JSON({{
+                "contact_points": "{}",
+                "keyspace": "{}",
+                "replication_factor": 1,
+                "ledger_transactions_bundle": true
+            }})JSON",
+            TestGlobals::instance().backendHost,
+            TestGlobals::instance().backendKeyspace
+        ))};
+        SettingsProvider const bundleSettingsProvider{bundleCfg, 0};
+
+        auto const toBlob = [](std::string const& str) { return data::Blob(str.begin(), str.end()); };
+
+        auto const writeLedger = [&](BackendInterface& writer, std::uint32_t seq, std::uint32_t numTxns) {
+            ripple::LedgerHeader lgrInfo;
+            lgrInfo.seq = seq;
+
+            writer.startWrites();
+            writer.writeLedger(lgrInfo, ledgerInfoToBinaryString(lgrInfo));
+
+            std::vector<data::TransactionAndMetadata> bundle;
+            for (std::uint32_t idx = 0; idx < numTxns; ++idx) {
+                ripple::uint256 hash;
+                hash = seq * 100ul + idx;
+                std::string const hashStr{reinterpret_cast<char const*>(hash.data()), ripple::uint256::size()};
+                auto const txn = "tx" + std::to_string(seq) + "_" + std::to_string(idx);
+                auto const meta = "meta" + std::to_string(idx);
+                writer.writeTransaction(std::string{hashStr}, seq, CLOSE_TIME, std::string{txn}, std::string{meta});
+                bundle.emplace_back(toBlob(txn), toBlob(meta), seq, CLOSE_TIME);
+            }
+
+            if (writer.storesLedgerTransactionsBundle())
+                writer.writeLedgerTransactionsBundle(seq, bundle);
+
+            EXPECT_TRUE(writer.finishWrites(seq));
+            return bundle;
+        };
+
+        EXPECT_FALSE(backend->storesLedgerTransactionsBundle());
+        auto const unbundled = writeLedger(*backend, UNBUNDLED_SEQ, 2);
+
+        auto bundleBackend = std::make_unique<CassandraBackend>(bundleSettingsProvider, false);
+        EXPECT_TRUE(bundleBackend->storesLedgerTransactionsBundle());
+        bundleBackend->setRange(UNBUNDLED_SEQ, UNBUNDLED_SEQ);
+        auto const bundled = writeLedger(*bundleBackend, BUNDLED_SEQ, 3);
+        writeLedger(*bundleBackend, EMPTY_SEQ, 0);
+
+        // bundles keep the transaction index order
+        EXPECT_EQ(bundleBackend->fetchAllTransactionsInLedger(BUNDLED_SEQ, yield), bundled);
+        EXPECT_TRUE(bundleBackend->fetchAllTransactionsInLedger(EMPTY_SEQ, yield).empty());
+
+        // ledgers written without a bundle are read one transaction at a time
+        auto fallback = bundleBackend->fetchAllTransactionsInLedger(UNBUNDLED_SEQ, yield);
+        ASSERT_EQ(fallback.size(), unbundled.size());
+        for (auto const& txn : unbundled)
+            EXPECT_NE(std::find(fallback.begin(), fallback.end(), txn), fallback.end());
+
+        bundleBackend.reset();
+        done = true;
+        work.reset();
+    });
+
+    ctx.run();
+    ASSERT_EQ(done, true);
+}
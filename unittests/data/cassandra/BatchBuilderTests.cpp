@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/cassandra/impl/BatchBuilder.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <tuple>
+
+using namespace data::cassandra::detail;
+using namespace testing;
+
+TEST(BackendCassandraBatchBuilderTest, NoStatementsNoBatches)
+{
+    BatchBuilder<int> builder{10, 100};
+    EXPECT_EQ(builder.size(), 0);
+    EXPECT_TRUE(builder.take().empty());
+}
+
+TEST(BackendCassandraBatchBuilderTest, StatementsOfSamePartitionShareBatch)
+{
+    BatchBuilder<int> builder{2, 100};
+    builder.add("b", 1, 1);
+    builder.add("a", 1, 2);
+    builder.add("b", 1, 3);
+    builder.add("a", 1, 4);
+    EXPECT_EQ(builder.size(), 4);
+
+    EXPECT_THAT(builder.take(), ElementsAre(ElementsAre(2, 4), ElementsAre(1, 3)));
+    EXPECT_EQ(builder.size(), 0);
+    EXPECT_TRUE(builder.take().empty());
+}
+
+TEST(BackendCassandraBatchBuilderTest, PartitionsNeverShareBatch)
+{
+    BatchBuilder<int> builder{10, 100};
+    builder.add("a", 1, 1);
+    builder.add("b", 1, 2);
+    builder.add("a", 1, 3);
+    builder.add("c", 1, 4);
+
+    EXPECT_THAT(builder.take(), ElementsAre(ElementsAre(1, 3), ElementsAre(2), ElementsAre(4)));
+}
+
+TEST(BackendCassandraBatchBuilderTest, BatchesAreLimitedByBytes)
+{
+    BatchBuilder<int> builder{10, 100};
+    builder.add("a", 60, 1);
+    builder.add("a", 40, 2);
+    builder.add("a", 1, 3);
+    builder.add("a", 200, 4);  // bigger than a batch on its own
+    builder.add("a", 1, 5);
+
+    EXPECT_THAT(builder.take(), ElementsAre(ElementsAre(1, 2), ElementsAre(3), ElementsAre(4), ElementsAre(5)));
+}
+
+TEST(BackendCassandraBatchBuilderTest, FillsByStatementsOrBytes)
+{
+    BatchBuilder<int> builder{2, 100};
+    builder.add("a", 1, 1);
+    builder.add("b", 1, 2);
+    EXPECT_TRUE(builder.fills(1));
+    EXPECT_FALSE(builder.fills(2));
+
+    builder.add("c", 200, 3);
+    EXPECT_TRUE(builder.fills(2));
+    EXPECT_FALSE(builder.fills(3));
+
+    std::ignore = builder.take();
+    EXPECT_FALSE(builder.fills(1));
+}
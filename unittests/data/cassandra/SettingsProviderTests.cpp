@@ -58,6 +58,10 @@ TEST_F(SettingsProviderTest, Defaults)
     EXPECT_EQ(settings.username, std::nullopt);
     EXPECT_EQ(settings.password, std::nullopt);
     EXPECT_EQ(settings.queueSizeIO, std::nullopt);
+    EXPECT_FALSE(settings.inlineAccountTransactions);
+    EXPECT_FALSE(settings.bundleLedgerTransactions);
+    EXPECT_EQ(settings.writeBatchSize, 20);
+    EXPECT_EQ(settings.writeBatchSizeBytes, 32 * 1024);
 
     auto const* cp = std::get_if<Settings::ContactPoints>(&settings.connectionInfo);
     ASSERT_TRUE(cp != nullptr);
@@ -106,6 +110,42 @@ TEST_F(SettingsProviderTest, DriverOptionalOptionsSpecified)
     EXPECT_EQ(settings.queueSizeIO, 2);
 }
 
+TEST_F(SettingsProviderTest, InlineAccountTransactions)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "account_tx_inline": true
+    })")};
+    SettingsProvider const provider{cfg};
+
+    EXPECT_TRUE(provider.getSettings().inlineAccountTransactions);
+}
+
+TEST_F(SettingsProviderTest, BundleLedgerTransactions)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "ledger_transactions_bundle": true
+    })")};
+    SettingsProvider const provider{cfg};
+
+    EXPECT_TRUE(provider.getSettings().bundleLedgerTransactions);
+}
+
+TEST_F(SettingsProviderTest, WriteBatchSize)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "write_batch_size": 50,
+        "write_batch_size_kb": 100
+    })")};
+    SettingsProvider const provider{cfg};
+
+    auto const settings = provider.getSettings();
+    EXPECT_EQ(settings.writeBatchSize, 50);
+    EXPECT_EQ(settings.writeBatchSizeBytes, 100 * 1024);
+}
+
 TEST_F(SettingsProviderTest, SecureBundleConfig)
 {
     Config const cfg{json::parse(R"({"secure_connect_bundle": "bundleData"})")};
@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/DBHelpers.h"
+#include "data/Types.h"
+#include "etl/SystemState.h"
+#include "etl/impl/Backfill.h"
+#include "util/FakeFetchResponse.h"
+#include "util/Fixtures.h"
+#include "util/MockLedgerLoader.h"
+#include "util/MockLoadBalancer.h"
+#include "util/TestObject.h"
+#include "util/config/Config.h"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/basics/strHex.h>
+#include <ripple/protocol/LedgerHeader.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+
+using namespace testing;
+using namespace etl;
+
+namespace {
+
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto INDEX1 = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+
+std::string
+headerBlob(std::uint32_t seq)
+{
+    ripple::Serializer serializer;
+    ripple::addRaw(CreateLedgerInfo(LEDGERHASH, seq), serializer, /* includeHash = */ true);
+    return {static_cast<char const*>(serializer.data()), serializer.size()};
+}
+
+}  // namespace
+
+class BackfillTest : public MockBackendTest {
+protected:
+    using BackfillType = etl::detail::Backfill<MockLoadBalancer, MockLedgerLoader>;
+
+    std::shared_ptr<MockLoadBalancer> loadBalancer_ = std::make_shared<MockLoadBalancer>();
+    MockLedgerLoader ledgerLoader_;
+    SystemState state_;
+
+    std::unique_ptr<BackfillType>
+    makeBackfill(std::uint32_t startSequence)
+    {
+        auto const config = util::Config{boost::json::parse(
+            R"({"start_sequence": )" + std::to_string(startSequence) +
+            R"(, "chunk_size": 4, "workers": 2, "state_ranges": 1})"
+        )};
+        return std::make_unique<BackfillType>(config, backend, backend, loadBalancer_, ledgerLoader_, state_);
+    }
+
+    void
+    setRange(std::uint32_t min, std::uint32_t max)
+    {
+        backend->setRange(min, max);
+        ON_CALL(*backend, hardFetchLedgerRange(_)).WillByDefault(Return(data::LedgerRange{min, max}));
+    }
+
+    // headers of the given ledgers are in the database, all others are missing
+    void
+    setWrittenHeaders(std::set<std::uint32_t> sequences)
+    {
+        ON_CALL(*backend, fetchLedgerBySequence(_, _))
+            .WillByDefault([sequences = std::move(sequences)](auto seq, auto) -> std::optional<ripple::LedgerHeader> {
+                if (sequences.contains(seq))
+                    return CreateLedgerInfo(LEDGERHASH, seq);
+                return std::nullopt;
+            });
+    }
+};
+
+TEST_F(BackfillTest, NothingToDoWithoutLedgerRange)
+{
+    ON_CALL(*backend, hardFetchLedgerRange(_)).WillByDefault(Return(std::nullopt));
+
+    EXPECT_CALL(*loadBalancer_, fetchLedger).Times(0);
+    EXPECT_CALL(*backend, doExtendRangeDown).Times(0);
+
+    EXPECT_FALSE(makeBackfill(10)->run());
+}
+
+TEST_F(BackfillTest, NothingToDoWhenDatabaseStartsAtStartSequence)
+{
+    setRange(10, 20);
+
+    EXPECT_CALL(*loadBalancer_, fetchLedger).Times(0);
+    EXPECT_CALL(*backend, doExtendRangeDown).Times(0);
+
+    EXPECT_FALSE(makeBackfill(10)->run());
+}
+
+TEST_F(BackfillTest, ResumesAtFirstMissingLedgerOfEachChunk)
+{
+    setRange(15, 20);
+    setWrittenHeaders({9, 10, 11, 14});
+
+    ON_CALL(*loadBalancer_, fetchLedger).WillByDefault([](auto seq, auto, auto, auto) {
+        return std::make_optional<FakeFetchResponse>(headerBlob(seq), seq, true);
+    });
+
+    EXPECT_CALL(*loadBalancer_, forwardToRippled).Times(0);
+    EXPECT_CALL(*loadBalancer_, fetchLedger(12, true, true, _));
+    EXPECT_CALL(*loadBalancer_, fetchLedger(13, true, true, _));
+    EXPECT_CALL(ledgerLoader_, insertTransactions).Times(2);
+    EXPECT_CALL(*backend, waitForWrites).Times(AtLeast(1));
+    EXPECT_CALL(*backend, writeLedger(_, _)).Times(2);
+    EXPECT_CALL(*backend, doFinishWrites).Times(0);
+    EXPECT_CALL(*backend, doExtendRangeDown(15, 10)).WillOnce(Return(true));
+
+    EXPECT_TRUE(makeBackfill(10)->run());
+    EXPECT_EQ(backend->fetchLedgerRange()->minSequence, 10);
+}
+
+TEST_F(BackfillTest, FailsWithoutObjectNeighbors)
+{
+    setRange(11, 20);
+    setWrittenHeaders({9});
+
+    ON_CALL(*loadBalancer_, fetchLedger).WillByDefault([](auto seq, auto, auto, auto) {
+        return std::make_optional<FakeFetchResponse>(headerBlob(seq), seq, false);
+    });
+
+    EXPECT_CALL(*backend, writeLedger).Times(0);
+    EXPECT_CALL(*backend, doExtendRangeDown).Times(0);
+
+    EXPECT_FALSE(makeBackfill(10)->run());
+    EXPECT_EQ(backend->fetchLedgerRange()->minSequence, 11);
+}
+
+TEST_F(BackfillTest, FailsIfNoSourceHasTheLedger)
+{
+    setRange(11, 20);
+    setWrittenHeaders({9});
+
+    EXPECT_CALL(*loadBalancer_, fetchLedger(10, true, true, Optional(_))).WillOnce(Return(std::nullopt));
+    EXPECT_CALL(*backend, writeLedger).Times(0);
+    EXPECT_CALL(*backend, doExtendRangeDown).Times(0);
+
+    EXPECT_FALSE(makeBackfill(10)->run());
+    EXPECT_EQ(backend->fetchLedgerRange()->minSequence, 11);
+}
+
+TEST_F(BackfillTest, DownloadsStateBeforeStartSequence)
+{
+    setRange(10, 20);
+    setWrittenHeaders({});
+
+    auto const object = CreateAccountRootObject(ACCOUNT, 0, 2, 200, 2, INDEX1, 2).getSerializer().peekData();
+    auto const key = ripple::uint256{INDEX1};
+
+    ON_CALL(*loadBalancer_, fetchLedger).WillByDefault([](auto seq, auto, auto, auto) {
+        return std::make_optional<FakeFetchResponse>(headerBlob(seq), seq, true);
+    });
+
+    boost::json::object const state = {{"index", INDEX1}, {"data", ripple::strHex(object)}};
+    boost::json::object const response = {{"result", {{"ledger_index", 8}, {"state", boost::json::array{state}}}}};
+    EXPECT_CALL(*loadBalancer_, forwardToRippled).WillOnce(Return(response));
+
+    EXPECT_CALL(*backend, writeLedgerObject(uint256ToString(key), 8, std::string{object.begin(), object.end()}));
+    EXPECT_CALL(*backend, writeSuccessor(uint256ToString(data::firstKey), 8, uint256ToString(key)));
+    EXPECT_CALL(*backend, writeSuccessor(uint256ToString(key), 8, uint256ToString(data::lastKey)));
+    EXPECT_CALL(*loadBalancer_, fetchLedger(8, false, false, _));
+    EXPECT_CALL(*loadBalancer_, fetchLedger(9, true, true, _));
+    EXPECT_CALL(*backend, writeLedger(_, _)).Times(2);
+    EXPECT_CALL(*backend, doExtendRangeDown(10, 9)).WillOnce(Return(true));
+
+    EXPECT_TRUE(makeBackfill(9)->run());
+}
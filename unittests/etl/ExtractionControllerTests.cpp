@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ExtractionController.h"
+#include "util/Fixtures.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace etl::detail;
+
+namespace {
+
+constexpr auto MAX_LIMIT = 4u;
+
+}  // namespace
+
+class ETLExtractionControllerTest : public NoLoggerFixture {
+protected:
+    ExtractionController controller_{MAX_LIMIT, MAX_LIMIT};
+};
+
+TEST_F(ETLExtractionControllerTest, StartsAtInitialLimit)
+{
+    ExtractionController controller{2, MAX_LIMIT};
+    EXPECT_EQ(controller.limit(), 2);
+
+    EXPECT_EQ(ExtractionController(0, MAX_LIMIT).limit(), ExtractionController::MIN_LIMIT);
+    EXPECT_EQ(ExtractionController(MAX_LIMIT + 1, MAX_LIMIT).limit(), MAX_LIMIT);
+}
+
+TEST_F(ETLExtractionControllerTest, GrowsAboveInitialLimitUpToMaxLimit)
+{
+    ExtractionController controller{1, MAX_LIMIT};
+
+    for (auto i = 0u; i < 2 * MAX_LIMIT; ++i) {
+        if (controller.inFlight() < controller.limit()) {
+            ASSERT_TRUE(controller.acquire(i));
+        }
+        controller.onConsumed(true, 0);
+    }
+
+    EXPECT_EQ(controller.limit(), MAX_LIMIT);
+    EXPECT_EQ(controller.inFlight(), MAX_LIMIT);
+}
+
+TEST_F(ETLExtractionControllerTest, StartsAtMaxLimit)
+{
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT);
+
+    for (auto i = 0u; i < MAX_LIMIT; ++i)
+        EXPECT_TRUE(controller_.acquire(i));
+
+    EXPECT_EQ(controller_.inFlight(), MAX_LIMIT);
+
+    controller_.release();
+    EXPECT_EQ(controller_.inFlight(), MAX_LIMIT - 1);
+}
+
+TEST_F(ETLExtractionControllerTest, ShrinksWhileBacklogGrows)
+{
+    controller_.onConsumed(false, 2 * MAX_LIMIT);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT);
+
+    controller_.onConsumed(false, 2 * MAX_LIMIT + 1);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT - 1);
+
+    for (auto i = 0u; i < 2 * MAX_LIMIT; ++i)
+        controller_.onConsumed(false, 100);
+
+    EXPECT_EQ(controller_.limit(), ExtractionController::MIN_LIMIT);
+}
+
+TEST_F(ETLExtractionControllerTest, GrowsOnlyWhenLimitHoldsFetchesBack)
+{
+    controller_.onConsumed(false, 100);
+    controller_.onConsumed(false, 100);
+    ASSERT_EQ(controller_.limit(), MAX_LIMIT - 2);
+
+    // the transformer waits but the extractors are not using the whole limit
+    controller_.onConsumed(true, 0);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT - 2);
+
+    for (auto i = 0u; i < MAX_LIMIT - 2; ++i)
+        ASSERT_TRUE(controller_.acquire(i));
+
+    controller_.onConsumed(true, 0);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT - 1);
+
+    ASSERT_TRUE(controller_.acquire(MAX_LIMIT));
+    controller_.onConsumed(true, 0);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT);
+
+    ASSERT_TRUE(controller_.acquire(MAX_LIMIT + 1));
+    controller_.onConsumed(true, 0);
+    EXPECT_EQ(controller_.limit(), MAX_LIMIT);
+}
+
+TEST_F(ETLExtractionControllerTest, GrantsFetchesInLedgerOrder)
+{
+    ExtractionController controller{1, 1};
+    ASSERT_TRUE(controller.acquire(10));
+
+    std::mutex mtx;
+    std::vector<std::uint32_t> granted;
+    auto const fetch = [&](std::uint32_t sequence) {
+        if (controller.acquire(sequence)) {
+            std::scoped_lock const lck{mtx};
+            granted.push_back(sequence);
+        }
+        controller.release();
+    };
+
+    auto later = std::async(std::launch::async, fetch, 12);
+    auto next = std::async(std::launch::async, fetch, 11);
+
+    // emulate waiting for both fetches to wait for the first one
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    EXPECT_TRUE(granted.empty());
+
+    controller.release();
+    later.wait();
+    next.wait();
+
+    EXPECT_EQ(granted, (std::vector<std::uint32_t>{11, 12}));
+}
+
+TEST_F(ETLExtractionControllerTest, StopWakesUpWaitingFetches)
+{
+    ExtractionController controller{1, 1};
+    ASSERT_TRUE(controller.acquire(1));
+
+    auto waiting = std::async(std::launch::async, [&controller]() { return controller.acquire(2); });
+
+    controller.stop();
+    EXPECT_FALSE(waiting.get());
+    EXPECT_FALSE(controller.acquire(3));
+}
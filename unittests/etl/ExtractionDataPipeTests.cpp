@@ -33,7 +33,7 @@ constexpr static auto START_SEQ = 1234;
 
 class ETLExtractionDataPipeTest : public NoLoggerFixture {
 protected:
-    etl::detail::ExtractionDataPipe<uint32_t> pipe_{STRIDE, START_SEQ};
+    etl::detail::ExtractionDataPipe<uint32_t> pipe_{STRIDE, START_SEQ, STRIDE};
 };
 
 TEST_F(ETLExtractionDataPipeTest, StrideMatchesInput)
@@ -81,3 +81,19 @@ TEST_F(ETLExtractionDataPipeTest, CallingCleanupUnblocksOtherThread)
     bgThread.join();
     EXPECT_TRUE(unblocked);
 }
+
+TEST_F(ETLExtractionDataPipeTest, FetchesAreLimitedByStrideUntilCleanup)
+{
+    for (std::size_t i = 0; i < STRIDE; ++i)
+        EXPECT_TRUE(pipe_.acquire(START_SEQ + i));
+
+    std::atomic_bool acquired = true;
+    auto bgThread = std::thread([this, &acquired] { acquired = pipe_.acquire(START_SEQ + STRIDE); });
+
+    // emulate waiting for above thread to get blocked
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+    pipe_.cleanup();
+    bgThread.join();
+    EXPECT_FALSE(acquired);
+}
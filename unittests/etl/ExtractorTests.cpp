@@ -76,6 +76,9 @@ TEST_F(ETLExtractorTest, StopsWhenCurrentSequenceExceedsFinishSequence)
     EXPECT_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).Times(3);
     ON_CALL(dataPipe_, getStride).WillByDefault(Return(4));
     EXPECT_CALL(dataPipe_, getStride).Times(3);
+    ON_CALL(dataPipe_, acquire).WillByDefault(Return(true));
+    EXPECT_CALL(dataPipe_, acquire).Times(3);
+    EXPECT_CALL(dataPipe_, release).Times(3);
 
     auto response = FakeFetchResponse{};
     ON_CALL(ledgerFetcher_, fetchDataAndDiff(_)).WillByDefault(Return(response));
@@ -113,6 +116,9 @@ TEST_F(ETLExtractorTest, StopsIfFetchIsUnsuccessful)
     ON_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).WillByDefault(Return(true));
     EXPECT_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).Times(1);
 
+    ON_CALL(dataPipe_, acquire).WillByDefault(Return(true));
+    EXPECT_CALL(dataPipe_, acquire).Times(1);
+    EXPECT_CALL(dataPipe_, release).Times(1);
     ON_CALL(ledgerFetcher_, fetchDataAndDiff(_)).WillByDefault(Return(std::nullopt));
     EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).Times(1);
     EXPECT_CALL(dataPipe_, finish(0)).Times(1);
@@ -142,6 +148,9 @@ TEST_F(ETLExtractorTest, SendsCorrectResponseToDataPipe)
     EXPECT_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).Times(1);
     ON_CALL(dataPipe_, getStride).WillByDefault(Return(4));
     EXPECT_CALL(dataPipe_, getStride).Times(1);
+    ON_CALL(dataPipe_, acquire).WillByDefault(Return(true));
+    EXPECT_CALL(dataPipe_, acquire(0)).Times(1);
+    EXPECT_CALL(dataPipe_, release).Times(1);
 
     auto response = FakeFetchResponse{1234};
     auto optionalResponse = std::optional<FakeFetchResponse>{};
@@ -159,6 +168,22 @@ TEST_F(ETLExtractorTest, SendsCorrectResponseToDataPipe)
     EXPECT_EQ(optionalResponse.value(), response);
 }
 
+TEST_F(ETLExtractorTest, StopsIfPipeDoesNotAllowFetching)
+{
+    auto const rawNetworkValidatedLedgersPtr = networkValidatedLedgers_.get();
+
+    ON_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).WillByDefault(Return(true));
+    EXPECT_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).Times(1);
+    ON_CALL(dataPipe_, acquire).WillByDefault(Return(false));
+    EXPECT_CALL(dataPipe_, acquire(0)).Times(1);
+    EXPECT_CALL(dataPipe_, release).Times(0);
+    EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).Times(0);
+    EXPECT_CALL(dataPipe_, finish(0)).Times(1);
+
+    // the pipe is being cleaned up so nothing is fetched
+    extractor_ = std::make_unique<ExtractorType>(dataPipe_, networkValidatedLedgers_, ledgerFetcher_, 0, 64, state_);
+}
+
 TEST_F(ETLExtractorTest, CallsPipeFinishWithInitialSequenceAtExit)
 {
     EXPECT_CALL(dataPipe_, finish(123)).Times(1);
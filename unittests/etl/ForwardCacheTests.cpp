@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ForwardCache.h"
+#include "util/Fixtures.h"
+#include "util/MockPrometheus.h"
+#include "util/MockSource.h"
+#include "util/config/Config.h"
+
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+using namespace etl::detail;
+using namespace testing;
+
+namespace {
+
+constexpr auto CONFIG = R"({
+    "cache": ["fee"],
+    "cache_ttl": [{"command": "account_info", "ttl": 10}, {"command": "server_state", "ttl": 0}]
+})";
+
+boost::json::object const FEE_RESPONSE = {{"result", {{"drops", {{"base_fee", "10"}}}}}, {"forwarded", true}};
+
+}  // namespace
+
+struct ForwardCacheTest : util::prometheus::WithPrometheus, SyncAsioContextTest {
+    StrictMock<MockSource> source;
+    ForwardCache cache{util::Config{boost::json::parse(CONFIG)}, source};
+};
+
+TEST_F(ForwardCacheTest, NotCachedCommandsGoToRippled)
+{
+    boost::json::object const request = {{"command", "server_info"}};
+    EXPECT_CALL(source, requestFromRippled(request, std::optional<std::string>{"1.2.3.4"}, _))
+        .Times(2)
+        .WillRepeatedly(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_EQ(cache.get(request, "1.2.3.4", yield), FEE_RESPONSE);
+        EXPECT_EQ(cache.get(request, "1.2.3.4", yield), FEE_RESPONSE);
+    });
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(ForwardCacheTest, CachesByNormalizedRequest)
+{
+    EXPECT_CALL(source, requestFromRippled).WillOnce(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        auto response = cache.get(
+            {{"command", "account_info"}, {"account", "rAccount"}, {"ledger_index", "current"}, {"id", 1}},
+            std::nullopt,
+            yield
+        );
+        ASSERT_TRUE(response);
+        EXPECT_FALSE(response->contains("id"));
+
+        response = cache.get(
+            {{"ledger_index", "current"}, {"id", 2}, {"account", "rAccount"}, {"command", "account_info"}},
+            std::nullopt,
+            yield
+        );
+        ASSERT_TRUE(response);
+        EXPECT_EQ(response->at("id").as_int64(), 2);
+        EXPECT_EQ(response->at("result"), FEE_RESPONSE.at("result"));
+    });
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(ForwardCacheTest, DifferentParametersAreCachedSeparately)
+{
+    EXPECT_CALL(source, requestFromRippled).Times(2).WillRepeatedly(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_TRUE(cache.get({{"command", "account_info"}, {"account", "rAccount"}}, std::nullopt, yield));
+        EXPECT_TRUE(cache.get({{"command", "account_info"}, {"account", "rOther"}}, std::nullopt, yield));
+        EXPECT_TRUE(cache.get({{"method", "account_info"}, {"account", "rOther"}}, std::nullopt, yield));
+    });
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(ForwardCacheTest, NewLedgerDropsCachedResponses)
+{
+    EXPECT_CALL(source, requestFromRippled).Times(2).WillRepeatedly(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        cache.onLedgerClosed(10);
+        EXPECT_TRUE(cache.get({{"command", "fee"}}, std::nullopt, yield));
+
+        cache.onLedgerClosed(10);
+        cache.onLedgerClosed(9);
+        EXPECT_TRUE(cache.get({{"command", "fee"}}, std::nullopt, yield));
+        EXPECT_EQ(cache.size(), 1);
+
+        cache.onLedgerClosed(11);
+        EXPECT_EQ(cache.size(), 0);
+        EXPECT_TRUE(cache.get({{"command", "fee"}}, std::nullopt, yield));
+    });
+}
+
+TEST_F(ForwardCacheTest, ResponsesExpireAfterTtl)
+{
+    EXPECT_CALL(source, requestFromRippled).Times(2).WillRepeatedly(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_TRUE(cache.get({{"command", "server_state"}}, std::nullopt, yield));
+        EXPECT_TRUE(cache.get({{"command", "server_state"}}, std::nullopt, yield));
+    });
+}
+
+TEST_F(ForwardCacheTest, ErrorsAreNotCached)
+{
+    boost::json::object const error = {{"error", "noNetwork"}};
+    EXPECT_CALL(source, requestFromRippled)
+        .WillOnce(Return(std::nullopt))
+        .WillOnce(Return(error))
+        .WillOnce(Return(FEE_RESPONSE));
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        EXPECT_FALSE(cache.get({{"command", "fee"}}, std::nullopt, yield));
+        EXPECT_EQ(cache.get({{"command", "fee"}}, std::nullopt, yield), error);
+        EXPECT_EQ(cache.get({{"command", "fee"}}, std::nullopt, yield), FEE_RESPONSE);
+    });
+}
+
+TEST_F(ForwardCacheTest, ConcurrentMissesShareOneRequest)
+{
+    EXPECT_CALL(source, requestFromRippled).WillOnce([](auto const&, auto const&, boost::asio::yield_context yield) {
+        boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{10}};
+        timer.async_wait(yield);
+        return std::make_optional(FEE_RESPONSE);
+    });
+
+    std::optional<boost::json::object> second;
+    runSpawn([&](boost::asio::yield_context yield) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context innerYield) {
+            second = cache.get({{"command", "fee"}, {"id", 2}}, std::nullopt, innerYield);
+        });
+
+        auto const first = cache.get({{"command", "fee"}, {"id", 1}}, std::nullopt, yield);
+        ASSERT_TRUE(first);
+        EXPECT_EQ(first->at("result"), FEE_RESPONSE.at("result"));
+    });
+
+    ASSERT_TRUE(second);
+    EXPECT_EQ(second->at("id").as_int64(), 2);
+    EXPECT_EQ(second->at("result"), FEE_RESPONSE.at("result"));
+}
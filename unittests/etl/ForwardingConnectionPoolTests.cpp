@@ -0,0 +1,249 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/ForwardingConnectionPool.h"
+#include "util/Fixtures.h"
+#include "util/config/Config.h"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace etl::detail;
+
+namespace {
+
+namespace beast = boost::beast;
+namespace http = boost::beast::http;
+namespace websocket = boost::beast::websocket;
+
+}  // namespace
+
+class ForwardingConnectionPoolTest : public SyncAsioContextTest {
+protected:
+    boost::asio::ip::tcp::acceptor acceptor_{ctx, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    std::size_t accepted_ = 0;
+    std::vector<std::string> forwardedFor_;
+
+    util::Config
+    makeConfig(std::string const& forwarding = "{}") const
+    {
+        return util::Config{boost::json::parse(fmt::format(
+            R"({{"ip": "127.0.0.1", "ws_port": "{}", "forwarding": {}}})", acceptor_.local_endpoint().port(), forwarding
+        ))};
+    }
+
+    // A fake rippled answering the first request on a connection right away and the rest in batches of batchSize, last
+    // request of a batch first
+    void
+    startServer(std::size_t batchSize = 1)
+    {
+        boost::asio::spawn(ctx, [this, batchSize](boost::asio::yield_context yield) {
+            for (;;) {
+                beast::error_code ec;
+                boost::asio::ip::tcp::socket socket{ctx};
+                acceptor_.async_accept(socket, yield[ec]);
+                if (ec)
+                    return;
+
+                ++accepted_;
+                boost::asio::spawn(
+                    ctx,
+                    [this, batchSize, socket = std::move(socket)](boost::asio::yield_context serveYield) mutable {
+                        serve(std::move(socket), batchSize, serveYield);
+                    }
+                );
+            }
+        });
+    }
+
+private:
+    void
+    serve(boost::asio::ip::tcp::socket socket, std::size_t batchSize, boost::asio::yield_context yield)
+    {
+        beast::error_code ec;
+        websocket::stream<beast::tcp_stream> ws{std::move(socket)};
+
+        beast::flat_buffer buffer;
+        http::request<http::string_body> handshake;
+        http::async_read(ws.next_layer(), buffer, handshake, yield[ec]);
+        if (ec)
+            return;
+
+        auto const forwarded = handshake[http::field::forwarded];
+        forwardedFor_.emplace_back(forwarded.data(), forwarded.size());
+
+        ws.async_accept(handshake, yield[ec]);
+        if (ec)
+            return;
+
+        std::vector<boost::json::object> batch;
+        auto firstMessage = true;
+        for (;;) {
+            beast::flat_buffer message;
+            ws.async_read(message, yield[ec]);
+            if (ec)
+                return;
+
+            batch.push_back(boost::json::parse(beast::buffers_to_string(message.data())).as_object());
+            if (batch.size() < batchSize and not firstMessage)
+                continue;
+
+            firstMessage = false;
+
+            for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+                boost::json::object const response{
+                    {"id", it->at("id")}, {"result", {{"command", it->at("command")}}}, {"status", "success"}
+                };
+                auto const serialized = boost::json::serialize(response);
+                ws.async_write(boost::asio::buffer(serialized), yield[ec]);
+                if (ec)
+                    return;
+            }
+            batch.clear();
+        }
+    }
+};
+
+TEST_F(ForwardingConnectionPoolTest, ReusesConnectionAndRestoresClientId)
+{
+    startServer();
+    runSpawn([this](boost::asio::yield_context yield) {
+        {
+            ForwardingConnectionPool pool{makeConfig()};
+
+            auto response = pool.request({{"command", "fee"}, {"id", 42}}, std::nullopt, yield);
+            ASSERT_TRUE(response);
+            EXPECT_EQ(response->at("id").as_int64(), 42);
+            EXPECT_EQ(response->at("result").at("command").as_string(), "fee");
+            EXPECT_TRUE(response->at("forwarded").as_bool());
+
+            response = pool.request({{"command", "server_info"}}, std::nullopt, yield);
+            ASSERT_TRUE(response);
+            EXPECT_FALSE(response->contains("id"));
+            EXPECT_EQ(response->at("result").at("command").as_string(), "server_info");
+
+            EXPECT_EQ(pool.size(), 1);
+        }
+        acceptor_.close();
+    });
+
+    EXPECT_EQ(accepted_, 1);
+}
+
+TEST_F(ForwardingConnectionPoolTest, SeparateConnectionPerClientIp)
+{
+    startServer();
+    runSpawn([this](boost::asio::yield_context yield) {
+        {
+            ForwardingConnectionPool pool{makeConfig()};
+
+            EXPECT_TRUE(pool.request({{"command", "fee"}}, "1.2.3.4", yield));
+            EXPECT_TRUE(pool.request({{"command", "fee"}}, "5.6.7.8", yield));
+            EXPECT_TRUE(pool.request({{"command", "fee"}}, "1.2.3.4", yield));
+
+            EXPECT_EQ(pool.size(), 2);
+        }
+        acceptor_.close();
+    });
+
+    EXPECT_EQ(accepted_, 2);
+    EXPECT_EQ(forwardedFor_, (std::vector<std::string>{"for=1.2.3.4", "for=5.6.7.8"}));
+}
+
+TEST_F(ForwardingConnectionPoolTest, MatchesResponsesArrivingOutOfOrder)
+{
+    startServer(2);
+    auto pool = std::make_shared<ForwardingConnectionPool>(makeConfig());
+    std::optional<boost::json::object> first;
+    std::optional<boost::json::object> second;
+    std::size_t done = 0;
+    auto const finish = [&]() {
+        if (++done == 2)
+            acceptor_.close();
+    };
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        ASSERT_TRUE(pool->request({{"command", "ping"}}, std::nullopt, yield));
+
+        // both requests share the connection and rippled answers the later one first
+        boost::asio::spawn(ctx, [&, pool](boost::asio::yield_context innerYield) {
+            second = pool->request({{"command", "server_info"}, {"id", 2}}, std::nullopt, innerYield);
+            finish();
+        });
+        first = pool->request({{"command", "fee"}, {"id", 1}}, std::nullopt, yield);
+        finish();
+        pool.reset();
+    });
+
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first->at("id").as_int64(), 1);
+    EXPECT_EQ(first->at("result").at("command").as_string(), "fee");
+    EXPECT_EQ(second->at("id").as_int64(), 2);
+    EXPECT_EQ(second->at("result").at("command").as_string(), "server_info");
+    EXPECT_EQ(accepted_, 1);
+}
+
+TEST_F(ForwardingConnectionPoolTest, FailsWhenTooManyRequestsInFlight)
+{
+    startServer();
+    runSpawn([this](boost::asio::yield_context yield) {
+        {
+            ForwardingConnectionPool pool{makeConfig(R"({"max_in_flight": 0})")};
+            EXPECT_FALSE(pool.request({{"command", "fee"}}, std::nullopt, yield));
+        }
+        acceptor_.close();
+    });
+
+    EXPECT_EQ(accepted_, 0);
+}
+
+TEST_F(ForwardingConnectionPoolTest, FailsWhenRippledIsUnreachable)
+{
+    auto const config = makeConfig();
+    acceptor_.close();
+
+    runSpawn([&](boost::asio::yield_context yield) {
+        ForwardingConnectionPool pool{config};
+        EXPECT_FALSE(pool.request({{"command", "fee"}}, std::nullopt, yield));
+        EXPECT_EQ(pool.size(), 0);
+    });
+}
@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/ETLHelpers.h"
+#include "etl/impl/InitialLoadQueue.h"
+
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+
+#include <chrono>
+#include <future>
+#include <optional>
+#include <thread>
+
+using namespace etl::detail;
+
+namespace {
+
+constexpr auto STALL_TIMEOUT = std::chrono::milliseconds{1};
+constexpr auto SOURCE = "source";
+constexpr auto OTHER_SOURCE = "other source";
+
+}  // namespace
+
+TEST(InitialLoadQueueTest, RangesCoverAllMarkers)
+{
+    auto const markers = etl::getMarkers(4);
+    InitialLoadQueue queue{markers};
+
+    for (std::size_t i = 0; i < markers.size(); ++i) {
+        auto const range = queue.take(SOURCE, false);
+        ASSERT_TRUE(range);
+        EXPECT_EQ(range->id, i);
+        EXPECT_EQ(range->marker, markers[i]);
+        EXPECT_TRUE(range->lastKey.empty());
+        if (i + 1 < markers.size()) {
+            EXPECT_EQ(range->end, markers[i + 1]);
+        } else {
+            EXPECT_FALSE(range->end);
+        }
+    }
+
+    EXPECT_FALSE(queue.take(SOURCE, false));
+    EXPECT_FALSE(queue.done());
+    EXPECT_EQ(queue.remaining(), 4);
+
+    for (std::size_t i = 0; i < markers.size(); ++i)
+        queue.finish(i);
+
+    EXPECT_TRUE(queue.done());
+    EXPECT_EQ(queue.remaining(), 0);
+    EXPECT_FALSE(queue.take(OTHER_SOURCE, true));
+}
+
+TEST(InitialLoadQueueTest, RangeGivenBackIsResumedFirst)
+{
+    InitialLoadQueue queue{etl::getMarkers(2)};
+
+    auto range = queue.take(SOURCE, false);
+    ASSERT_TRUE(range);
+    range->marker = ripple::uint256{"1000000000000000000000000000000000000000000000000000000000000000"};
+    range->lastKey = "lastKey";
+    queue.giveBack(*range);
+
+    auto const resumed = queue.take(SOURCE, false);
+    ASSERT_TRUE(resumed);
+    EXPECT_EQ(resumed->id, range->id);
+    EXPECT_EQ(resumed->marker, range->marker);
+    EXPECT_EQ(resumed->end, range->end);
+    EXPECT_EQ(resumed->lastKey, "lastKey");
+    EXPECT_EQ(queue.remaining(), 2);
+}
+
+TEST(InitialLoadQueueTest, ProgressingRangeIsNotStolen)
+{
+    InitialLoadQueue queue{etl::getMarkers(1), std::chrono::hours{1}};
+
+    auto const range = queue.take(SOURCE, false);
+    ASSERT_TRUE(range);
+
+    auto waiter = std::async(std::launch::async, [&queue]() { return queue.take(OTHER_SOURCE, true); });
+    queue.progress(range->id);
+    EXPECT_FALSE(queue.shouldRelease(range->id));
+
+    queue.finish(range->id);
+    EXPECT_FALSE(waiter.get());
+    EXPECT_TRUE(queue.done());
+}
+
+TEST(InitialLoadQueueTest, WaitingStealsStalledRange)
+{
+    InitialLoadQueue queue{etl::getMarkers(1), STALL_TIMEOUT};
+
+    auto range = queue.take(SOURCE, false);
+    ASSERT_TRUE(range);
+
+    auto waiter = std::async(std::launch::async, [&queue]() { return queue.take(OTHER_SOURCE, true); });
+    while (not queue.shouldRelease(range->id))
+        std::this_thread::sleep_for(STALL_TIMEOUT);
+
+    range->lastKey = "lastKey";
+    queue.release(*range, SOURCE);
+
+    auto const stolen = waiter.get();
+    ASSERT_TRUE(stolen);
+    EXPECT_EQ(stolen->id, range->id);
+    EXPECT_EQ(stolen->lastKey, "lastKey");
+    EXPECT_FALSE(queue.shouldRelease(stolen->id));
+}
+
+TEST(InitialLoadQueueTest, ReleasedRangeIsLeftToOtherSources)
+{
+    InitialLoadQueue queue{etl::getMarkers(2), std::chrono::hours{1}};
+
+    auto const range = queue.take(SOURCE, false);
+    ASSERT_TRUE(range);
+    queue.release(*range, SOURCE);
+
+    auto const next = queue.take(SOURCE, false);
+    ASSERT_TRUE(next);
+    EXPECT_NE(next->id, range->id);
+    EXPECT_FALSE(queue.take(SOURCE, false));
+
+    auto const stolen = queue.take(OTHER_SOURCE, false);
+    ASSERT_TRUE(stolen);
+    EXPECT_EQ(stolen->id, range->id);
+}
+
+TEST(InitialLoadQueueTest, ReleasedRangeIsTakenBackIfNoOtherSourceTakesIt)
+{
+    InitialLoadQueue queue{etl::getMarkers(1), STALL_TIMEOUT};
+
+    auto const range = queue.take(SOURCE, false);
+    ASSERT_TRUE(range);
+    queue.release(*range, SOURCE);
+
+    auto const takenBack = queue.take(SOURCE, true);
+    ASSERT_TRUE(takenBack);
+    EXPECT_EQ(takenBack->id, range->id);
+}
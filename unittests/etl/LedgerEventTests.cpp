@@ -0,0 +1,168 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.h"
+#include "etl/impl/LedgerEvent.h"
+#include "etl/impl/LedgerEventClient.h"
+#include "etl/impl/LedgerEventServer.h"
+#include "util/Fixtures.h"
+#include "util/TestObject.h"
+#include "util/config/Config.h"
+
+#include <boost/json/parse.hpp>
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+#include <ripple/basics/base_uint.h>
+#include <ripple/protocol/Indexes.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace etl::detail;
+namespace json = boost::json;
+
+namespace {
+
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto INDEX = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr std::uint32_t SEQ = 30;
+constexpr auto TIMEOUT = std::chrono::seconds{5};
+
+LedgerEvent
+makeEvent(std::uint32_t seq)
+{
+    data::TransactionAndMetadata txn;
+    txn.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, seq).getSerializer().peekData();
+    txn.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30).getSerializer().peekData();
+    txn.ledgerSequence = seq;
+    txn.date = 123;
+
+    return LedgerEvent{
+        .header = CreateLedgerInfo(LEDGERHASH, seq),
+        .diff =
+            {data::LedgerObject{.key = ripple::keylet::fees().key, .blob = CreateFeeSettingBlob(1, 2, 3, 4, 0)},
+             data::LedgerObject{.key = ripple::uint256{INDEX}, .blob = {}}},
+        .transactions = {txn},
+    };
+}
+
+void
+expectEqual(LedgerEvent const& actual, LedgerEvent const& expected)
+{
+    EXPECT_EQ(actual.header.seq, expected.header.seq);
+    EXPECT_EQ(actual.header.hash, expected.header.hash);
+    EXPECT_EQ(actual.header.parentHash, expected.header.parentHash);
+    EXPECT_EQ(actual.header.closeTime, expected.header.closeTime);
+    EXPECT_EQ(actual.diff, expected.diff);
+    EXPECT_EQ(actual.transactions, expected.transactions);
+}
+
+}  // namespace
+
+class ETLLedgerEventTest : public NoLoggerFixture {};
+
+TEST_F(ETLLedgerEventTest, SerializedEventCanBeDeserialized)
+{
+    auto const event = makeEvent(SEQ);
+    auto const deserialized = deserializeLedgerEvent(serialize(event));
+
+    ASSERT_TRUE(deserialized);
+    expectEqual(*deserialized, event);
+}
+
+TEST_F(ETLLedgerEventTest, MalformedEventIsRejected)
+{
+    auto const serialized = serialize(makeEvent(SEQ));
+
+    EXPECT_FALSE(deserializeLedgerEvent(""));
+    EXPECT_FALSE(deserializeLedgerEvent(serialized.substr(0, serialized.size() - 1)));
+    EXPECT_FALSE(deserializeLedgerEvent(serialized + "x"));
+
+    auto otherVersion = serialized;
+    otherVersion[3] = 2;
+    EXPECT_FALSE(deserializeLedgerEvent(otherVersion));
+}
+
+class ETLLedgerEventStreamTest : public NoLoggerFixture {
+protected:
+    LedgerEventServer server_{util::Config{json::parse(R"({"ip": "127.0.0.1", "port": 0})")}};
+
+    std::unique_ptr<LedgerEventClient>
+    makeClient(std::uint16_t port) const
+    {
+        return std::make_unique<LedgerEventClient>(util::Config{
+            json::parse(fmt::format(R"({{"peers": [{{"ip": "127.0.0.1", "port": {}}}]}})", port))
+        });
+    }
+
+    void
+    waitForSubscriber() const
+    {
+        while (server_.numSubscribers() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+};
+
+TEST_F(ETLLedgerEventStreamTest, ReplicaReceivesWrittenLedgers)
+{
+    auto const client = makeClient(server_.port());
+    waitForSubscriber();
+
+    server_.publish(std::make_shared<LedgerEvent const>(makeEvent(SEQ)));
+    server_.publish(std::make_shared<LedgerEvent const>(makeEvent(SEQ + 1)));
+
+    auto const first = client->waitFor(SEQ, TIMEOUT);
+    ASSERT_TRUE(first);
+    expectEqual(*first, makeEvent(SEQ));
+
+    auto const second = client->waitFor(SEQ + 1, TIMEOUT);
+    ASSERT_TRUE(second);
+    expectEqual(*second, makeEvent(SEQ + 1));
+}
+
+TEST_F(ETLLedgerEventStreamTest, MissedLedgerIsNotWaitedFor)
+{
+    auto const client = makeClient(server_.port());
+    waitForSubscriber();
+
+    server_.publish(std::make_shared<LedgerEvent const>(makeEvent(SEQ + 1)));
+
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(client->waitFor(SEQ, TIMEOUT));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, TIMEOUT);
+
+    EXPECT_TRUE(client->waitFor(SEQ + 1, std::chrono::seconds{0}));
+}
+
+TEST_F(ETLLedgerEventStreamTest, NothingIsWaitedForWithoutWriter)
+{
+    auto const port = server_.port();
+    auto const client = makeClient(port + 1);
+
+    EXPECT_FALSE(client->isConnected());
+
+    auto const start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(client->waitFor(SEQ, TIMEOUT));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, TIMEOUT);
+}
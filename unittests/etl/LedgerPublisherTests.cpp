@@ -20,6 +20,7 @@
 #include "data/DBHelpers.h"
 #include "data/Types.h"
 #include "etl/SystemState.h"
+#include "etl/impl/LedgerEvent.h"
 #include "etl/impl/LedgerPublisher.h"
 #include "util/Fixtures.h"
 #include "util/MockCache.h"
@@ -36,6 +37,7 @@
 #include <ripple/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <memory>
 #include <vector>
 
 using namespace testing;
@@ -156,6 +158,47 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerInfoInRange)
     EXPECT_TRUE(publisher.lastPublishAgeSeconds() <= 1);
 }
 
+TEST_F(ETLLedgerPublisherTest, PublishLedgerEventDoesNotReadLedgerFromDatabase)
+{
+    SystemState dummyState;
+    dummyState.isWriting = false;
+
+    TransactionAndMetadata t1;
+    t1.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, SEQ).getSerializer().peekData();
+    t1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30).getSerializer().peekData();
+    t1.ledgerSequence = SEQ;
+
+    auto const event = std::make_shared<detail::LedgerEvent const>(detail::LedgerEvent{
+        .header = CreateLedgerInfo(LEDGERHASH, SEQ, 0),
+        .diff = {LedgerObject{.key = ripple::keylet::fees().key, .blob = CreateFeeSettingBlob(1, 2, 3, 4, 0)}},
+        .transactions = {t1},
+    });
+    detail::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
+    publisher.publish(event);
+
+    EXPECT_CALL(*backend, fetchLedgerDiff).Times(0);
+    EXPECT_CALL(*backend, fetchAllTransactionsInLedger).Times(0);
+    EXPECT_CALL(mockCache, updateImp).Times(1);
+
+    // fees are still read, usually from the cache
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(1);
+    ON_CALL(*backend, doFetchLedgerObject(ripple::keylet::fees().key, SEQ, _))
+        .WillByDefault(Return(CreateFeeSettingBlob(1, 2, 3, 4, 0)));
+
+    EXPECT_TRUE(publisher.getLastPublishedSequence());
+    EXPECT_EQ(publisher.getLastPublishedSequence().value(), SEQ);
+
+    MockSubscriptionManager* rawSubscriptionManagerPtr =
+        dynamic_cast<MockSubscriptionManager*>(mockSubscriptionManagerPtr.get());
+
+    EXPECT_CALL(*rawSubscriptionManagerPtr, pubLedger(_, _, fmt::format("{}-{}", SEQ, SEQ), 1)).Times(1);
+    EXPECT_CALL(*rawSubscriptionManagerPtr, pubBookChanges).Times(1);
+    EXPECT_CALL(*rawSubscriptionManagerPtr, pubTransaction).Times(1);
+
+    ctx.run();
+    EXPECT_EQ(backend->fetchLedgerRange().value().maxSequence, SEQ);
+}
+
 TEST_F(ETLLedgerPublisherTest, PublishLedgerInfoCloseTimeGreaterThanNow)
 {
     SystemState dummyState;
@@ -249,6 +292,32 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerSeqStopIsFalse)
     ctx.run();
 }
 
+TEST_F(ETLLedgerPublisherTest, PublishLedgerSeqPicksUpLowerMinSequence)
+{
+    SystemState dummyState;
+    dummyState.isStopping = false;
+    detail::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
+    backend->setRange(SEQ - 1, SEQ - 1);
+
+    LedgerRange const range{.minSequence = SEQ - 5, .maxSequence = SEQ};
+    ON_CALL(*backend, hardFetchLedgerRange(_)).WillByDefault(Return(range));
+    EXPECT_CALL(*backend, hardFetchLedgerRange).Times(1);
+
+    auto const dummyLedgerInfo = CreateLedgerInfo(LEDGERHASH, SEQ, AGE);
+    ON_CALL(*backend, fetchLedgerBySequence(SEQ, _)).WillByDefault(Return(dummyLedgerInfo));
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+
+    ON_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillByDefault(Return(std::vector<LedgerObject>{}));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).Times(1);
+    EXPECT_CALL(mockCache, updateImp).Times(1);
+
+    EXPECT_TRUE(publisher.publish(SEQ, {}));
+    ctx.run();
+
+    EXPECT_EQ(backend->fetchLedgerRange()->minSequence, SEQ - 5);
+    EXPECT_EQ(backend->fetchLedgerRange()->maxSequence, SEQ);
+}
+
 TEST_F(ETLLedgerPublisherTest, PublishMultipleTxInOrder)
 {
     SystemState dummyState;
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SourceScheduler.h"
+#include "util/MockPrometheus.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace etl::detail;
+
+namespace {
+
+constexpr auto EJECTION_TIME = std::chrono::milliseconds{10};
+constexpr auto FETCH = SourceScheduler::RequestClass::Fetch;
+constexpr auto FORWARD = SourceScheduler::RequestClass::Forward;
+
+}  // namespace
+
+struct SourceSchedulerTest : util::prometheus::WithPrometheus {
+    SourceScheduler scheduler{EJECTION_TIME};
+
+    void
+    addSources(std::size_t count)
+    {
+        for (std::size_t idx = 0; idx < count; ++idx)
+            scheduler.add("127.0.0.1:" + std::to_string(6000 + idx));
+    }
+
+    void
+    request(
+        std::size_t source,
+        bool success,
+        std::chrono::milliseconds latency,
+        SourceScheduler::RequestClass requestClass = FORWARD
+    )
+    {
+        scheduler.onStart(source);
+        scheduler.onFinish(source, success, requestClass, latency);
+    }
+
+    std::size_t
+    pickFrom(std::vector<std::size_t> candidates, SourceScheduler::RequestClass requestClass = FORWARD)
+    {
+        return scheduler.pick(candidates, requestClass);
+    }
+};
+
+TEST_F(SourceSchedulerTest, PicksFasterSource)
+{
+    addSources(2);
+    request(0, true, std::chrono::milliseconds{100});
+    request(1, true, std::chrono::milliseconds{10});
+
+    EXPECT_LT(scheduler.score(1, FORWARD), scheduler.score(0, FORWARD));
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(pickFrom({0, 1}), 1);
+}
+
+TEST_F(SourceSchedulerTest, PicksLessLoadedSource)
+{
+    addSources(2);
+    request(0, true, std::chrono::milliseconds{10});
+    request(1, true, std::chrono::milliseconds{10});
+    scheduler.onStart(0);
+    scheduler.onStart(0);
+
+    EXPECT_EQ(pickFrom({0, 1}), 1);
+
+    scheduler.onFinish(0, true, FORWARD, std::chrono::milliseconds{10});
+    scheduler.onFinish(0, true, FORWARD, std::chrono::milliseconds{10});
+    EXPECT_DOUBLE_EQ(scheduler.score(0, FORWARD), scheduler.score(1, FORWARD));
+}
+
+TEST_F(SourceSchedulerTest, PicksSourceWithFewerErrors)
+{
+    addSources(2);
+    request(0, false, std::chrono::milliseconds{10});
+    request(1, true, std::chrono::milliseconds{10});
+
+    EXPECT_EQ(pickFrom({0, 1}), 1);
+}
+
+TEST_F(SourceSchedulerTest, PicksFreshSource)
+{
+    addSources(2);
+    scheduler.setFresh(1, false);
+
+    EXPECT_EQ(pickFrom({0, 1}), 0);
+}
+
+TEST_F(SourceSchedulerTest, PickRemovesPickedCandidate)
+{
+    addSources(3);
+    std::vector<std::size_t> candidates{0, 1, 2};
+
+    auto const first = scheduler.pick(candidates, FORWARD);
+    auto const second = scheduler.pick(candidates, FORWARD);
+    auto const third = scheduler.pick(candidates, FORWARD);
+
+    EXPECT_TRUE(candidates.empty());
+    EXPECT_NE(first, second);
+    EXPECT_NE(first, third);
+    EXPECT_NE(second, third);
+}
+
+TEST_F(SourceSchedulerTest, EjectsFailingSourceForAWhile)
+{
+    addSources(2);
+    for (auto i = 0; i < 5; ++i)
+        request(0, false, std::chrono::milliseconds{1});
+
+    EXPECT_TRUE(scheduler.isEjected(0));
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(pickFrom({0, 1}), 1);
+
+    // an ejected source is still used when nothing else is left
+    EXPECT_EQ(pickFrom({0}), 0);
+
+    std::this_thread::sleep_for(EJECTION_TIME * 2);
+    EXPECT_FALSE(scheduler.isEjected(0));
+}
+
+TEST_F(SourceSchedulerTest, EjectsLatencyOutlier)
+{
+    addSources(3);
+    request(0, true, std::chrono::milliseconds{10});
+    request(1, true, std::chrono::milliseconds{12});
+    request(2, true, std::chrono::milliseconds{500});
+
+    EXPECT_FALSE(scheduler.isEjected(0));
+    EXPECT_FALSE(scheduler.isEjected(1));
+    EXPECT_TRUE(scheduler.isEjected(2));
+}
+
+TEST_F(SourceSchedulerTest, LatenciesAreComparedPerRequestClass)
+{
+    addSources(3);
+    request(0, true, std::chrono::milliseconds{10});
+    request(1, true, std::chrono::milliseconds{12});
+    request(2, true, std::chrono::milliseconds{500}, FETCH);
+
+    // fetching ledgers takes longer than forwarded requests but is only compared with other fetches
+    EXPECT_FALSE(scheduler.isEjected(2));
+    EXPECT_LT(scheduler.score(2, FORWARD), scheduler.score(2, FETCH));
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_EQ(pickFrom({1, 2}, FETCH), 1);
+}
+
+TEST_F(SourceSchedulerTest, NoLatencyOutliersAmongTwoSources)
+{
+    addSources(2);
+    request(0, true, std::chrono::milliseconds{10});
+    request(1, true, std::chrono::milliseconds{500});
+
+    EXPECT_FALSE(scheduler.isEjected(1));
+}
+
+TEST_F(SourceSchedulerTest, ToJson)
+{
+    addSources(1);
+    request(0, true, std::chrono::milliseconds{10});
+    scheduler.setFresh(0, false);
+
+    auto const json = scheduler.toJson(0);
+    EXPECT_DOUBLE_EQ(json.at("latency_ms").at("forward").as_double(), 10.);
+    EXPECT_DOUBLE_EQ(json.at("latency_ms").at("fetch").as_double(), 0.);
+    EXPECT_DOUBLE_EQ(json.at("error_rate").as_double(), 0.);
+    EXPECT_DOUBLE_EQ(json.at("score").at("forward").as_double(), scheduler.score(0, FORWARD));
+    EXPECT_DOUBLE_EQ(json.at("score").at("fetch").as_double(), scheduler.score(0, FETCH));
+    EXPECT_EQ(json.at("in_flight").as_uint64(), 0);
+    EXPECT_FALSE(json.at("fresh").as_bool());
+    EXPECT_FALSE(json.at("ejected").as_bool());
+}
@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/TransactionDecoder.h"
+#include "util/Fixtures.h"
+#include "util/TestObject.h"
+
+#include <gtest/gtest.h>
+#include <ripple/basics/Blob.h>
+#include <ripple/protocol/STTx.h>
+#include <ripple/protocol/Serializer.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace etl::detail;
+
+namespace {
+
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto SEQ = 30;
+
+struct SerializedTransaction {
+    std::string transaction;
+    std::string metadata;
+    std::uint32_t index;
+};
+
+std::string
+toString(ripple::Blob const& blob)
+{
+    return {blob.begin(), blob.end()};
+}
+
+std::vector<SerializedTransaction>
+makeTransactions(std::uint32_t count)
+{
+    std::vector<SerializedTransaction> result;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        result.push_back(
+            {.transaction = toString(
+                 CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, i + 1).getSerializer().peekData()
+             ),
+             .metadata = toString(CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30, i)
+                                      .getSerializer()
+                                      .peekData()),
+             .index = i}
+        );
+    }
+    return result;
+}
+
+std::vector<TransactionDecoder::RawTransaction>
+toRaw(std::vector<SerializedTransaction> const& transactions)
+{
+    std::vector<TransactionDecoder::RawTransaction> result;
+    for (auto const& txn : transactions)
+        result.push_back({.transaction = txn.transaction, .metadata = txn.metadata});
+    return result;
+}
+
+}  // namespace
+
+struct TransactionDecoderTest : NoLoggerFixture, testing::WithParamInterface<std::size_t> {};
+
+INSTANTIATE_TEST_CASE_P(TransactionDecoderThreads, TransactionDecoderTest, testing::Values(1, 4));
+
+TEST_P(TransactionDecoderTest, DecodedTransactionsAreOrderedByIndex)
+{
+    auto transactions = makeTransactions(200);
+    std::shuffle(transactions.begin(), transactions.end(), std::mt19937{42});  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+
+    TransactionDecoder decoder{GetParam()};
+    auto const decoded = decoder.decode(SEQ, toRaw(transactions));
+
+    ASSERT_EQ(decoded.size(), transactions.size());
+    for (std::uint32_t i = 0; i < decoded.size(); ++i) {
+        auto const& txn = transactions[decoded[i].position];
+        EXPECT_EQ(txn.index, i);
+        EXPECT_EQ(decoded[i].accountTx.transactionIndex, i);
+        EXPECT_EQ(decoded[i].accountTx.ledgerSequence, SEQ);
+    }
+}
+
+TEST_P(TransactionDecoderTest, ExtractsHashAndAccounts)
+{
+    auto const transactions = makeTransactions(1);
+
+    TransactionDecoder decoder{GetParam()};
+    auto const decoded = decoder.decode(SEQ, toRaw(transactions));
+
+    ASSERT_EQ(decoded.size(), 1);
+    ripple::SerialIter it{transactions[0].transaction.data(), transactions[0].transaction.size()};
+    ripple::STTx const sttx{it};
+    EXPECT_EQ(decoded[0].hash, sttx.getTransactionID());
+    EXPECT_EQ(decoded[0].accountTx.txHash, sttx.getTransactionID());
+    EXPECT_EQ(decoded[0].accountTx.accounts.size(), 2);
+    EXPECT_TRUE(decoded[0].accountTx.accounts.contains(GetAccountIDWithString(ACCOUNT)));
+    EXPECT_TRUE(decoded[0].accountTx.accounts.contains(GetAccountIDWithString(ACCOUNT2)));
+    EXPECT_TRUE(decoded[0].nftTxs.empty());
+    EXPECT_FALSE(decoded[0].nft);
+}
+
+TEST_P(TransactionDecoderTest, NoTransactions)
+{
+    TransactionDecoder decoder{GetParam()};
+    EXPECT_TRUE(decoder.decode(SEQ, {}).empty());
+}
+
+TEST_P(TransactionDecoderTest, MalformedTransactionThrows)
+{
+    auto transactions = makeTransactions(100);
+    transactions[70].transaction = "garbage";
+
+    TransactionDecoder decoder{GetParam()};
+    EXPECT_ANY_THROW(decoder.decode(SEQ, toRaw(transactions)));
+
+    // the decoder is still usable afterwards
+    EXPECT_EQ(decoder.decode(SEQ, toRaw(makeTransactions(100))).size(), 100);
+}
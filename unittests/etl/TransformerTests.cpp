@@ -88,7 +88,8 @@ TEST_F(ETLTransformerTest, StopsOnWriteConflict)
     state_.writeConflict = true;
 
     EXPECT_CALL(dataPipe_, popNext).Times(0);
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(A<etl::detail::LedgerEvent>())).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(A<ripple::LedgerInfo const&>())).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -120,7 +121,7 @@ TEST_F(ETLTransformerTest, StopsOnEmptyFetchResponse)
     EXPECT_CALL(*backend, writeNFTs).Times(AtLeast(1));
     EXPECT_CALL(*backend, writeNFTTransactions).Times(AtLeast(1));
     EXPECT_CALL(*backend, doFinishWrites).Times(AtLeast(1));
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(AtLeast(1));
+    EXPECT_CALL(ledgerPublisher_, publish(A<etl::detail::LedgerEvent>())).Times(AtLeast(1));
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
@@ -153,7 +154,8 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
     EXPECT_CALL(*backend, doFinishWrites).Times(AtLeast(1));
 
     // should not call publish
-    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(A<etl::detail::LedgerEvent>())).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(A<ripple::LedgerInfo const&>())).Times(0);
 
     transformer_ = std::make_unique<TransformerType>(
         dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, 0, state_
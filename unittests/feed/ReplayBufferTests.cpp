@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/impl/ReplayBuffer.h"
+#include "util/MockPrometheus.h"
+#include "util/prometheus/Counter.h"
+#include "util/prometheus/Gauge.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace feed::impl;
+using namespace util::prometheus;
+
+namespace {
+
+std::vector<std::string>
+replayAll(ReplayBuffer<std::string> const& buffer, std::uint32_t sinceLedger)
+{
+    std::vector<std::string> replayed;
+    buffer.replay(sinceLedger, [&](std::string const& msg) { replayed.push_back(msg); });
+    return replayed;
+}
+
+}  // namespace
+
+struct FeedReplayBufferTest : WithPrometheus {};
+
+TEST_F(FeedReplayBufferTest, EmptyBufferCoversNothing)
+{
+    ReplayBuffer<std::string> const buffer{"test", 10, 1024};
+    EXPECT_FALSE(buffer.covers(0));
+    EXPECT_FALSE(buffer.covers(100));
+    EXPECT_TRUE(replayAll(buffer, 100).empty());
+}
+
+TEST_F(FeedReplayBufferTest, ReplaysLedgersAfterSinceInOrder)
+{
+    ReplayBuffer<std::string> buffer{"test", 10, 1024};
+    buffer.add(10, "a", 1);
+    buffer.add(10, "b", 1);
+    buffer.add(11, "c", 1);
+    buffer.add(12, "d", 1);
+
+    EXPECT_FALSE(buffer.covers(8));
+    EXPECT_TRUE(buffer.covers(9));
+    EXPECT_TRUE(buffer.covers(12));
+
+    EXPECT_EQ(replayAll(buffer, 9), (std::vector<std::string>{"a", "b", "c", "d"}));
+    EXPECT_EQ(replayAll(buffer, 10), (std::vector<std::string>{"c", "d"}));
+    EXPECT_TRUE(replayAll(buffer, 12).empty());
+    EXPECT_TRUE(replayAll(buffer, 8).empty());
+}
+
+TEST_F(FeedReplayBufferTest, DropsOldestLedgersOverLedgerLimit)
+{
+    ReplayBuffer<std::string> buffer{"test", 2, 1024};
+    buffer.add(10, "a", 1);
+    buffer.add(11, "b", 1);
+    buffer.add(12, "c", 1);
+
+    EXPECT_FALSE(buffer.covers(9));
+    EXPECT_TRUE(buffer.covers(10));
+    EXPECT_EQ(replayAll(buffer, 10), (std::vector<std::string>{"b", "c"}));
+}
+
+TEST_F(FeedReplayBufferTest, DropsOldestLedgersOverSizeLimit)
+{
+    ReplayBuffer<std::string> buffer{"test", 10, 10};
+    buffer.add(10, "a", 6);
+    buffer.add(11, "b", 6);
+
+    EXPECT_FALSE(buffer.covers(9));
+    EXPECT_EQ(replayAll(buffer, 10), (std::vector<std::string>{"b"}));
+
+    // the current ledger is kept even if it is over the limit on its own
+    buffer.add(11, "c", 6);
+    EXPECT_EQ(replayAll(buffer, 10), (std::vector<std::string>{"b", "c"}));
+}
+
+TEST_F(FeedReplayBufferTest, Disabled)
+{
+    ReplayBuffer<std::string> buffer{"test", 0, 1024};
+    buffer.add(10, "a", 1);
+    EXPECT_FALSE(buffer.covers(9));
+    EXPECT_TRUE(replayAll(buffer, 9).empty());
+}
+
+struct FeedReplayBufferMockPrometheusTest : WithMockPrometheus {};
+
+TEST_F(FeedReplayBufferMockPrometheusTest, Metrics)
+{
+    auto& hitCounter = makeMock<CounterInt>("subscriptions_replay_total_number", "{result=\"hit\",stream=\"test\"}");
+    auto& missCounter = makeMock<CounterInt>("subscriptions_replay_total_number", "{result=\"miss\",stream=\"test\"}");
+    auto& bytesGauge = makeMock<GaugeInt>("subscriptions_replay_buffer_bytes", "{stream=\"test\"}");
+
+    ReplayBuffer<std::string> buffer{"test", 1, 1024};
+
+    EXPECT_CALL(bytesGauge, set(5));
+    buffer.add(10, "a", 5);
+    EXPECT_CALL(bytesGauge, set(3));
+    buffer.add(11, "b", 3);
+
+    EXPECT_CALL(hitCounter, add(1));
+    EXPECT_TRUE(buffer.replay(10, [](std::string const&) {}));
+
+    EXPECT_CALL(missCounter, add(1));
+    EXPECT_FALSE(buffer.replay(9, [](std::string const&) {}));
+}
@@ -22,10 +22,12 @@
 #include "util/Fixtures.h"
 #include "util/MockPrometheus.h"
 #include "util/MockWsBase.h"
+#include "util/MsgPack.h"
 #include "util/prometheus/Gauge.h"
 #include "web/interface/ConnectionBase.h"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -35,6 +37,7 @@ constexpr static auto FEED = R"({"test":"test"})";
 
 using namespace feed::impl;
 using namespace util::prometheus;
+using namespace testing;
 
 struct FeedBaseMockPrometheusTest : WithMockPrometheus, SyncAsioContextTest {
 protected:
@@ -115,6 +118,25 @@ TEST_F(SingleFeedBaseTest, TestAutoDisconnect)
     EXPECT_EQ(testFeedPtr->count(), 0);
 }
 
+TEST_F(SingleFeedBaseTest, MsgPackSubscriber)
+{
+    sessionPtr->feedFormat = web::FeedFormat::MsgPack;
+    EXPECT_CALL(*mockSessionPtr, sendBinary(Pointee(Eq(util::toMsgPack(boost::json::parse(FEED)))))).Times(2);
+    testFeedPtr->sub(sessionPtr);
+    testFeedPtr->pub(boost::json::parse(FEED).as_object());
+    testFeedPtr->pub(boost::json::parse(FEED).as_object());
+    ctx.run();
+}
+
+TEST_F(SingleFeedBaseTest, MsgPackSubscriberGetsTextWhenNoJsonAvailable)
+{
+    sessionPtr->feedFormat = web::FeedFormat::MsgPack;
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(FEED))).Times(1);
+    testFeedPtr->sub(sessionPtr);
+    testFeedPtr->pub(FEED);
+    ctx.run();
+}
+
 TEST_F(SingleFeedBaseTest, RepeatSub)
 {
     testFeedPtr->sub(sessionPtr);
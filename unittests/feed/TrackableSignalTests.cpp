@@ -67,6 +67,25 @@ TEST_F(FeedTrackableSignalTests, Connect)
     EXPECT_TRUE(testString.empty());
 }
 
+TEST_F(FeedTrackableSignalTests, ReplaceSlot)
+{
+    feed::impl::TrackableSignal<web::ConnectionBase, std::string> signal;
+    std::string testString;
+    EXPECT_FALSE(signal.replaceTrackableSlot(sessionPtr, [&](std::string const& s) { testString += s; }));
+
+    EXPECT_TRUE(signal.connectTrackableSlot(sessionPtr, [&](std::string const& s) { testString += s; }));
+    EXPECT_TRUE(signal.replaceTrackableSlot(sessionPtr, [&](std::string const& s) { testString += s + s; }));
+    EXPECT_EQ(signal.count(), 1);
+
+    signal.emit("test");
+    EXPECT_EQ(testString, "testtest");
+
+    EXPECT_TRUE(signal.disconnect(sessionPtr.get()));
+    testString.clear();
+    signal.emit("test");
+    EXPECT_TRUE(testString.empty());
+}
+
 TEST_F(FeedTrackableSignalTests, AutoDisconnect)
 {
     feed::impl::TrackableSignal<web::ConnectionBase, std::string> signal;
@@ -113,6 +132,19 @@ TEST_F(FeedTrackableSignalTests, MapConnect)
     EXPECT_EQ(testString, "test1");
 }
 
+TEST_F(FeedTrackableSignalTests, MapReplaceSlot)
+{
+    feed::impl::TrackableSignalMap<std::string, web::ConnectionBase, std::string> signalMap;
+    std::string testString;
+    EXPECT_FALSE(signalMap.replaceTrackableSlot(sessionPtr, "test", [&](std::string const& s) { testString += s; }));
+
+    EXPECT_TRUE(signalMap.connectTrackableSlot(sessionPtr, "test", [&](std::string const& s) { testString += s; }));
+    EXPECT_TRUE(signalMap.replaceTrackableSlot(sessionPtr, "test", [&](std::string const& s) { testString += s + s; }));
+
+    signalMap.emit("test", "test");
+    EXPECT_EQ(testString, "testtest");
+}
+
 TEST_F(FeedTrackableSignalTests, MapAutoDisconnect)
 {
     feed::impl::TrackableSignalMap<std::string, web::ConnectionBase, std::string> signalMap;
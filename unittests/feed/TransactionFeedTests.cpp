@@ -19,6 +19,7 @@
 
 #include "data/Types.h"
 #include "feed/FeedTestUtil.h"
+#include "feed/TransactionFilter.h"
 #include "feed/impl/TransactionFeed.h"
 #include "util/Fixtures.h"
 #include "util/MockPrometheus.h"
@@ -28,6 +29,7 @@
 #include "web/interface/ConnectionBase.h"
 
 #include <boost/asio/io_context.hpp>
+#include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <ripple/basics/base_uint.h>
@@ -39,8 +41,15 @@
 #include <ripple/protocol/STAmount.h>
 #include <ripple/protocol/STObject.h>
 #include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 constexpr static auto ACCOUNT1 = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
 constexpr static auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
@@ -211,6 +220,31 @@ TEST_F(FeedTransactionTest, SubTransactionV2)
     ctx.run();
 }
 
+TEST_F(FeedTransactionTest, SubTransactionMsgPack)
+{
+    sessionPtr->feedFormat = web::FeedFormat::MsgPack;
+    testFeedPtr->sub(sessionPtr, 1);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+
+    auto const txBlob = std::string(trans1.transaction.begin(), trans1.transaction.end());
+    auto const metaBlob = std::string(trans1.metadata.begin(), trans1.metadata.end());
+    EXPECT_CALL(*mockSessionPtr, send(testing::An<std::shared_ptr<std::string>>())).Times(0);
+    EXPECT_CALL(*mockSessionPtr, sendBinary(testing::Truly([&](std::shared_ptr<std::string> const& msg) {
+                    // map of 10 fields carrying the raw blobs
+                    return msg->front() == '\x8a' and msg->find(txBlob) != std::string::npos and
+                        msg->find(metaBlob) != std::string::npos;
+                })))
+        .Times(1);
+    ctx.run();
+}
+
 TEST_F(FeedTransactionTest, SubAccountV1)
 {
     auto const account = GetAccountIDWithString(ACCOUNT1);
@@ -921,6 +955,282 @@ TEST_F(FeedTransactionTest, SubTransactionOfferCreationGlobalFrozen)
     ctx.run();
 }
 
+TEST_F(FeedTransactionTest, PubManyTransactionsInParallelKeepsOrder)
+{
+    static constexpr auto NUM_TXS = 100u;
+    static constexpr auto NUM_THREADS = 4u;
+
+    testFeedPtr->sub(sessionPtr, 1);
+
+    testing::Sequence const s;
+    for (auto i = 0u; i < NUM_TXS; ++i) {
+        EXPECT_CALL(*mockSessionPtr, send(testing::Truly([i](std::shared_ptr<std::string> const& msg) {
+                        auto const json = boost::json::parse(*msg);
+                        return json.at("transaction").at("Sequence").as_int64() == static_cast<std::int64_t>(i);
+                    })))
+            .InSequence(s);
+    }
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    for (auto i = 0u; i < NUM_TXS; ++i) {
+        auto trans = TransactionAndMetadata();
+        ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, i);
+        trans.transaction = obj.getSerializer().peekData();
+        trans.ledgerSequence = 33;
+        trans.metadata =
+            CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, i).getSerializer().peekData();
+        testFeedPtr->pub(trans, ledgerinfo, backend);
+    }
+
+    std::vector<std::thread> workers;
+    for (auto i = 0u; i < NUM_THREADS; ++i)
+        workers.emplace_back([this] { ctx.run(); });
+    for (auto& worker : workers)
+        worker.join();
+}
+
+TEST_F(FeedTransactionTest, ResumeReplaysBufferedTransactions)
+{
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+    ctx.run();
+
+    EXPECT_FALSE(testFeedPtr->canReplay(31));
+    EXPECT_TRUE(testFeedPtr->canReplay(32));
+    EXPECT_TRUE(testFeedPtr->canReplay(33));
+
+    testFeedPtr->sub(sessionPtr, 1, 32);
+    testFeedPtr->replay(sessionPtr);
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(testFeedPtr->transactionSubCount(), 1);
+
+    // already subscribed, nothing is replayed again
+    testFeedPtr->sub(sessionPtr, 1, 32);
+    testFeedPtr->replay(sessionPtr);
+    ctx.restart();
+    ctx.run();
+}
+
+TEST_F(FeedTransactionTest, ResumeSendsTransactionMatchingSeveralSubscriptionsOnce)
+{
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+    ctx.run();
+
+    testFeedPtr->sub(sessionPtr, 1, 32);
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT1), sessionPtr, 1, 32);
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT2), sessionPtr, 1, 32);
+    testFeedPtr->replay(sessionPtr);
+
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    ctx.restart();
+    ctx.run();
+}
+
+TEST_F(FeedTransactionTest, ResumeSendsTransactionPublishedBeforeReplayOnceInOrder)
+{
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto const makeTransaction = [](std::uint32_t sequence) {
+        auto trans = TransactionAndMetadata();
+        ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, sequence);
+        trans.transaction = obj.getSerializer().peekData();
+        trans.ledgerSequence = 33;
+        trans.metadata =
+            CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, sequence).getSerializer().peekData();
+        return trans;
+    };
+    auto const hasSequence = [](std::int64_t sequence) {
+        return testing::Truly([sequence](std::shared_ptr<std::string> const& msg) {
+            return boost::json::parse(*msg).at("transaction").at("Sequence").as_int64() == sequence;
+        });
+    };
+
+    testFeedPtr->pub(makeTransaction(1), ledgerinfo, backend);
+    ctx.run();
+
+    // published between the subscription and the replay of the request
+    testFeedPtr->sub(sessionPtr, 1, 32);
+    ctx.restart();
+    ctx.run();
+    testFeedPtr->pub(makeTransaction(2), ledgerinfo, backend);
+    ctx.restart();
+    ctx.run();
+
+    testing::Sequence const s;
+    EXPECT_CALL(*mockSessionPtr, send(hasSequence(1))).InSequence(s);
+    EXPECT_CALL(*mockSessionPtr, send(hasSequence(2))).InSequence(s);
+    testFeedPtr->replay(sessionPtr);
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(testFeedPtr->transactionSubCount(), 1);
+}
+
+TEST_F(FeedTransactionTest, ResumeReportsLedgersEvictedBeforeReplay)
+{
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+    ctx.run();
+
+    testFeedPtr->sub(sessionPtr, 1, 30);
+    testFeedPtr->replay(sessionPtr);
+
+    EXPECT_CALL(*mockSessionPtr, send(testing::Truly([](std::shared_ptr<std::string> const& msg) {
+                    auto const json = boost::json::parse(*msg).as_object();
+                    return json.at("type").as_string() == "replayGap" and
+                        json.at("since_ledger").to_number<std::uint32_t>() == 30;
+                })))
+        .Times(1);
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(testFeedPtr->transactionSubCount(), 1);
+}
+
+TEST_F(FeedTransactionTest, ResumeAccountReplaysOnlyAffectingTransactions)
+{
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+    ctx.run();
+
+    auto const otherSession = std::make_shared<MockSession>();
+    testFeedPtr->sub(GetAccountIDWithString(ISSUER), otherSession, 1, 32);
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT2), sessionPtr, 2, 32);
+    testFeedPtr->replay(otherSession);
+    testFeedPtr->replay(sessionPtr);
+
+    EXPECT_CALL(*otherSession, send(testing::An<std::shared_ptr<std::string>>())).Times(0);
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V2))).Times(1);
+    ctx.restart();
+    ctx.run();
+}
+
+TEST_F(FeedTransactionTest, ResumeDisabled)
+{
+    testFeedPtr = std::make_shared<TransactionFeed>(ctx, 0);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+    ctx.run();
+
+    EXPECT_FALSE(testFeedPtr->canReplay(32));
+}
+
+TEST_F(FeedTransactionTest, SubTransactionWithFilter)
+{
+    auto const paymentsOnly = std::make_shared<feed::TransactionFilter const>(
+        std::unordered_set<ripple::TxType>{ripple::ttPAYMENT},
+        std::unordered_set<ripple::TERUnderlyingType>{},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+    auto const offersOnly = std::make_shared<feed::TransactionFilter const>(
+        std::unordered_set<ripple::TxType>{ripple::ttOFFER_CREATE},
+        std::unordered_set<ripple::TERUnderlyingType>{},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+
+    auto const otherSession = std::make_shared<MockSession>();
+    testFeedPtr->sub(sessionPtr, 1, std::nullopt, paymentsOnly);
+    testFeedPtr->sub(otherSession, 1, std::nullopt, offersOnly);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    EXPECT_CALL(*otherSession, send(testing::An<std::shared_ptr<std::string>>())).Times(0);
+    ctx.run();
+}
+
+TEST_F(FeedTransactionTest, SubscribingAgainReplacesFilter)
+{
+    auto const offersOnly = std::make_shared<feed::TransactionFilter const>(
+        std::unordered_set<ripple::TxType>{ripple::ttOFFER_CREATE},
+        std::unordered_set<ripple::TERUnderlyingType>{},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+    auto const paymentsOnly = std::make_shared<feed::TransactionFilter const>(
+        std::unordered_set<ripple::TxType>{ripple::ttPAYMENT},
+        std::unordered_set<ripple::TERUnderlyingType>{},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT1), sessionPtr, 1, std::nullopt, offersOnly);
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT1), sessionPtr, 1, std::nullopt, paymentsOnly);
+    EXPECT_EQ(testFeedPtr->accountSubCount(), 1);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    ctx.run();
+}
+
+TEST_F(FeedTransactionTest, FilteredOutStillSentByUnfilteredAccountSub)
+{
+    auto const offersOnly = std::make_shared<feed::TransactionFilter const>(
+        std::unordered_set<ripple::TxType>{ripple::ttOFFER_CREATE},
+        std::unordered_set<ripple::TERUnderlyingType>{},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    );
+    testFeedPtr->sub(sessionPtr, 1, std::nullopt, offersOnly);
+    testFeedPtr->sub(GetAccountIDWithString(ACCOUNT1), sessionPtr, 1);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, 33);
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject const obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    trans1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT1, ACCOUNT2, 110, 30, 22).getSerializer().peekData();
+    testFeedPtr->pub(trans1, ledgerinfo, backend);
+
+    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(TRAN_V1))).Times(1);
+    ctx.run();
+}
+
 struct TransactionFeedMockPrometheusTest : WithMockPrometheus, SyncAsioContextTest {
 protected:
     std::shared_ptr<web::ConnectionBase> sessionPtr;
@@ -0,0 +1,95 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "feed/TransactionFilter.h"
+#include "util/TestObject.h"
+
+#include <gtest/gtest.h>
+#include <ripple/protocol/Issue.h>
+#include <ripple/protocol/STAmount.h>
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
+#include <ripple/protocol/UintTypes.h>
+
+#include <optional>
+#include <utility>
+
+using namespace feed;
+
+namespace {
+
+constexpr auto ISSUER = "rK9DrarGKnVEo2nYp5MfVRXRYf5yRX3mwD";
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+
+TransactionFilter::Fields
+makePayment(std::optional<ripple::STAmount> delivered, ripple::TER result = ripple::tesSUCCESS)
+{
+    return {.type = ripple::ttPAYMENT, .result = result, .deliveredAmount = std::move(delivered)};
+}
+
+}  // namespace
+
+TEST(FeedTransactionFilterTest, EmptyFilterMatchesEverything)
+{
+    TransactionFilter const filter{{}, {}, std::nullopt, std::nullopt, std::nullopt};
+    EXPECT_TRUE(filter.matches(makePayment(std::nullopt)));
+    EXPECT_TRUE(filter.matches({.type = ripple::ttOFFER_CREATE, .result = ripple::tecKILLED, .deliveredAmount = {}}));
+}
+
+TEST(FeedTransactionFilterTest, TypesAndResults)
+{
+    TransactionFilter const filter{
+        {ripple::ttPAYMENT, ripple::ttCHECK_CASH},
+        {ripple::TERtoInt(ripple::tesSUCCESS)},
+        std::nullopt,
+        std::nullopt,
+        std::nullopt
+    };
+    EXPECT_TRUE(filter.matches(makePayment(std::nullopt)));
+    EXPECT_TRUE(filter.matches({.type = ripple::ttCHECK_CASH, .result = ripple::tesSUCCESS, .deliveredAmount = {}}));
+
+    auto const offer = TransactionFilter::Fields{
+        .type = ripple::ttOFFER_CREATE, .result = ripple::tesSUCCESS, .deliveredAmount = std::nullopt
+    };
+    EXPECT_FALSE(filter.matches(offer));
+    EXPECT_FALSE(filter.matches(makePayment(std::nullopt, ripple::tecPATH_DRY)));
+}
+
+TEST(FeedTransactionFilterTest, MinDeliveredXRP)
+{
+    TransactionFilter const filter{{}, {}, ripple::xrpCurrency(), std::nullopt, ripple::STAmount{1000}};
+    EXPECT_TRUE(filter.matches(makePayment(ripple::STAmount{1000})));
+    EXPECT_TRUE(filter.matches(makePayment(ripple::STAmount{5000})));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{999})));
+    EXPECT_FALSE(filter.matches(makePayment(std::nullopt)));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{GetIssue("USD", ISSUER), 5000})));
+}
+
+TEST(FeedTransactionFilterTest, CurrencyAndIssuer)
+{
+    auto const usd = GetIssue("USD", ISSUER);
+    TransactionFilter const filter{
+        {}, {}, usd.currency, usd.account, ripple::STAmount{ripple::Issue{usd.currency, ripple::noAccount()}, 10}
+    };
+    EXPECT_TRUE(filter.matches(makePayment(ripple::STAmount{usd, 10})));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{usd, 9})));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{GetIssue("USD", ACCOUNT), 10})));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{GetIssue("EUR", ISSUER), 10})));
+    EXPECT_FALSE(filter.matches(makePayment(ripple::STAmount{10})));
+}
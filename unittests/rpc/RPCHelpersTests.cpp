@@ -226,6 +226,44 @@ TEST_F(RPCHelpersTest, TraverseOwnedNodesNoInputMarkerReturnOtherPageMarker)
     ctx.run();
 }
 
+TEST_F(RPCHelpersTest, TraverseOwnedNodesFetchesObjectsInChunksAcrossPages)
+{
+    auto account = GetAccountIDWithString(ACCOUNT);
+    constexpr static auto pagesCount = 4;
+    constexpr static auto pageSize = 100;
+
+    std::vector<ripple::uint256> const indexes(pageSize, ripple::uint256{INDEX1});
+    for (auto page = 0; page < pagesCount; ++page) {
+        ripple::STObject ownerDir = CreateOwnerDirLedgerObject(indexes, INDEX1);
+        ownerDir.setFieldU64(ripple::sfIndexNext, page + 1 < pagesCount ? page + 1 : 0);
+        ON_CALL(*backend, doFetchLedgerObject(ripple::keylet::page(ripple::keylet::ownerDir(account), page).key, _, _))
+            .WillByDefault(Return(ownerDir.getSerializer().peekData()));
+    }
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(pagesCount);
+
+    ripple::STObject const channel1 = CreatePaymentChannelLedgerObject(ACCOUNT, ACCOUNT2, 100, 10, 32, TXNID, 28);
+    std::vector<std::size_t> chunkSizes;
+    EXPECT_CALL(*backend, doFetchLedgerObjects)
+        .Times(2)
+        .WillRepeatedly([&](std::vector<ripple::uint256> const& keys, auto, auto) {
+            chunkSizes.push_back(keys.size());
+            return std::vector<Blob>(keys.size(), channel1.getSerializer().peekData());
+        });
+
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        auto count = 0;
+        auto ret = traverseOwnedNodes(*backend, account, 9, 1000, {}, yield, [&](auto) { count++; });
+        auto cursor = std::get_if<AccountCursor>(&ret);
+        ASSERT_TRUE(cursor != nullptr);
+        EXPECT_EQ(count, pagesCount * pageSize);
+        EXPECT_EQ(cursor->toString(), fmt::format("{},{}", ripple::strHex(ripple::uint256{beast::zero}), 0));
+    });
+    ctx.run();
+
+    // the first three pages are fetched while the last page is still being read
+    EXPECT_THAT(chunkSizes, UnorderedElementsAre(3 * pageSize, pageSize));
+}
+
 // Send a valid marker
 TEST_F(RPCHelpersTest, TraverseOwnedNodesWithMarkerReturnSamePageMarker)
 {
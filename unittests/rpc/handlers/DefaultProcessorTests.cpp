@@ -24,7 +24,9 @@
 #include "rpc/handlers/impl/FakesAndMocks.h"
 #include "util/Fixtures.h"
 
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/json/storage_ptr.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -56,6 +58,27 @@ TEST_F(RPCDefaultProcessorTest, ValidInput)
     });
 }
 
+TEST_F(RPCDefaultProcessorTest, ResultIsBuiltInRequestStorage)
+{
+    runSpawn([](auto yield) {
+        HandlerMock const handler;
+        rpc::detail::DefaultProcessor<HandlerMock> const processor;
+
+        boost::json::monotonic_resource arena;
+        boost::json::storage_ptr const storage{&arena};
+
+        auto const input = json::parse(R"({ "something": "works" })");
+        auto const spec = RpcSpec{{"something", Required{}}};
+        auto const data = InOutFake{"works"};
+        EXPECT_CALL(handler, spec(_)).WillOnce(ReturnRef(spec));
+        EXPECT_CALL(handler, process(Eq(data), _)).WillOnce(Return(data));
+
+        auto const ret = processor(handler, input, Context{.yield = yield, .storage = storage});
+        ASSERT_TRUE(ret);
+        EXPECT_EQ(ret->storage().get(), storage.get());
+    });
+}
+
 TEST_F(RPCDefaultProcessorTest, NoInputVaildCall)
 {
     runSpawn([](auto yield) {
@@ -104,6 +104,29 @@ generateTestValuesForParametersTest()
             "typeNotString", R"({"type": 123})", "invalidParams", "Invalid field 'type', not string."
         },
         LedgerDataParamTestCaseBundle{"typeNotValid", R"({"type": "xxx"})", "invalidParams", "Invalid field 'type'."},
+        LedgerDataParamTestCaseBundle{"bulkNotBool", R"({"bulk": 123})", "invalidParams", "Invalid parameters."},
+        LedgerDataParamTestCaseBundle{
+            "bulkOutOfOrder", R"({"bulk": true, "out_of_order": true})", "invalidParams", "bulkWithOutOfOrder"
+        },
+        LedgerDataParamTestCaseBundle{
+            "endMarkerInvalid", R"({"bulk": true, "end_marker": "xxx"})", "invalidParams", "end_markerMalformed"
+        },
+        LedgerDataParamTestCaseBundle{
+            "endMarkerWithoutBulk",
+            R"({"end_marker": "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652"})",
+            "invalidParams",
+            "endMarkerWithoutBulk"
+        },
+        LedgerDataParamTestCaseBundle{
+            "endMarkerNotAfterMarker",
+            R"({
+                "bulk": true,
+                "marker": "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+                "end_marker": "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652"
+            })",
+            "invalidParams",
+            "endMarkerNotAfterMarker"
+        },
     };
 }
 
@@ -726,3 +749,102 @@ TEST_F(RPCLedgerDataHandlerTest, JsonLimitMoreThanMax)
         EXPECT_EQ(output->as_object().at("ledger_index").as_uint64(), RANGEMAX);
     });
 }
+
+TEST_F(RPCLedgerDataHandlerTest, BulkFromCache)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _)).WillByDefault(Return(CreateLedgerInfo(LEDGERHASH, RANGEMAX)));
+
+    auto const line = CreateRippleStateLedgerObject("USD", ACCOUNT2, 10, ACCOUNT, 100, ACCOUNT2, 200, TXNID, 123);
+    auto const account = CreateAccountRootObject(ACCOUNT, 0, 1, 10, 2, TXNID, 3);
+    backend->cache().update(
+        {{ripple::uint256{INDEX1}, line.getSerializer().peekData()},
+         {ripple::uint256{INDEX2}, account.getSerializer().peekData()},
+         {ripple::uint256{LEDGERHASH}, line.getSerializer().peekData()}},
+        RANGEMAX
+    );
+    backend->cache().setFull();
+
+    // all pages come straight from the cache
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(*backend, doFetchLedgerObjects).Times(0);
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerDataHandler{backend}};
+        auto const req = json::parse(
+            R"({
+                "bulk": true,
+                "binary": true,
+                "limit": 2
+            })"
+        );
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output->as_object().contains("ledger"));
+        auto const& state = output->as_object().at("state").as_array();
+        ASSERT_EQ(state.size(), 2);
+        EXPECT_EQ(state.at(0).at("index").as_string(), INDEX1);
+        EXPECT_EQ(state.at(0).at("data").as_string(), ripple::strHex(line.getSerializer().peekData()));
+        EXPECT_EQ(state.at(1).at("index").as_string(), LEDGERHASH);
+        EXPECT_EQ(output->as_object().at("marker").as_string(), LEDGERHASH);
+    });
+}
+
+TEST_F(RPCLedgerDataHandlerTest, BulkFiltersTypeBeforeLimitWithinRange)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _)).WillByDefault(Return(CreateLedgerInfo(LEDGERHASH, RANGEMAX)));
+
+    auto const line = CreateRippleStateLedgerObject("USD", ACCOUNT2, 10, ACCOUNT, 100, ACCOUNT2, 200, TXNID, 123);
+    auto const account = CreateAccountRootObject(ACCOUNT, 0, 1, 10, 2, TXNID, 3);
+    backend->cache().update(
+        {{ripple::uint256{INDEX1}, account.getSerializer().peekData()},
+         {ripple::uint256{LEDGERHASH}, line.getSerializer().peekData()},
+         {ripple::uint256{INDEX2}, line.getSerializer().peekData()}},
+        RANGEMAX
+    );
+    backend->cache().setFull();
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerDataHandler{backend}};
+        auto const req = json::parse(fmt::format(
+            R"({{
+                "bulk": true,
+                "type": "state",
+                "limit": 1,
+                "end_marker": "{}"
+            }})",
+            INDEX2
+        ));
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        auto const& state = output->as_object().at("state").as_array();
+        ASSERT_EQ(state.size(), 1);
+        EXPECT_EQ(state.at(0).at("index").as_string(), LEDGERHASH);
+        EXPECT_EQ(state.at(0).at("LedgerEntryType").as_string(), "RippleState");
+        // nothing else before the end marker
+        EXPECT_FALSE(output->as_object().contains("marker"));
+    });
+}
+
+TEST_F(RPCLedgerDataHandlerTest, BulkRequiresFullCache)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _)).WillByDefault(Return(CreateLedgerInfo(LEDGERHASH, RANGEMAX)));
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerDataHandler{backend}};
+        auto const req = json::parse(R"({"bulk": true})");
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "notSupported");
+        EXPECT_EQ(err.at("error_message").as_string(), "bulkRequiresFullCacheOfLatestLedger");
+    });
+}
@@ -1406,6 +1406,33 @@ TEST_F(RPCLedgerEntryTest, BinaryFalse)
     });
 }
 
+TEST_F(RPCLedgerEntryTest, RawBinaryForMsgPack)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, RANGEMAX);
+    EXPECT_CALL(*backend, fetchLedgerBySequence).Times(1);
+    ON_CALL(*backend, fetchLedgerBySequence(RANGEMAX, _)).WillByDefault(Return(ledgerinfo));
+
+    auto const ledgerEntry = CreatePaymentChannelLedgerObject(ACCOUNT, ACCOUNT2, 100, 200, 300, INDEX1, 400);
+    auto const blob = ledgerEntry.getSerializer().peekData();
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(1);
+    ON_CALL(*backend, doFetchLedgerObject(ripple::uint256{INDEX1}, RANGEMAX, _)).WillByDefault(Return(blob));
+
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{LedgerEntryHandler{backend}};
+        auto const req = json::parse(fmt::format(
+            R"({{
+                "payment_channel": "{}",
+                "binary": true
+            }})",
+            INDEX1
+        ));
+        auto const output = handler.process(req, Context{.yield = yield, .rawBinary = true});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output.value().at("node_binary").as_string(), std::string(blob.begin(), blob.end()));
+    });
+}
+
 TEST_F(RPCLedgerEntryTest, UnexpectedLedgerType)
 {
     backend->setRange(RANGEMIN, RANGEMAX);
@@ -143,6 +143,62 @@ generateTestValuesForParametersTest()
         SubscribeParamTestCaseBundle{
             "AccountsProposedEmptyArray", R"({"accounts_proposed": []})", "actMalformed", "accounts_proposed malformed."
         },
+        SubscribeParamTestCaseBundle{"FormatNotString", R"({"format": 1})", "invalidParams", "Invalid parameters."},
+        SubscribeParamTestCaseBundle{
+            "FormatNotValid", R"({"format": "xml"})", "invalidParams", "Invalid field 'format'."
+        },
+        SubscribeParamTestCaseBundle{
+            "SinceLedgerNotInt", R"({"since_ledger": "1"})", "invalidParams", "Invalid parameters."
+        },
+        SubscribeParamTestCaseBundle{"FilterNotObject", R"({"filter": 1})", "invalidParams", "filterNotObject"},
+        SubscribeParamTestCaseBundle{
+            "FilterTransactionTypesNotArray",
+            R"({"filter": {"transaction_types": "Payment"}})",
+            "invalidParams",
+            "transactionTypesNotArray"
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterTransactionTypeMalformed",
+            R"({"filter": {"transaction_types": ["Paymen"]}})",
+            "invalidParams",
+            "transactionTypeMalformed"
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterEngineResultMalformed",
+            R"({"filter": {"engine_results": ["tesSUCCES"]}})",
+            "invalidParams",
+            "engineResultMalformed"
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterCurrencyMalformed",
+            R"({"filter": {"currency": "XXXX"}})",
+            "malformedCurrency",
+            "Malformed currency."
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterIssuerMalformed",
+            R"({"filter": {"currency": "USD", "issuer": "123"}})",
+            "badIssuer",
+            "Issuer account malformed."
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterIssuerForXRP",
+            R"({"filter": {"currency": "XRP", "issuer": "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun"}})",
+            "badIssuer",
+            "Issuer set for XRP."
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterMinDeliveredAmountWithoutCurrency",
+            R"({"filter": {"min_delivered_amount": "100"}})",
+            "invalidParams",
+            "minDeliveredAmountWithoutCurrency"
+        },
+        SubscribeParamTestCaseBundle{
+            "FilterMinDeliveredAmountMalformed",
+            R"({"filter": {"currency": "XRP", "min_delivered_amount": "abc"}})",
+            "invalidParams",
+            "minDeliveredAmountMalformed"
+        },
         SubscribeParamTestCaseBundle{"StreamsNotArray", R"({"streams": 1})", "invalidParams", "streamsNotArray"},
         SubscribeParamTestCaseBundle{"StreamNotString", R"({"streams": [1]})", "invalidParams", "streamNotString"},
         SubscribeParamTestCaseBundle{"StreamNotValid", R"({"streams": ["1"]})", "malformedStream", "Stream malformed."},
@@ -604,6 +660,62 @@ TEST_F(RPCSubscribeHandlerTest, EmptyResponse)
     });
 }
 
+TEST_F(RPCSubscribeHandlerTest, FormatMsgPack)
+{
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend, subManager_}};
+        auto const output = handler.process(json::parse(R"({"format": "msgpack"})"), Context{yield, session_});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output->as_object().empty());
+        EXPECT_EQ(session_->feedFormat, web::FeedFormat::MsgPack);
+
+        auto const outputJson = handler.process(json::parse(R"({"format": "json"})"), Context{yield, session_});
+        ASSERT_TRUE(outputJson);
+        EXPECT_EQ(session_->feedFormat, web::FeedFormat::Json);
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, SinceLedgerNotBuffered)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["transactions"],
+            "since_ledger": 30
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend, subManager_}};
+        auto const output = handler.process(input, Context{yield, session_});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "lgrNotFound");
+        EXPECT_EQ(err.at("error_message").as_string(), "sinceLedgerNotBuffered");
+        EXPECT_EQ(subManager_->report().at("transactions").as_uint64(), 0);
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, StreamsWithFilter)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["transactions"],
+            "filter": {
+                "transaction_types": ["payment"],
+                "engine_results": ["tesSUCCESS"],
+                "currency": "XRP",
+                "min_delivered_amount": "1000000"
+            }
+        })"
+    );
+    runSpawn([&, this](auto yield) {
+        auto const handler = AnyHandler{SubscribeHandler{backend, subManager_}};
+        auto const output = handler.process(input, Context{yield, session_});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output->as_object().empty());
+        EXPECT_EQ(subManager_->report().at("transactions").as_uint64(), 1);
+    });
+}
+
 TEST_F(RPCSubscribeHandlerTest, StreamsWithoutLedger)
 {
     // these streams don't return response
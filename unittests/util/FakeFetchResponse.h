@@ -131,6 +131,24 @@ public:
     }
 };
 
+class FakeTransaction {
+    std::string transaction_;
+    std::string metadata_;
+
+public:
+    std::string
+    transaction_blob() const
+    {
+        return transaction_;
+    }
+
+    std::string
+    metadata_blob() const
+    {
+        return metadata_;
+    }
+};
+
 class FakeTransactionsList {
     std::size_t size_ = 0;
 
@@ -140,6 +158,12 @@ public:
     {
         return size_;
     }
+
+    std::vector<FakeTransaction>
+    transactions() const
+    {
+        return {};
+    }
 };
 
 class FakeObjectsList {
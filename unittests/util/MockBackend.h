@@ -178,4 +178,8 @@ struct MockBackend : public BackendInterface {
     MOCK_METHOD(void, doWriteLedgerObject, (std::string&&, std::uint32_t const, std::string&&), (override));
 
     MOCK_METHOD(bool, doFinishWrites, (), (override));
+
+    MOCK_METHOD(void, waitForWrites, (), (override));
+
+    MOCK_METHOD(bool, doExtendRangeDown, (std::uint32_t, std::uint32_t), (override));
 };
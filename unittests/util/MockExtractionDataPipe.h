@@ -29,4 +29,6 @@ struct MockExtractionDataPipe {
     MOCK_METHOD(uint32_t, getStride, (), (const));
     MOCK_METHOD(void, finish, (uint32_t), ());
     MOCK_METHOD(void, cleanup, (), ());
+    MOCK_METHOD(bool, acquire, (uint32_t), ());
+    MOCK_METHOD(void, release, (), ());
 };
@@ -26,13 +26,19 @@
 #include <boost/json.hpp>
 #include <gmock/gmock.h>
 
+#include <cstdint>
 #include <optional>
 
 struct MockLoadBalancer {
     using RawLedgerObjectType = FakeLedgerObject;
 
     MOCK_METHOD(void, loadInitialLedger, (std::uint32_t, bool), ());
-    MOCK_METHOD(std::optional<FakeFetchResponse>, fetchLedger, (uint32_t, bool, bool), ());
+    MOCK_METHOD(
+        std::optional<FakeFetchResponse>,
+        fetchLedger,
+        (uint32_t, bool, bool, std::optional<std::uint32_t>),
+        ()
+    );
     MOCK_METHOD(bool, shouldPropagateTxnStream, (etl::Source*), (const));
     MOCK_METHOD(boost::json::value, toJson, (), (const));
     MOCK_METHOD(
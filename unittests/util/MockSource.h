@@ -19,6 +19,7 @@
 #pragma once
 
 #include "etl/Source.h"
+#include "etl/impl/InitialLoadQueue.h"
 
 #include <gmock/gmock.h>
 
@@ -37,7 +38,12 @@ public:
         (uint32_t, bool, bool),
         (override)
     );
-    MOCK_METHOD((std::pair<std::vector<std::string>, bool>), loadInitialLedger, (uint32_t, uint32_t, bool), (override));
+    MOCK_METHOD(
+        (std::pair<std::vector<std::string>, bool>),
+        loadInitialLedger,
+        (uint32_t, etl::detail::InitialLoadQueue&, uint32_t, bool),
+        (override)
+    );
     MOCK_METHOD(
         std::optional<boost::json::object>,
         forwardToRippled,
@@ -31,6 +31,7 @@
 
 struct MockSession : public web::ConnectionBase {
     MOCK_METHOD(void, send, (std::shared_ptr<std::string>), (override));
+    MOCK_METHOD(void, sendBinary, (std::shared_ptr<std::string>), (override));
     MOCK_METHOD(void, send, (std::string&&, boost::beast::http::status), (override));
     util::TagDecoratorFactory tagDecoratorFactory{util::Config{}};
 
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MsgPack.h"
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <string>
+
+using namespace util;
+
+namespace {
+
+std::string
+bytes(std::initializer_list<unsigned char> list)
+{
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(MsgPackWriterTest, Scalars)
+{
+    MsgPackWriter writer;
+    writer.writeNil();
+    writer.writeBool(true);
+    writer.writeBool(false);
+    EXPECT_EQ(writer.data(), bytes({0xc0, 0xc3, 0xc2}));
+}
+
+TEST(MsgPackWriterTest, UnsignedIntegersUseSmallestRepresentation)
+{
+    MsgPackWriter writer;
+    writer.writeUInt(127);
+    writer.writeUInt(128);
+    writer.writeUInt(256);
+    writer.writeUInt(65536);
+    writer.writeUInt(std::numeric_limits<std::uint64_t>::max());
+    EXPECT_EQ(
+        writer.data(),
+        bytes({0x7f, 0xcc, 0x80, 0xcd, 0x01, 0x00, 0xce, 0x00, 0x01, 0x00, 0x00, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff,
+               0xff, 0xff, 0xff})
+    );
+}
+
+TEST(MsgPackWriterTest, SignedIntegersUseSmallestRepresentation)
+{
+    MsgPackWriter writer;
+    writer.writeInt(5);
+    writer.writeInt(-1);
+    writer.writeInt(-32);
+    writer.writeInt(-33);
+    writer.writeInt(-129);
+    writer.writeInt(std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(
+        writer.data(),
+        bytes({0x05, 0xff, 0xe0, 0xd0, 0xdf, 0xd1, 0xff, 0x7f, 0xd3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00})
+    );
+}
+
+TEST(MsgPackWriterTest, Double)
+{
+    MsgPackWriter writer;
+    writer.writeDouble(1.5);
+    EXPECT_EQ(writer.data(), bytes({0xcb, 0x3f, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+}
+
+TEST(MsgPackWriterTest, StringsAndBinary)
+{
+    MsgPackWriter writer;
+    writer.writeString("abc");
+    writer.writeString(std::string(32, 'x'));
+    writer.writeBinary("\x01\x02", 2);
+
+    auto expected = bytes({0xa3, 'a', 'b', 'c', 0xd9, 0x20}) + std::string(32, 'x') + bytes({0xc4, 0x02, 0x01, 0x02});
+    EXPECT_EQ(writer.data(), expected);
+}
+
+TEST(MsgPackWriterTest, ContainerHeaders)
+{
+    MsgPackWriter writer;
+    writer.writeArrayHeader(15);
+    writer.writeArrayHeader(16);
+    writer.writeMapHeader(1);
+    writer.writeMapHeader(70000);
+    EXPECT_EQ(writer.data(), bytes({0x9f, 0xdc, 0x00, 0x10, 0x81, 0xdf, 0x00, 0x01, 0x11, 0x70}));
+}
+
+TEST(MsgPackWriterTest, Release)
+{
+    MsgPackWriter writer;
+    writer.writeNil();
+    EXPECT_EQ(writer.release(), bytes({0xc0}));
+}
+
+TEST(MsgPackTest, Json)
+{
+    auto const json = boost::json::parse(R"({"type":"ledgerClosed","ledger_index":300,"changes":[true,null,-1,0.5]})");
+    auto const expected = bytes({0x83, 0xa4, 't',  'y',  'p',  'e',  0xac, 'l',  'e',  'd',  'g',  'e',  'r',  'C',
+                                 'l',  'o',  's',  'e',  'd',  0xac, 'l',  'e',  'd',  'g',  'e',  'r',  '_',  'i',
+                                 'n',  'd',  'e',  'x',  0xcd, 0x01, 0x2c, 0xa7, 'c',  'h',  'a',  'n',  'g',  'e',
+                                 's',  0x94, 0xc3, 0xc0, 0xff, 0xcb, 0x3f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00});
+    EXPECT_EQ(toMsgPack(json), expected);
+}
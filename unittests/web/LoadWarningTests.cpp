@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/LoadWarning.h"
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace web::detail;
+
+namespace {
+
+constexpr auto RATE_LIMIT_WARNING = R"({"id":2003,"message":"You are about to be rate limited"})";
+
+}  // namespace
+
+struct LoadWarningTest : testing::Test {
+    static std::string
+    withWarning(std::string response)
+    {
+        addLoadWarning(response);
+        return response;
+    }
+};
+
+TEST_F(LoadWarningTest, NoWarnings)
+{
+    EXPECT_EQ(
+        withWarning(R"({"result":{"a":1}})"),
+        std::string{R"({"result":{"a":1},"warning":"load","warnings":[)"} + RATE_LIMIT_WARNING + "]}"
+    );
+}
+
+TEST_F(LoadWarningTest, EmptyObject)
+{
+    EXPECT_EQ(withWarning("{}"), std::string{R"({"warning":"load","warnings":[)"} + RATE_LIMIT_WARNING + "]}");
+}
+
+TEST_F(LoadWarningTest, TrailingWarnings)
+{
+    EXPECT_EQ(
+        withWarning(R"({"result":{"warnings":[]},"warnings":[{"id":2001,"message":"x\"]"}]})"),
+        std::string{R"({"result":{"warnings":[]},"warning":"load","warnings":[{"id":2001,"message":"x\"]"},)"} +
+            RATE_LIMIT_WARNING + "]}"
+    );
+}
+
+TEST_F(LoadWarningTest, TrailingEmptyWarnings)
+{
+    EXPECT_EQ(
+        withWarning(R"({"a":[1,2],"warnings":[]})"),
+        std::string{R"({"a":[1,2],"warning":"load","warnings":[)"} + RATE_LIMIT_WARNING + "]}"
+    );
+}
+
+TEST_F(LoadWarningTest, WarningsNotLastFallsBackToParse)
+{
+    auto const expected = boost::json::parse(
+        std::string{R"({"warnings":[1,)"} + RATE_LIMIT_WARNING + R"(],"b":2,"warning":"load"})"
+    );
+    EXPECT_EQ(boost::json::parse(withWarning(R"({"warnings":[1],"b":2})")), expected);
+}
+
+TEST_F(LoadWarningTest, ExistingWarningIsReplaced)
+{
+    auto const expected =
+        boost::json::parse(std::string{R"({"warning":"load","warnings":[)"} + RATE_LIMIT_WARNING + "]}");
+    EXPECT_EQ(boost::json::parse(withWarning(R"({"warning":"other"})")), expected);
+}
@@ -0,0 +1,140 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MsgPack.h"
+#include "web/impl/MsgPackResponse.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <initializer_list>
+#include <string>
+#include <string_view>
+
+using namespace web::detail;
+
+namespace {
+
+std::string
+bytes(std::initializer_list<unsigned char> list)
+{
+    return {list.begin(), list.end()};
+}
+
+}  // namespace
+
+TEST(MsgPackResponseTest, HexMembersBecomeBinary)
+{
+    auto const response = boost::json::parse(R"({"result":{"node_binary":"0A1bFF"}})").as_object();
+
+    // {"result": {"node_binary": bin8 0x0a 0x1b 0xff}}
+    auto const expected = bytes({0x81, 0xa6, 'r', 'e', 's', 'u', 'l', 't', 0x81, 0xab, 'n', 'o', 'd', 'e', '_', 'b',
+                                 'i', 'n', 'a', 'r', 'y', 0xc4, 0x03, 0x0a, 0x1b, 0xff});
+    EXPECT_EQ(toMsgPackResponse(response, "ledger_entry", true), expected);
+}
+
+TEST(MsgPackResponseTest, BinaryMembersInsideArrays)
+{
+    auto const response =
+        boost::json::parse(R"({"result":{"transactions":[{"tx_blob":"01","meta":"02","ledger_index":3}]}})")
+            .as_object();
+
+    util::MsgPackWriter writer;
+    writer.writeMapHeader(1);
+    writer.writeString("result");
+    writer.writeMapHeader(1);
+    writer.writeString("transactions");
+    writer.writeArrayHeader(1);
+    writer.writeMapHeader(3);
+    writer.writeString("tx_blob");
+    writer.writeBinary("\x01", 1);
+    writer.writeString("meta");
+    writer.writeBinary("\x02", 1);
+    writer.writeString("ledger_index");
+    writer.writeUInt(3);
+
+    EXPECT_EQ(toMsgPackResponse(response, "account_tx", true), writer.data());
+}
+
+TEST(MsgPackResponseTest, OnlyMembersOfTheMethodBecomeBinary)
+{
+    auto const response =
+        boost::json::parse(R"({"result":{"state":[{"data":"01","index":"02"}],"ledger":{"ledger_data":"03"}}})")
+            .as_object();
+
+    util::MsgPackWriter writer;
+    writer.writeMapHeader(1);
+    writer.writeString("result");
+    writer.writeMapHeader(2);
+    writer.writeString("state");
+    writer.writeArrayHeader(1);
+    writer.writeMapHeader(2);
+    writer.writeString("data");
+    writer.writeBinary("\x01", 1);
+    writer.writeString("index");
+    writer.writeString("02");
+    writer.writeString("ledger");
+    writer.writeMapHeader(1);
+    writer.writeString("ledger_data");
+    writer.writeBinary("\x03", 1);
+
+    EXPECT_EQ(toMsgPackResponse(response, "ledger_data", true), writer.data());
+}
+
+TEST(MsgPackResponseTest, SameMemberNameElsewhereStaysString)
+{
+    auto const response =
+        boost::json::parse(R"({"result":{"data":"0A","node_binary":"0B","info":{"tx_blob":"0C"}}})").as_object();
+    EXPECT_EQ(toMsgPackResponse(response, "ledger_data", true), util::toMsgPack(response));
+    EXPECT_EQ(toMsgPackResponse(response, "account_info", true), util::toMsgPack(response));
+}
+
+TEST(MsgPackResponseTest, NonHexAndOtherMembersStayStrings)
+{
+    auto const response =
+        boost::json::parse(R"({"result":{"tx":"not hex","meta":{"TransactionResult":"tesSUCCESS"},"hash":"0A"}})")
+            .as_object();
+    EXPECT_EQ(toMsgPackResponse(response, "tx", true), util::toMsgPack(response));
+}
+
+TEST(MsgPackResponseTest, OddLengthStaysString)
+{
+    auto const response = boost::json::parse(R"({"result":{"tx_blob":"ABC"}})").as_object();
+    EXPECT_EQ(toMsgPackResponse(response, "tx", true), util::toMsgPack(response));
+}
+
+TEST(MsgPackResponseTest, RawMembersAreWrittenAsTheyAre)
+{
+    // the handlers of a MessagePack response put the raw bytes in the binary members, even if they look like hex
+    auto const blob = bytes({0x00, 0xff});
+    auto const response =
+        boost::json::object{{"result", boost::json::object{{"tx_blob", std::string_view{blob}}, {"hash", "0A"}}}};
+
+    util::MsgPackWriter writer;
+    writer.writeMapHeader(1);
+    writer.writeString("result");
+    writer.writeMapHeader(2);
+    writer.writeString("tx_blob");
+    writer.writeBinary("\x00\xff", 2);
+    writer.writeString("hash");
+    writer.writeString("0A");
+
+    EXPECT_EQ(toMsgPackResponse(response, "tx", false), writer.data());
+}
@@ -23,17 +23,22 @@
 #include "util/Taggable.h"
 #include "util/config/Config.h"
 #include "web/RPCServerHandler.h"
+#include "web/ResponseStream.h"
 #include "web/interface/ConnectionBase.h"
 
 #include <boost/beast/http/status.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <ripple/protocol/ErrorCodes.h>
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 using namespace feed;
 using namespace web;
@@ -60,6 +65,31 @@ struct MockWsBase : public web::ConnectionBase {
         lastStatus = status;
     }
 
+    void
+    sendStream(std::shared_ptr<web::ResponseStream> stream) override
+    {
+        for (auto chunk = stream->next(); not chunk.empty(); chunk = stream->next()) {
+            message += chunk;
+            ++streamedChunks;
+        }
+        lastStatus = boost::beast::http::status::ok;
+    }
+
+    void
+    // NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
+    sendMsgPack(boost::json::object&& response, std::string_view method, bool hexBinary) override
+    {
+        msgPackResponse = response;
+        msgPackMethod = method;
+        msgPackHexBinary = hexBinary;
+        lastStatus = boost::beast::http::status::ok;
+    }
+
+    std::size_t streamedChunks = 0;
+    std::optional<boost::json::object> msgPackResponse;
+    std::string msgPackMethod;
+    bool msgPackHexBinary = false;
+
     MockWsBase(util::TagDecoratorFactory const& factory) : web::ConnectionBase(factory, "localhost.fake.ip")
     {
     }
@@ -878,3 +908,159 @@ TEST_F(WebRPCServerHandlerTest, WsRequestNotJson)
     (*handler)(request, session);
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
+
+TEST_F(WebRPCServerHandlerTest, HTTPStreamedMethod)
+{
+    auto const localCfg = util::Config{boost::json::parse(R"({
+        "response_streaming": {
+            "methods": ["ledger_data"],
+            "chunk_size_kb": 1
+        }
+    })")};
+    auto const localHandler =
+        std::make_shared<RPCServerHandler<MockAsyncRPCEngine, MockETLService>>(localCfg, backend, rpcEngine, etl);
+
+    static auto constexpr request = R"({
+                                        "method": "ledger_data",
+                                        "params": [{}]
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+
+    auto const blob = std::string(4096, 'A');
+    auto const result = boost::json::object{{"state", blob}};
+    auto response = boost::json::parse(R"({
+                                        "result": {
+                                            "status": "success"
+                                        },
+                                        "warnings": [
+                                            {
+                                                "id": 2001,
+                                                "message": "This is a clio server. clio only serves validated data. If you want to talk to rippled, include 'ledger_index':'current' in your request"
+                                            }
+                                        ]
+                                    })");
+    response.as_object()["result"].as_object()["state"] = blob;
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(result));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger_data", testing::_)).Times(1);
+
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*localHandler)(request, session);
+    EXPECT_EQ(boost::json::parse(session->message), response);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+    EXPECT_GT(session->streamedChunks, 4);
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPMsgPackAccepted)
+{
+    static auto constexpr request = R"({
+                                        "method": "ledger_entry",
+                                        "params": [{}]
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+    session->acceptsMsgPack = true;
+
+    auto const result = boost::json::object{{"node_binary", "\x0A\x1B"}};
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::Field(&web::Context::rawBinary, true)))
+        .WillOnce(testing::Return(result));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger_entry", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    ASSERT_TRUE(session->msgPackResponse.has_value());
+    EXPECT_TRUE(session->message.empty());
+    EXPECT_EQ(session->msgPackResponse->at("result").at("node_binary"), "\x0A\x1B");
+    EXPECT_EQ(session->msgPackResponse->at("result").at("status"), "success");
+    EXPECT_EQ(session->msgPackMethod, "ledger_entry");
+    EXPECT_FALSE(session->msgPackHexBinary);
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPMsgPackForwardedIsHex)
+{
+    static auto constexpr request = R"({
+                                        "method": "ledger_entry",
+                                        "params": [{}]
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+    session->acceptsMsgPack = true;
+
+    auto const result = boost::json::object{{"result", {{"node_binary", "0A1B"}}}, {"forwarded", true}};
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(result));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger_entry", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    ASSERT_TRUE(session->msgPackResponse.has_value());
+    EXPECT_EQ(session->msgPackResponse->at("result").at("node_binary"), "0A1B");
+    EXPECT_TRUE(session->msgPackHexBinary);
+}
+
+TEST_F(WebRPCServerHandlerTest, HTTPMsgPackError)
+{
+    static auto constexpr request = R"({
+                                        "method": "ledger_entry",
+                                        "params": [{}]
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+    session->acceptsMsgPack = true;
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(rpc::Status{rpc::RippledError::rpcINVALID_PARAMS, "ledgerIndexMalformed"}));
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    ASSERT_TRUE(session->msgPackResponse.has_value());
+    EXPECT_TRUE(session->message.empty());
+    EXPECT_EQ(session->msgPackResponse->at("result").at("error"), "invalidParams");
+}
+
+TEST_F(WebRPCServerHandlerTest, WsMsgPackRequested)
+{
+    static auto constexpr request = R"({
+                                        "command": "ledger_entry",
+                                        "id": 99,
+                                        "response_format": "msgpack"
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+    session->upgraded = true;
+
+    auto const result = boost::json::object{{"node_binary", "0A1B"}};
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(result));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger_entry", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    ASSERT_TRUE(session->msgPackResponse.has_value());
+    EXPECT_EQ(session->msgPackResponse->at("id"), 99);
+    EXPECT_EQ(session->msgPackResponse->at("type"), "response");
+}
+
+TEST_F(WebRPCServerHandlerTest, WsJsonByDefault)
+{
+    static auto constexpr request = R"({
+                                        "command": "ledger_entry",
+                                        "id": 99
+                                    })";
+
+    backend->setRange(MINSEQ, MAXSEQ);
+    session->upgraded = true;
+
+    auto const result = boost::json::object{{"node_binary", "0A1B"}};
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce(testing::Return(result));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger_entry", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(request, session);
+    EXPECT_FALSE(session->msgPackResponse.has_value());
+    EXPECT_EQ(boost::json::parse(session->message).at("result").at("node_binary"), "0A1B");
+}
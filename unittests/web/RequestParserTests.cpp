@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/RequestParser.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/system/system_error.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+
+using namespace web::detail;
+
+TEST(RequestParserTest, ParsesLikeBoostJson)
+{
+    auto const request = std::string{R"({"method":"ledger","params":[{"ledger_index":"validated","binary":true}]})"};
+    EXPECT_EQ(parseRequest(request), boost::json::parse(request));
+}
+
+TEST(RequestParserTest, RequestOwnsItsArena)
+{
+    auto const first = parseRequest(R"({"a":[1,2,3]})");
+    auto const second = parseRequest(R"({"b":"c"})");
+
+    EXPECT_TRUE(first.storage().is_shared());
+    EXPECT_NE(first.storage().get(), second.storage().get());
+    EXPECT_EQ(first.at("a").as_array().storage().get(), first.storage().get());
+}
+
+TEST(RequestParserTest, ValuesCopiedFromOtherStorageStayValid)
+{
+    auto response = boost::json::object{};
+    {
+        auto request = parseRequest(R"({"id":1,"command":"server_info"})");
+        response = request.as_object();
+    }
+    EXPECT_EQ(response.at("command"), "server_info");
+
+    auto request = parseRequest(R"({"id":1})");
+    auto sameArena = boost::json::object{request.storage()};
+    sameArena["result"] = boost::json::object{{"status", "success"}};
+    EXPECT_EQ(sameArena.storage().get(), request.storage().get());
+    EXPECT_EQ(sameArena.at("result").at("status"), "success");
+}
+
+TEST(RequestParserTest, InvalidJsonThrows)
+{
+    EXPECT_THROW(parseRequest("not json"), boost::system::system_error);
+    EXPECT_THROW(parseRequest(R"({"a":1} trailing)"), boost::system::system_error);
+    EXPECT_THROW(parseRequest(R"({"a":)"), boost::system::system_error);
+
+    // the parser is usable after a failure
+    EXPECT_EQ(parseRequest(R"({"a":1})"), boost::json::parse(R"({"a":1})"));
+}
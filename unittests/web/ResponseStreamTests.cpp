@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/ResponseStream.h"
+
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+
+using namespace web;
+
+TEST(ResponseStreamTests, SmallResponseInOneChunk)
+{
+    auto const response = boost::json::object{{"result", {{"status", "success"}}}};
+    ResponseStream stream{response};
+    EXPECT_FALSE(stream.done());
+
+    EXPECT_EQ(stream.next(), boost::json::serialize(response));
+    EXPECT_TRUE(stream.done());
+    EXPECT_TRUE(stream.next().empty());
+}
+
+TEST(ResponseStreamTests, LargeResponseInBoundedChunks)
+{
+    static constexpr std::size_t CHUNK_SIZE = 16;
+    auto const response = boost::json::object{{"state", std::string(100, 'A')}, {"marker", "B"}};
+    ResponseStream stream{response, CHUNK_SIZE};
+
+    std::string result;
+    std::size_t chunks = 0;
+    for (auto chunk = stream.next(); not chunk.empty(); chunk = stream.next()) {
+        EXPECT_LE(chunk.size(), CHUNK_SIZE);
+        result.append(chunk);
+        ++chunks;
+    }
+
+    EXPECT_TRUE(stream.done());
+    EXPECT_EQ(result, boost::json::serialize(response));
+    EXPECT_EQ(chunks, (result.size() + CHUNK_SIZE - 1) / CHUNK_SIZE);
+}
+
+TEST(ResponseStreamTests, ResponseCanBeChangedBeforeStart)
+{
+    ResponseStream stream{boost::json::object{{"result", "ok"}}, 4};
+    stream.response()["warning"] = "load";
+
+    auto const expected = boost::json::serialize(boost::json::object{{"result", "ok"}, {"warning", "load"}});
+    EXPECT_EQ(stream.drain(), expected);
+    EXPECT_TRUE(stream.done());
+}
+
+TEST(ResponseStreamTests, DrainReturnsRemainder)
+{
+    auto const response = boost::json::object{{"state", std::string(64, 'A')}};
+    auto const serialized = boost::json::serialize(response);
+    ResponseStream stream{response, 8};
+
+    auto const first = std::string{stream.next()};
+    EXPECT_EQ(first + stream.drain(), serialized);
+}